@@ -29,6 +29,8 @@
 #include <core/systems/gkc_movement_system.h>
 #include <core/systems/gkc_script_system.h>
 #include <core/systems/gkc_ecs_event_system.h>
+#include <core/systems/gkc_animation_system.h>
+#include <core/systems/gkc_audio_system.h>
 
 #include <core/gkc_app.h>
 #include <core/gkc_debugger.h>
@@ -44,12 +46,27 @@
 #include <ecs/gkc_template_traits.h>
 
 #include <filesys/gkc_reader.h>
+#include <filesys/gkc_byte_buffer.h>
 #include <filesys/gkc_writer.h>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_archive.h>
+#include <filesys/gkc_compression.h>
+#include <filesys/gkc_file_watcher.h>
+#include <filesys/gkc_scene_format.h>
+#include <filesys/gkc_scene_journal.h>
+#include <filesys/gkc_scene_saver.h>
 
 #include <render/gkc_window.h>
 #include <render/gkc_drawer.h>
 #include <render/gkc_texture.h>
+#include <render/gkc_atlas.h>
+#include <render/gkc_decode_cache.h>
+#include <render/gkc_tilemap.h>
+#include <core/managers/gkc_asset_loader.h>
+#include <core/managers/gkc_asset_budget.h>
+#include <core/managers/gkc_asset_table.h>
+#include <core/managers/gkc_hot_reload.h>
+#include <core/managers/gkc_world_streamer.h>
 #include <render/gkc_animation.h>
 
 #include <script/gkc_script.h>
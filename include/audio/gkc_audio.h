@@ -23,8 +23,49 @@
 
 #pragma once
 #include <pch.hpp>
+#include <core/managers/gkc_asset_table.h>
 
 namespace Galaktic::Audio {
+    inline constexpr size_t GKC_AUDIO_PREDECODE_MAX = 256 * 1024;         // Encoded bytes, ~15s of ogg/mp3
+    inline constexpr size_t GKC_AUDIO_PCM_BUDGET = 64 * 1024 * 1024;      // Default budget of loaded audio
+    inline constexpr Uint32 GKC_AUDIO_VOICES = 32;                        // Tracks created up front
+    inline constexpr int GKC_AUDIO_PRIORITY_MUSIC = 100;
+
+    /**
+     * @brief Handle to a playing voice, it becomes invalid once the voice is recycled
+     */
+    typedef Uint32 VoiceID;
+    inline constexpr VoiceID GKC_INVALID_VOICE = 0;
+
+    /**
+     * @struct VoiceParameters
+     * @brief Gain and panning of a voice, sent to the mixer in batches
+     */
+    struct VoiceParameters {
+        VoiceID voice_;
+        float gain_;            // 0 = silent, 1 = unchanged
+        float pan_;             // -1 = left, 0 = center, 1 = right
+    };
+
+    /**
+     * @enum Audio_Output
+     * @brief Where the mixer sends its output
+     */
+    enum class Audio_Output {
+        Device,         // Default playback device, mixed in real time by SDL
+        Offline         // No device, rendered to memory as fast as possible
+    };
+
+    /**
+     * @enum Audio_Mode
+     * @brief How the samples of an audio file are kept in memory
+     */
+    enum class Audio_Mode {
+        Auto,           // Chosen by \c ChooseAudioMode()
+        Predecoded,     // Decoded to PCM once, tracks start instantly (sound effects)
+        Streamed        // Encoded data is kept, tracks decode it while playing (music)
+    };
+
     /**
      * @class AudioFile
      * @brief Stores a \c MIX_Audio and initializes it by providing a path to the sound file
@@ -34,10 +75,24 @@ namespace Galaktic::Audio {
             /**
              * @param filepath sound filepath
              * @param mixer MIX_Mixer
+             * @param mode Predecoded or streamed, \c Audio_Mode::Auto picks it by size and type
              */
-            explicit AudioFile(const path &filepath, MIX_Mixer* mixer);
+            explicit AudioFile(const path &filepath, MIX_Mixer* mixer, Audio_Mode mode = Audio_Mode::Auto);
+            ~AudioFile();
+
+            AudioFile(const AudioFile&) = delete;
+            AudioFile& operator=(const AudioFile&) = delete;
+
             MIX_Audio* GetAudioSample() { return m_audio; }
 
+            /**
+             * @brief Estimates the RAM used by the audio
+             * @return Bytes used, decoded PCM for predecoded files, encoded data for streamed ones
+             */
+            [[nodiscard]] size_t GetMemorySize() const;
+
+            [[nodiscard]] bool IsStreamed() const { return m_streamed; }
+
             /**
              * @brief Checks if the audio initialized is valid for usage
              * @return true if it's valid, false if it is nullptr
@@ -45,6 +100,8 @@ namespace Galaktic::Audio {
             bool IsValid() const;
         private:
             MIX_Audio* m_audio = nullptr;
+            size_t m_encodedSize = 0;
+            bool m_streamed = false;
     };
 
     /**
@@ -58,13 +115,36 @@ namespace Galaktic::Audio {
     struct AudioInfo {
         AudioID id_;
         shared_ptr<AudioFile> audioFile_;
+        path path_;                     // Used to reload the audio once evicted
+        Uint64 lastUsedFrame_ = 0;
+        size_t bytes_ = 0;
+        Audio_Mode mode_ = Audio_Mode::Auto;    // Kept so a reload decodes it the same way
     };
 
     /**
-     * @brief Type for saving the filename (includes extension, e.g: file.mp3)  and
-     *        a shared_ptr to an \c AudioInfo struct
+     * @brief Table of \c AudioInfo indexed by AudioID, the filename (includes extension,
+     *        e.g: file.mp3) is kept as a secondary key
+     */
+    typedef Core::Managers::AssetTable<shared_ptr<AudioInfo>> Audio_List;
+
+    /**
+     * @brief Picks how an audio file is loaded, uncompressed files (wav, aiff) and short
+     *        compressed files are predecoded, long compressed files (usually music) are streamed
+     *        since their PCM would take tens of MB
+     * @param path filepath, the extension gives the type
+     * @param encodedSize size of the file
+     * @return \c Audio_Mode::Predecoded or \c Audio_Mode::Streamed
+     */
+    extern Audio_Mode ChooseAudioMode(const path& path, size_t encodedSize);
+
+    /**
+     * @brief Writes PCM samples into a WAV file
+     * @param file WAV filepath
+     * @param spec Format of the samples
+     * @param pcm Interleaved samples
+     * @return true if the file was written
      */
-    typedef unordered_map<string, shared_ptr<AudioInfo>> Audio_List;
+    extern bool WriteWAV(const path& file, const SDL_AudioSpec& spec, const vector<Uint8>& pcm);
 
     /**
      * @brief Checks if the file is an audio file
@@ -0,0 +1,71 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Core {
+    inline constexpr Uint64 GKC_FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    inline constexpr Uint64 GKC_FNV_PRIME = 0x100000001b3ull;
+
+    /**
+     * @brief Hashes a block of bytes with FNV-1a (64 bits)
+     * @param data Bytes to hash
+     * @param size Number of bytes
+     * @param seed Previous hash to continue from, used to hash data in several blocks
+     * @return Hash of the bytes
+     */
+    inline Uint64 HashFNV1a(const void* data, size_t size, Uint64 seed = GKC_FNV_OFFSET_BASIS) {
+        const auto* bytes = static_cast<const Uint8*>(data);
+        Uint64 hash = seed;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= GKC_FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Computes the CRC32C (Castagnoli) of a block of bytes, with the crc32 instruction
+     *        of SSE 4.2 or ARMv8 when the CPU has it and a table otherwise (little endian)
+     * @param data Bytes to check
+     * @param size Number of bytes
+     * @param previous CRC of the previous bytes, used to check data in several blocks
+     * @return CRC32C of the bytes
+     */
+    Uint32 HashCRC32C(const void* data, size_t size, Uint32 previous = 0);
+
+    /**
+     * @brief Hashes a string with FNV-1a (64 bits), usable at compile time
+     * @param str String to hash
+     * @return Hash of the string
+     */
+    constexpr Uint64 HashFNV1a(std::string_view str) {
+        Uint64 hash = GKC_FNV_OFFSET_BASIS;
+        for (char c : str) {
+            hash ^= static_cast<Uint8>(c);
+            hash *= GKC_FNV_PRIME;
+        }
+        return hash;
+    }
+}
@@ -121,16 +121,20 @@ inline constexpr double FIXED_DELTA_TIME = 1.0 / 60;
     inline const path GKC_TEXTURE_PATH = "assets\\textures";
     inline const path GKC_SOUND_PATH = "assets\\sounds";
     inline const path GKC_ANIMATION_PATH = "assets\\animations";
+    inline const path GKC_TILEMAP_PATH = "assets\\tilemaps";
     inline const path GKC_SCENE_PATH = "scenes";
     inline const path GKC_SCRIPT_PATH = "scripts";
     inline const path GKC_CONFIG_PATH = "config";
+    inline const path GKC_CACHE_PATH = "cache";
 #else
     inline const path GKC_TEXTURE_PATH = "assets/textures";
     inline const path GKC_SOUND_PATH = "assets/sounds";
-    inline const path GKC_ANIMATION_PATH = "assets/animations"
-    inline const path GKC_SCENE_PATH = "assets/scenes"
+    inline const path GKC_ANIMATION_PATH = "assets/animations";
+    inline const path GKC_TILEMAP_PATH = "assets/tilemaps";
+    inline const path GKC_SCENE_PATH = "assets/scenes";
     inline const path GKC_SCRIPT_PATH = "scripts";
     inline const path GKC_CONFIG_PATH = "config";
+    inline const path GKC_CACHE_PATH = "cache";
 #endif
 
 inline constexpr SDL_Color WHITE_COLOR = {255, 255, 255, 255};
@@ -337,7 +341,7 @@ namespace Galaktic::Debug {
 
 namespace Galaktic::Filesystem {
     constexpr unsigned int GKC_VERSION_ENTITY = 1;
-    constexpr unsigned int GKC_VERSION_SCENE = 1;
+    constexpr unsigned int GKC_VERSION_SCENE = 5;           // 2: column oriented (gkc_scene_format.h), 3: compressed columns, 4: reflected fields, 5: checksums and entity index
 }
 
 
@@ -349,5 +353,12 @@ namespace Galaktic::Filesystem {
             }                                                   \
     } while (0)        
 
+#define GKC_ENSURE_STREAM_GOOD(stream, ex)                      \
+    do {                                                        \
+        if (!(stream)) {                                        \
+            GKC_THROW_EXCEPTION(ex, "stream is not readable!"); \
+            }                                                   \
+    } while (0)
+
 #define GKC_WRITE_BINARY(var) reinterpret_cast<const char*>(&var)
 #define GKC_READ_BINARY(var) reinterpret_cast<char*>(&var)
\ No newline at end of file
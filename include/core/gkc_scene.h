@@ -25,6 +25,7 @@
 #include <pch.hpp>
 #include <core/systems/gkc_system.h>
 #include "ecs/gkc_registry.h"
+#include "filesys/gkc_scene_format.h"
 
 namespace Galaktic::Core::Helpers {
     class ECS_Helper;
@@ -40,6 +41,10 @@ namespace Galaktic::ECS {
 }
 namespace Galaktic::Render {
     class Window;
+    class Tilemap;
+}
+namespace Galaktic::Filesystem {
+    enum class Compression_Type : Uint32;
 }
 namespace Galaktic::Core::Systems {
     typedef unordered_map<string, shared_ptr<BaseSystem>> System_List;
@@ -51,6 +56,7 @@ namespace Galaktic::Core::Managers {
     class AudioManager;
     class ScriptManager;
     class AnimationManager;
+    class WorldStreamer;
 }
 
 namespace Galaktic::Core {
@@ -62,6 +68,7 @@ namespace Galaktic::Core {
     struct SceneInformation {
         string scene_name_;
         size_t scene_size_ = 0;
+        bool snapshot_saved_ = false;   // The scene file holds a full save, incremental saves can be appended
     };
 
     class ManagersWrapper {
@@ -95,8 +102,42 @@ namespace Galaktic::Core {
              */
             void Run();
 
+            /**
+             * @brief Writes the whole scene, its journal is discarded
+             */
             void Save();
 
+            /**
+             * @brief Only writes the entities and components that changed since the last save
+             *        to the scene's journal, the journal is compacted once it grows too big.
+             *        The whole scene is written if it was never saved.
+             *
+             * The changes are copied right away and written by the \c SceneSaver thread,
+             * the scene keeps running while they are saved
+             */
+            void SaveIncremental();
+
+            /**
+             * @brief Entities written when the scene is saved, the ones streamed from a world
+             *        are left out (they're saved in the overlay of the world, see
+             *        \c WorldStreamer::SaveOverlay() )
+             * @return The entities of the scene, a filtered list only while a world is streamed
+             */
+            [[nodiscard]] const ECS::Entity_List& GetSavedEntities();
+
+            /**
+             * @brief Saves the scene incrementally every few seconds while it runs
+             * @param seconds Time between saves, 0 disables the autosave
+             */
+            void SetAutosaveInterval(double seconds) { m_autosaveInterval = seconds; m_autosaveTimer = 0.0; }
+
+            /**
+             * @brief Sets the codec the scene file is compressed with on the next full save,
+             *        scenes that are read keep the codec they were saved with
+             */
+            void SetSaveCompression(Filesystem::Compression_Type compression) { m_compression = compression; }
+            [[nodiscard]] Filesystem::Compression_Type GetSaveCompression() const { return m_compression; }
+
             /**
              * @brief Executes all events using the engine's systems
              * @param event GKC_Event
@@ -148,12 +189,37 @@ namespace Galaktic::Core {
              */
             void CreateCamera(const string &name);
 
+            /**
+             * @brief Loads a tilemap from the tilemaps folder, it's drawn behind the entities,
+             *        the previous tilemap (if any) is replaced
+             * @param name Filename of the tilemap (e.g. level.gktilemap)
+             * @return true if the tilemap was loaded, false otherwise
+             */
+            bool LoadTilemap(const string& name);
+
+            [[nodiscard]] Render::Tilemap* GetTilemap() const { return m_tilemap.get(); }
+
+            /**
+             * @brief Streams a world (.gkworld) from the scenes folder around the active camera,
+             *        the previous world (if any) is unloaded
+             * @param name Filename of the world (e.g. overworld.gkworld)
+             * @param loadRadius Cells closer than this to the camera are loaded (px), they're
+             *        unloaded past 1.5 times this distance
+             * @return true if the world was opened, false otherwise
+             * @note The changes of the streamed entities are saved in the overlay of the world
+             *       (.gkworld.overlay) when the scene is saved
+             */
+            bool StreamWorld(const string& name, float loadRadius = Filesystem::GKC_WORLD_CELL_SIZE);
+
             ECS::Registry*& GetRegistry() { return m_registry; }
             Managers::ECS_Manager*& GetECSManager() { return m_ecsManager; }
             SceneInformation m_sceneInfo;
         private:
             bool m_isRunning = true;
             shared_ptr<Render::Window> m_window;
+            unique_ptr<Render::Tilemap> m_tilemap;
+            unique_ptr<Managers::WorldStreamer> m_worldStreamer;
+            ECS::Entity_List m_savedEntities;       // Scratch list of GetSavedEntities() while streaming
             Systems::System_List m_systemList;
             ECS::Registry* m_registry = nullptr;
             Managers::WindowManager* m_windowManager = nullptr;
@@ -163,7 +229,12 @@ namespace Galaktic::Core {
             Helpers::AnimationHelper* m_animationHelper = nullptr;
             ManagersWrapper* m_managerWrapper = nullptr;
             path m_appPath;
-            
+            double m_autosaveInterval = 0.0;
+            double m_autosaveTimer = 0.0;
+            Filesystem::Compression_Type m_compression{};     // None
+        private:
+            [[nodiscard]] path GetScenePath() const;
+
     };
 
     typedef unordered_map<string, unique_ptr<Scene>> Scene_List;
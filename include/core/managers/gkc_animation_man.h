@@ -23,12 +23,14 @@
 
 #pragma once
 #include <pch.hpp>
+#include <core/managers/gkc_asset_budget.h>
+#include <core/managers/gkc_asset_table.h>
 
 namespace Galaktic::Render {
     class Animation;
     struct AnimationInfo;
-    typedef unordered_map<string, shared_ptr<Render::AnimationInfo>> Animation_List;
-    typedef unordered_map<AnimationID, string> AnimationID_List;
+    struct BakedAnimation;
+    typedef Core::Managers::AssetTable<shared_ptr<Render::AnimationInfo>> Animation_List;
 }
 
 namespace Galaktic::Core::Managers {
@@ -40,20 +42,79 @@ namespace Galaktic::Core::Managers {
             
             static void LoadAnimation(const string& filePath, SDL_Renderer* renderer);
             static void LoadAllAnimations(SDL_Renderer* renderer);
+
+            /**
+             * @brief Queues all animations in the \c AssetLoader, they are available once
+             *        \c AssetLoader::Pump() uploads them
+             * @param renderer SDL_Renderer
+             */
+            static void LoadAllAnimationsAsync(SDL_Renderer* renderer);
+
+            /**
+             * @brief Uploads an animation baked by the \c AssetLoader
+             * @param filePath Animation's path
+             * @param baked Baked sheets, nullptr if the decoding failed
+             * @param renderer SDL_Renderer
+             */
+            static void FinishAnimation(const path& filePath, Render::BakedAnimation* baked,
+                SDL_Renderer* renderer);
+
+            /**
+             * @brief Loads an animation again after its file changed, the animation keeps its ID.
+             *        If the \c AssetLoader is running it's decoded in the background and swapped
+             *        once uploaded
+             * @param filePath Animation's path
+             * @param renderer SDL_Renderer
+             */
+            static void ReloadAnimation(const path& filePath, SDL_Renderer* renderer);
             
             static void DeleteAnimation(const string& name);
             
             static shared_ptr<Render::Animation> GetAnimation(const string& name);
             static shared_ptr<Render::Animation> GetAnimation(AnimationID id);
             static shared_ptr<Render::AnimationInfo> GetAnimationInfo(const string& name);
-            
-            static void UpdateAll(float deltaTime);
+
+            /**
+             * @brief Same as \c GetAnimation() but nothing is logged if the animation
+             *        doesn't exist or isn't loaded, used by systems that query every frame
+             * @param id The ID of the animation
+             * @return Pointer to the animation, nullptr if it doesn't exist or isn't loaded
+             */
+            static shared_ptr<Render::Animation> FindAnimation(AnimationID id);
+
+            /**
+             * @brief Gets a handle to the animation, it won't be evicted while the handle is alive
+             * @param id The ID of the animation
+             * @return Handle to the animation, empty if it doesn't exist or isn't loaded yet
+             */
+            static AssetHandle<Render::Animation> AcquireAnimation(AnimationID id);
+
+            /**
+             * @brief Unloads the least recently used animations until the loaded ones fit
+             *        in the budget, called by \c AssetBudget::Collect()
+             * @param budget Max bytes of loaded animations
+             */
+            static void Evict(size_t budget);
+
             static void PrintList();
+
+            /**
+             * @param id The ID of the animation
+             * @return true if the animation exists, even if it isn't loaded yet
+             */
+            static bool HasAnimation(AnimationID id) { return m_animationList.Contains(id); }
+
+            static Render::Animation_List& GetAnimationList() { return m_animationList; }
             
         private:
             static Render::Animation_List m_animationList;
-            static Render::AnimationID_List m_IDToNameList;
             static vector<path> m_animationPathList;
+            static int m_maxSheetSize;
+
+            /**
+             * @brief Marks the animation as used this frame and queues it again if it was evicted
+             */
+            static void Touch(Render::AnimationInfo& info);
             static const void* TakeAddressOfAnimation(const Render::AnimationInfo* animInfo);
     };
 }
\ No newline at end of file
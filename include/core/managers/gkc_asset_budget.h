@@ -0,0 +1,126 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Core::Managers {
+    inline constexpr Uint64 GKC_ASSET_COLLECT_INTERVAL = 60;   // Frames between evictions
+
+    /**
+     * @enum Asset_Class
+     * @brief Classes of assets with their own memory budget
+     */
+    enum class Asset_Class {
+        Texture,        // VRAM
+        Animation,      // VRAM
+        Audio,          // RAM, PCM of predecoded files and encoded data of streamed ones
+        Count
+    };
+
+    /**
+     * @struct EvictionCandidate
+     * @brief Loaded asset that nothing outside its manager is referencing
+     */
+    struct EvictionCandidate {
+        string name_;
+        Uint64 lastUsedFrame_;
+        size_t bytes_;
+    };
+
+    /**
+     * @class AssetBudget
+     * @brief Memory budget per asset class and least recently used eviction
+     *
+     * Managers stamp their assets with the current frame every time they are retrieved,
+     * every \c GKC_ASSET_COLLECT_INTERVAL frames each manager whose loaded assets go over
+     * the budget unloads the least recently used assets that aren't referenced outside the
+     * manager (no \c AssetHandle or shared_ptr alive). Evicted assets keep their ID and
+     * are reloaded in the background the next time they are retrieved.
+     *
+     * A budget of 0 (default) means unlimited.
+     */
+    class AssetBudget {
+        public:
+            /**
+             * @param type Asset class
+             * @param bytes Max bytes of loaded assets, 0 for unlimited
+             */
+            static void SetBudget(Asset_Class type, size_t bytes);
+            static size_t GetBudget(Asset_Class type);
+            static Uint64 GetFrame() { return m_frame; }
+
+            /**
+             * @brief Advances the frame counter and collects when the interval is reached,
+             *        call it once per frame
+             */
+            static void Update();
+
+            /**
+             * @brief Evicts assets of every class that is over its budget
+             */
+            static void Collect();
+
+            /**
+             * @brief Picks the least recently used candidates until the rest fit in the budget,
+             *        assets used in the current or the previous frame are never picked
+             * @param candidates Evictable assets (sorted by this function)
+             * @param totalBytes Bytes used by all loaded assets of the class
+             * @param budget Budget of the class
+             * @return Names of the assets to evict
+             */
+            static vector<string> SelectEvictions(vector<EvictionCandidate>& candidates, size_t totalBytes,
+                size_t budget);
+        private:
+            static array<size_t, static_cast<size_t>(Asset_Class::Count)> m_budgets;
+            static Uint64 m_frame;
+    };
+
+    /**
+     * @class AssetHandle
+     * @brief Typed reference to a loaded asset
+     *
+     * While a handle is alive its asset can't be evicted. A handle is empty if the
+     * asset doesn't exist or is still being (re)loaded, check it with \c IsValid().
+     * @tparam T Asset type (Render::Texture, Render::Animation, Audio::AudioFile)
+     */
+    template<typename T>
+    class AssetHandle {
+        public:
+            AssetHandle() = default;
+            AssetHandle(Uint32 id, shared_ptr<T> asset) : m_id(id), m_asset(std::move(asset)) {}
+
+            [[nodiscard]] T* Get() const { return m_asset.get(); }
+            [[nodiscard]] Uint32 GetID() const { return m_id; }
+            [[nodiscard]] bool IsValid() const { return m_asset != nullptr; }
+            T* operator->() const { return m_asset.get(); }
+            explicit operator bool() const { return IsValid(); }
+
+            /**
+             * @brief Releases the reference, the asset can be evicted again
+             */
+            void Reset() { m_asset.reset(); }
+        private:
+            Uint32 m_id = 0;
+            shared_ptr<T> m_asset;
+    };
+}
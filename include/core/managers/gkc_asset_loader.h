@@ -0,0 +1,142 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Render {
+    struct AtlasImage;
+    struct BakedAtlas;
+    struct BakedAnimation;
+}
+
+namespace Galaktic::Core::Managers {
+    inline constexpr double GKC_ASSET_UPLOAD_BUDGET_MS = 4.0;   // Default upload time per frame
+
+    /**
+     * @enum Asset_Type
+     * @brief Types of assets the loader can decode
+     */
+    enum class Asset_Type {
+        Texture,
+        Animation,
+        TextureAtlas
+    };
+
+    /**
+     * @class AssetLoader
+     * @brief Decodes assets on worker threads and uploads them on the main thread
+     *
+     * Requests are queued from the main thread, the workers read and decode the files into
+     * SDL_Surfaces (animations are also packed into sheets and the atlas is baked) without
+     * touching the renderer. Every image of an atlas is a request of its own, the worker
+     * that decodes the last one packs the atlas. The main thread calls \c Pump() once per frame, which uploads
+     * finished assets until the time budget runs out and hands them to their managers.
+     * Until an asset is uploaded its manager returns nullptr for it and the drawer
+     * shows the missing texture.
+     */
+    class AssetLoader {
+        public:
+            /**
+             * @brief Starts the worker threads, it does nothing if they are already running
+             * @param threadCount Number of workers, 0 uses the hardware threads minus the main one
+             */
+            static void Start(size_t threadCount = 0);
+
+            /**
+             * @brief Stops and joins the workers, pending requests and finished assets that
+             *        weren't uploaded are discarded
+             */
+            static void Stop();
+
+            static void QueueTexture(const path& path);
+
+            /**
+             * @param path Animation path
+             * @param maxSheetSize Max size of the sheets (see \c Animation::GetMaxSheetSize())
+             */
+            static void QueueAnimation(const path& path, int maxSheetSize);
+
+            /**
+             * @brief Queues a decode per image, the atlas counts as a single pending asset
+             * @param files Images to pack
+             * @param cacheFolder Folder where the atlas is cached
+             */
+            static void QueueAtlas(const vector<path>& files, const path& cacheFolder);
+
+            /**
+             * @brief Uploads finished assets, at least one asset is uploaded per call
+             * @param renderer SDL_Renderer
+             * @param budgetMs Time in milliseconds after which no more assets are uploaded
+             */
+            static void Pump(SDL_Renderer* renderer, double budgetMs = GKC_ASSET_UPLOAD_BUDGET_MS);
+
+            /**
+             * @return Number of assets queued or decoded that haven't been uploaded yet
+             */
+            static size_t GetPendingCount() { return m_pending.load(); }
+            static bool IsRunning() { return !m_workers.empty(); }
+        private:
+            /**
+             * @struct AtlasBatch
+             * @brief Images of an atlas shared by its decode requests
+             */
+            struct AtlasBatch {
+                ~AtlasBatch();
+
+                path cacheFolder_;
+                vector<Render::AtlasImage> images_;     // One slot per request, filled by the workers
+                std::atomic<size_t> remaining_ = 0;     // Decodes left, the last one packs the atlas
+            };
+
+            struct LoadRequest {
+                Asset_Type type_;
+                path path_;
+                int maxSheetSize_ = 0;
+                shared_ptr<AtlasBatch> batch_;
+                size_t index_ = 0;                      // Image of the batch to decode
+            };
+
+            struct LoadResult {
+                Asset_Type type_;
+                path path_;
+                SDL_Surface* surface_ = nullptr;
+                unique_ptr<Render::BakedAnimation> animation_;
+                unique_ptr<Render::BakedAtlas> atlas_;
+            };
+
+            static vector<std::thread> m_workers;
+            static std::deque<LoadRequest> m_requests;
+            static std::deque<LoadResult> m_results;
+            static std::mutex m_requestMutex;
+            static std::mutex m_resultMutex;
+            static std::condition_variable m_condition;
+            static std::atomic<size_t> m_pending;
+            static bool m_stop;
+
+            static void Queue(LoadRequest request);
+            static void WorkerLoop();
+            static LoadResult Process(const LoadRequest& request);
+            static void Finish(LoadResult& result, SDL_Renderer* renderer);
+            static void Discard(LoadResult& result);
+    };
+}
@@ -0,0 +1,189 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Core::Managers {
+    inline constexpr Uint32 GKC_ASSET_INDEX_BITS = 24;
+    inline constexpr Uint32 GKC_ASSET_INDEX_MASK = (1u << GKC_ASSET_INDEX_BITS) - 1;
+    inline constexpr Uint32 GKC_ASSET_MAX_GENERATION = (1u << (32 - GKC_ASSET_INDEX_BITS)) - 1;
+
+    /**
+     * @class AssetTable
+     * @brief Dense storage for assets addressed by ID
+     *
+     * Assets live in a slot array, an ID is the slot index + 1 in the low 24 bits and the
+     * slot generation in the high 8 bits, so retrieving an asset by ID is a single array access.
+     * When an asset is erased its slot generation is bumped, IDs that still point to the
+     * old asset are rejected instead of returning whatever reused the slot. A slot that used
+     * its last generation is retired (until \c Clear() ), wrapping around would make the
+     * IDs of its first asset valid again.
+     *
+     * Names are only kept in a side index used when loading, saving or scripting.
+     * Slots start at generation 0, so the first asset gets ID 1, the second ID 2... the same
+     * IDs that were stored in scenes before the table existed.
+     * @tparam T Stored value (usually a shared_ptr to the asset info)
+     */
+    template<typename T>
+    class AssetTable {
+        public:
+            /**
+             * @brief Inserts a value under the given name
+             * @param name Asset name (filename with extension)
+             * @param value Value to store
+             * @return ID of the new asset, the existing ID if the name was already in the table
+             *         (the value isn't replaced) or 0 if the table is full
+             */
+            Uint32 Insert(const string& name, T value) {
+                if (auto it = m_nameToID.find(name); it != m_nameToID.end())
+                    return it->second;
+
+                Uint32 index;
+                if (!m_freeList.empty()) {
+                    index = m_freeList.back();
+                    m_freeList.pop_back();
+                } else {
+                    if (m_slots.size() >= GKC_ASSET_INDEX_MASK)
+                        return 0;
+                    index = static_cast<Uint32>(m_slots.size());
+                    m_slots.emplace_back();
+                }
+
+                Slot& slot = m_slots[index];
+                slot.value_ = std::move(value);
+                slot.name_ = name;
+                slot.occupied_ = true;
+
+                Uint32 id = MakeID(index, slot.generation_);
+                m_nameToID.emplace(name, id);
+                return id;
+            }
+
+            /**
+             * @brief Removes an asset, its ID becomes invalid
+             * @return true if the ID was valid
+             */
+            bool Erase(Uint32 id) {
+                Slot* slot = GetSlot(id);
+                if (slot == nullptr)
+                    return false;
+
+                m_nameToID.erase(slot->name_);
+                slot->value_ = T{};
+                slot->name_.clear();
+                slot->occupied_ = false;
+                if (++slot->generation_ <= GKC_ASSET_MAX_GENERATION)
+                    m_freeList.push_back(GetIndex(id));
+                return true;
+            }
+
+            bool Erase(const string& name) { return Erase(FindID(name)); }
+
+            /**
+             * @return Pointer to the value, nullptr if the ID is invalid or was erased
+             */
+            T* Get(Uint32 id) {
+                Slot* slot = GetSlot(id);
+                return slot != nullptr ? &slot->value_ : nullptr;
+            }
+
+            const T* Get(Uint32 id) const {
+                return const_cast<AssetTable*>(this)->Get(id);
+            }
+
+            /**
+             * @return Pointer to the value, nullptr if there's no asset with that name
+             */
+            T* Find(const string& name) { return Get(FindID(name)); }
+            const T* Find(const string& name) const { return Get(FindID(name)); }
+
+            /**
+             * @return ID of the asset, 0 if there's no asset with that name
+             */
+            [[nodiscard]] Uint32 FindID(const string& name) const {
+                auto it = m_nameToID.find(name);
+                return it != m_nameToID.end() ? it->second : 0;
+            }
+
+            /**
+             * @return Name of the asset, nullptr if the ID is invalid
+             */
+            [[nodiscard]] const string* GetName(Uint32 id) const {
+                const Slot* slot = const_cast<AssetTable*>(this)->GetSlot(id);
+                return slot != nullptr ? &slot->name_ : nullptr;
+            }
+
+            [[nodiscard]] bool Contains(Uint32 id) const { return GetName(id) != nullptr; }
+            [[nodiscard]] size_t Size() const { return m_nameToID.size(); }
+            [[nodiscard]] bool Empty() const { return m_nameToID.empty(); }
+
+            /**
+             * @brief Calls fn(name, value) for every asset, in slot order
+             */
+            template<typename Fn>
+            void ForEach(Fn&& fn) {
+                for (auto& slot : m_slots) {
+                    if (slot.occupied_)
+                        fn(std::as_const(slot.name_), slot.value_);
+                }
+            }
+
+            void Clear() {
+                m_slots.clear();
+                m_freeList.clear();
+                m_nameToID.clear();
+            }
+        private:
+            struct Slot {
+                T value_{};
+                string name_;
+                Uint32 generation_ = 0;
+                bool occupied_ = false;
+            };
+
+            vector<Slot> m_slots;
+            vector<Uint32> m_freeList;
+            unordered_map<string, Uint32> m_nameToID;
+
+            static Uint32 MakeID(Uint32 index, Uint32 generation) {
+                return (generation << GKC_ASSET_INDEX_BITS) | (index + 1);
+            }
+
+            static Uint32 GetIndex(Uint32 id) { return (id & GKC_ASSET_INDEX_MASK) - 1; }
+
+            Slot* GetSlot(Uint32 id) {
+                if ((id & GKC_ASSET_INDEX_MASK) == 0)
+                    return nullptr;
+
+                Uint32 index = GetIndex(id);
+                if (index >= m_slots.size())
+                    return nullptr;
+
+                Slot& slot = m_slots[index];
+                if (!slot.occupied_ || slot.generation_ != (id >> GKC_ASSET_INDEX_BITS))
+                    return nullptr;
+                return &slot;
+            }
+    };
+}
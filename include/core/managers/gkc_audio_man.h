@@ -23,12 +23,9 @@
 
 #pragma once
 #include <pch.hpp>
-
-namespace Galaktic::Audio {
-    class AudioFile;
-    struct AudioInfo;
-    typedef unordered_map<string, shared_ptr<AudioInfo>> Audio_List;
-}
+#include <core/managers/gkc_asset_budget.h>
+#include <core/managers/gkc_asset_table.h>
+#include <audio/gkc_audio.h>
 
 namespace Galaktic::Core::Managers {
     /**
@@ -41,11 +38,18 @@ namespace Galaktic::Core::Managers {
      *
      * An \c MIX_Mixer pointer is created using the previously created device
      * to play tracks. \n
-     * All tracks are saved into a \c std::multimap, the key is the \c AudioID from an
-     * \c AudioInfo instance inside the audio list, many tracks with the same sound
-     * can be played, if a track is stopped using \c StopSound the first track played
-     * will be stopped inside the multimap. \n Use \c StopAllTracksFromSound to stop all
-     * tracks playing the same sound
+     * Tracks come from a pool of \c GKC_AUDIO_VOICES voices created with the mixer, playing
+     * a sound takes a free voice and finished voices are recycled, so playing doesn't allocate.
+     * When every voice is busy the oldest voice with the lowest priority (never higher than
+     * the new sound's) is stolen, if there's none the sound isn't played. \n
+     * Many tracks with the same sound can be played, if a track is stopped using
+     * \c StopSound the first track played will be stopped. \n Use \c StopAllTracksFromSound
+     * to stop all tracks playing the same sound
+     *
+     * Short sound effects are predecoded so they start instantly, long compressed files
+     * (music) are streamed, see \c Audio::ChooseAudioMode(). Loaded audio is kept under
+     * the \c Asset_Class::Audio budget (\c GKC_AUDIO_PCM_BUDGET unless another one is set),
+     * the least recently used files that aren't playing are unloaded first.
      *
      * @attention The key values for the audio list (m_audioFiles) are registered
      * with their full name, <b> (extension included!) </b> don't forget to add the
@@ -54,9 +58,33 @@ namespace Galaktic::Core::Managers {
     class AudioManager {
         public:
             /**
-             * @param folder folder path (audio folder)
+             * @param folder folder path (audio folder), if empty no file is added
+             * @param output \c Audio_Output::Offline creates the mixer without a device, used by
+             *        benchmarks and headless machines, the output has to be pulled with \c Generate()
+             * @param voiceCount voices in the pool
              */
-            explicit AudioManager(const string& folder);
+            explicit AudioManager(const string& folder, Audio::Audio_Output output = Audio::Audio_Output::Device,
+                Uint32 voiceCount = Audio::GKC_AUDIO_VOICES);
+
+            /**
+             * @brief Mixes the playing voices into the buffer, only for an offline mixer.
+             *        The output is deterministic, every call advances the mix by the size of the buffer
+             * @param buffer Output in the format of \c GetAudioSpec()
+             * @param bytes Size of the buffer, a multiple of the frame size
+             * @return false if the mixer isn't offline or mixing failed
+             */
+            static bool Generate(void* buffer, size_t bytes);
+
+            /**
+             * @brief Mixes the next seconds of audio and writes them to a WAV file, only for an offline mixer
+             * @param file WAV filepath
+             * @param seconds Seconds to render
+             * @return false if mixing or writing failed
+             */
+            static bool RenderToWAV(const path& file, double seconds);
+
+            static bool IsOffline() { return m_offline; }
+            static const SDL_AudioSpec& GetAudioSpec() { return m_audioSpec; }
 
             /**
              * Adds an audio file to the list, an ID for the file
@@ -65,6 +93,13 @@ namespace Galaktic::Core::Managers {
              */
             static void AddAudioFile(const string& filepath);
 
+            /**
+             * Same as \c AddAudioFile() but the file is always streamed, only the encoded
+             * data is kept in memory
+             * @param filepath audio filepath
+             */
+            static void AddMusicFile(const string& filepath);
+
             /**
              * Removes an audio file from the list, all tracks referring
              * to the file will be stopped
@@ -79,12 +114,15 @@ namespace Galaktic::Core::Managers {
              * list in order to play
              * @param name audio filename
              * @param loops times to loop
+             * @param priority voices playing sounds with a lower or equal priority can be stolen
+             * @note Lua scripts pass the priority with \c PlayAudioFileWithPriority()
              */
-            static void PlayAudioFile(const string& name, int loops = 0);
+            static void PlayAudioFile(const string& name, int loops = 0, int priority = 0);
 
             /**
              * Plays a track indefinitely until stopped or dereferenced
-             * , the audio file should exist in the list in order to play
+             * , the audio file should exist in the list in order to play.
+             * Music plays with \c GKC_AUDIO_PRIORITY_MUSIC so sound effects never steal it
              * @param name music filename
              */
             static void PlayMusicFile(const string& name);
@@ -128,6 +166,61 @@ namespace Galaktic::Core::Managers {
 
             static shared_ptr<Audio::AudioInfo> GetAudioInfo(const string& name);
 
+            /**
+             * @brief Gets a handle to the audio file, it won't be evicted while the handle is alive
+             * @param name audio filename
+             * @return Handle to the audio file, empty if it doesn't exist
+             */
+            static AssetHandle<Audio::AudioFile> AcquireAudio(const string& name);
+
+            /**
+             * @brief Unloads the least recently used audio files that aren't playing until
+             *        the loaded ones fit in the budget, called by \c AssetBudget::Collect()
+             * @param budget Max bytes of decoded audio
+             */
+            static void Evict(size_t budget);
+
+            /**
+             * @return true if a voice is playing the audio file (fading out included)
+             */
+            static bool IsPlaying(AudioID id);
+
+            /**
+             * @brief Plays an audio file and returns the voice so it can be controlled later,
+             *        used by the \c AudioSystem for emitters
+             * @param id audio file's ID
+             * @param loops times to loop, -1 forever
+             * @param priority voices playing sounds with a lower priority can be stolen, unlike
+             *        \c PlayAudioFile() equal ones aren't (emitters would steal each other's voices)
+             * @param gain initial gain, applied before the track starts
+             * @param pan initial panning, applied before the track starts
+             * @return The voice, \c GKC_INVALID_VOICE if it couldn't be played
+             */
+            static Audio::VoiceID PlayVoice(AudioID id, int loops, int priority, float gain = 1.f,
+                float pan = 0.f);
+
+            /**
+             * @return true if the voice is still playing the sound it was returned for
+             */
+            static bool IsVoicePlaying(Audio::VoiceID voice);
+
+            /**
+             * @brief Tells a voice that was stolen by a more important sound from one that
+             *        finished, the voice is forgotten afterwards
+             * @param voice Voice returned by \c PlayVoice() that isn't playing anymore
+             * @return true if the voice was stolen
+             */
+            static bool ConsumeStolenVoice(Audio::VoiceID voice);
+
+            static void StopVoice(Audio::VoiceID voice, Sint64 fadeOutMs = 0);
+
+            /**
+             * @brief Applies gain and panning to many voices while the mixer is locked once,
+             *        invalid voices are skipped
+             * @param parameters Parameters of every voice to update
+             */
+            static void SetVoiceParameters(const vector<Audio::VoiceParameters>& parameters);
+
             static Audio::Audio_List& GetAudioList() { return m_audioFiles; }
 
             /**
@@ -136,17 +229,72 @@ namespace Galaktic::Core::Managers {
              */
             static void PrintList();
         private:
+            static constexpr Uint32 NO_VOICE = std::numeric_limits<Uint32>::max();
+
+            struct Voice {
+                MIX_Track* track_ = nullptr;
+                AudioID audioID_ = 0;
+                Uint64 startTick_ = 0;          // The oldest voice is stolen first
+                int priority_ = 0;
+                Uint32 generation_ = 0;         // Bumped when recycled, stale stop callbacks are ignored
+                Uint32 prev_ = NO_VOICE;        // Voices playing the same sound, oldest first
+                Uint32 next_ = NO_VOICE;
+                bool playing_ = false;          // Fading out voices are still playing
+                bool linked_ = false;           // Can still be stopped by StopSound
+                bool tracked_ = false;          // Played by PlayVoice, its handle is polled
+            };
+
+            struct SoundVoices {
+                Uint32 head_ = NO_VOICE;
+                Uint32 tail_ = NO_VOICE;
+                Uint32 count_ = 0;              // Playing voices, linked or fading out
+            };
+
             static Audio::Audio_List m_audioFiles;
-            static std::multimap<AudioID, MIX_Track*> m_activeTracks;
+            static vector<Voice> m_voices;
+            static vector<Uint32> m_freeVoices;
+            static unordered_map<AudioID, SoundVoices> m_soundVoices;
+            static vector<Audio::VoiceID> m_finishedVoices;     // Filled by the mixer thread
+            static unordered_set<Audio::VoiceID> m_stolenVoices;  // Tracked voices that were stolen
+            static std::mutex m_finishedMutex;
             static SDL_AudioSpec m_audioSpec;
             static SDL_AudioDeviceID m_deviceID;
             static MIX_Mixer* m_mixer;
+            static bool m_offline;
+
+            /**
+             * @brief Starts a track of the audio file on a free or stolen voice
+             * @param tracked The voice is played by \c PlayVoice() , it only steals voices with a
+             *        lower priority and it's recorded when it's stolen
+             * @return The voice, \c GKC_INVALID_VOICE if every voice has a higher priority
+             */
+            static Audio::VoiceID StartVoice(Audio::AudioInfo& info, int loops, int priority,
+                float gain, float pan, bool tracked = false);
+
+            /**
+             * @brief Stops a voice, without fade it's recycled right away, otherwise it's
+             *        recycled once the mixer reports the track stopped
+             */
+            static void StopVoiceAt(Uint32 index, Sint64 fadeOutMs);
+
+            /**
+             * @return Index of the voice, \c NO_VOICE if the handle is stale
+             */
+            static Uint32 FindVoice(Audio::VoiceID voice);
+            static Audio::VoiceID MakeVoiceID(Uint32 index);
+            static void ApplyVoiceParameters(const Voice& voice, float gain, float pan);
+            static Uint32 AcquireVoice(int priority, bool stealEqual);
+            static void ReleaseVoice(Uint32 index);
+            static void UnlinkVoice(Uint32 index);
+            static void CollectFinishedVoices();
+            static void SDLCALL OnTrackStopped(void* userdata, MIX_Track* track);
+
+            static void InsertAudioFile(const string& filepath, Audio::Audio_Mode mode);
 
             /**
-             * Helper to register a track inside the track list
-             * @param id AudioInfo's id
-             * @param track Track created from an AudioFile
+             * @brief Marks the audio file as used this frame and reloads it if it was evicted
+             * @return The audio file, nullptr if it couldn't be reloaded
              */
-            static void RegisterTrack(AudioID id, MIX_Track* track);
+            static shared_ptr<Audio::AudioFile> Touch(Audio::AudioInfo& info);
     };
 }
\ No newline at end of file
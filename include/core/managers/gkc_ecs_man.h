@@ -134,6 +134,7 @@ namespace Galaktic::Core::Managers {
                     return;
 
                 m_registry->GetComponentPools()[type][id] = std::move(comp);
+                m_registry->MarkChanged(type, id);
                 if (!ECS::ComponentRegistry::IsRegistered(type)) {
                     ECS::ComponentRegistry::RegisterComponentByType(type, id, false);
                 }
@@ -144,10 +145,11 @@ namespace Galaktic::Core::Managers {
                 if (it == m_entityList.end())
                     return;
 
+                // The type stays registered, other entities (and the saver thread) still use it
                 auto& componentPool = m_registry->GetComponentPools()[type];
                 if(ECS::ComponentRegistry::IsRegistered(type) && componentPool.contains(id)) {
-                    ECS::ComponentRegistry::UnregisterComponentByType(type);
                     componentPool.erase(id);
+                    m_registry->MarkRemoved(type, id);
                 }
             }
 
@@ -166,6 +168,7 @@ namespace Galaktic::Core::Managers {
                     return;
 
                 m_registry->GetComponentPools()[type][id] = any{};
+                m_registry->MarkChanged(type, id);
                 if (!ECS::ComponentRegistry::IsRegistered(type)) {
                     ECS::ComponentRegistry::RegisterComponentByType(type, id, false);
                 }
@@ -181,9 +184,10 @@ namespace Galaktic::Core::Managers {
              */
             template<typename T>
             ECS::Entity CreateEntity(const string& name) {
-                EntityID id = m_entityList.size() + 1;
+                EntityID id = m_nextID++;
                 ECS::Entity entity = ECS::Entity(id, m_registry);
                 m_entityList.emplace(id, entity);
+                m_registry->MarkEntityCreated(id);
                 string uniqueName = Core::GenerateUniqueName(m_nameToEntityList, name);
                 AddComponentToEntity<ECS::NameComponent>(id, uniqueName);
                 AddTagToEntity<T>(id);
@@ -201,9 +205,10 @@ namespace Galaktic::Core::Managers {
              * @param type Tag type
              */
             void CreateEntityByTypeIndex(const string& name, const type_index& type) {
-                EntityID id = m_entityList.size() + 1;
+                EntityID id = m_nextID++;
                 ECS::Entity entity = ECS::Entity(id, m_registry);
                 m_entityList.emplace(id, entity);
+                m_registry->MarkEntityCreated(id);
 
                 string uniqueName = Core::GenerateUniqueName(m_nameToEntityList, name);
                 AddComponentToEntity<ECS::NameComponent>(id, uniqueName);
@@ -225,6 +230,59 @@ namespace Galaktic::Core::Managers {
              */
             void AddEmptyEntity(EntityID id, ECS::Entity& entity) {
                 m_entityList.emplace(id, entity);
+                m_registry->MarkEntityCreated(id);
+                m_nextID = std::max(m_nextID, id + 1);
+            }
+
+            /**
+             * @brief Adds an entity whose components were already moved into the registry
+             *        by the \c WorldStreamer , the entity isn't recorded as a change since
+             *        it already exists in the world file
+             * @param id Entity's ID
+             */
+            void AddStreamedEntity(EntityID id) {
+                m_entityList.emplace(id, ECS::Entity(id, m_registry));
+                m_nextID = std::max(m_nextID, id + 1);
+                IndexEntityName(id);
+            }
+
+            /**
+             * @brief Adds the name of an entity whose components were read straight into the
+             *        registry to the name list, a name already used keeps its first entity
+             * @param id Entity's ID
+             */
+            void IndexEntityName(EntityID id) {
+                if (const auto* names = m_registry->GetPool<ECS::NameComponent>(); names != nullptr) {
+                    if (auto it = names->find(id); it != names->end())
+                        m_nameToEntityList.emplace(std::any_cast<const ECS::NameComponent&>(it->second).m_name, id);
+                }
+            }
+
+            /**
+             * @brief Removes an entity streamed out by the \c WorldStreamer , unlike
+             *        \c DeleteEntity() it isn't recorded as destroyed
+             * @param id Entity's ID
+             */
+            void UnloadEntity(EntityID id) {
+                if (EraseEntity(id))
+                    m_registry->ForgetEntity(id);
+            }
+
+            /**
+             * @brief Keeps the IDs up to maxID for entities that aren't loaded yet, entities
+             *        created afterwards get higher IDs
+             * @param maxID Highest ID in use
+             */
+            void ReserveEntityIDs(EntityID maxID) {
+                m_nextID = std::max(m_nextID, maxID + 1);
+            }
+
+            /**
+             * @brief Reserves room for more entities, used before adding many empty entities
+             * @param count Number of entities that will be added
+             */
+            void ReserveEntities(size_t count) {
+                m_entityList.reserve(m_entityList.size() + count);
             }
 
             /**
@@ -355,32 +413,16 @@ namespace Galaktic::Core::Managers {
              * @param id Entity's ID
              */
             void DeleteEntity(EntityID id) {
-                if(m_entityList.contains(id)) {
-                    // CRITICAL FIX: Remove all components from the registry before deleting entity
-                    // Get all component types and remove them
-                    auto& componentPools = m_registry->GetComponentPools();
-                    for(auto& [type, pool] : componentPools) {
-                        if(pool.contains(id)) {
-                            pool.erase(id);
-                        }
-                    }
-                    // Also remove from name index
-                    auto it = m_entityList.find(id);
-                    if(it != m_entityList.end()) {
-                        if(it->second.Has<ECS::NameComponent>()) {
-                            auto& nameComp = it->second.Get<ECS::NameComponent>();
-                            m_nameToEntityList.erase(nameComp.m_name);
-                        }
-                    }
-                    m_entityList.erase(id);
-                }
+                if (EraseEntity(id))
+                    m_registry->MarkEntityDestroyed(id);
             }
 
             void DeleteEntityByName(const string& name) {
                 auto it = m_nameToEntityList.find(name);
                 if (it != m_nameToEntityList.end()) {
-                    DeleteEntity(it->second);
-                    m_nameToEntityList.erase(it);
+                    // The name is erased with the entity, the iterator isn't valid after
+                    EntityID id = it->second;
+                    DeleteEntity(id);
                 }
             }
 
@@ -399,6 +441,31 @@ namespace Galaktic::Core::Managers {
             ECS::Entity_List m_entityList;
             ECS::NameToEntity_List m_nameToEntityList;
             ECS::Registry* m_registry;
+            EntityID m_nextID = 1;      // IDs aren't reused, unloaded entities keep theirs
+
+            /**
+             * @brief Removes the entity, its components and its name
+             * @return true if the entity existed
+             */
+            bool EraseEntity(EntityID id) {
+                auto it = m_entityList.find(id);
+                if (it == m_entityList.end())
+                    return false;
+
+                // The name goes first, it's read from the components
+                if (const auto* names = m_registry->GetPool<ECS::NameComponent>(); names != nullptr) {
+                    if (auto name = names->find(id); name != names->end()) {
+                        auto indexed = m_nameToEntityList.find(std::any_cast<const ECS::NameComponent&>(name->second).m_name);
+                        if (indexed != m_nameToEntityList.end() && indexed->second == id)
+                            m_nameToEntityList.erase(indexed);
+                    }
+                }
+                // CRITICAL FIX: Remove all components from the registry before deleting entity
+                for (auto& [type, pool] : m_registry->GetComponentPools())
+                    pool.erase(id);
+                m_entityList.erase(it);
+                return true;
+            }
     };
 }
 
@@ -0,0 +1,67 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Filesystem {
+    class FileWatcher;
+}
+
+namespace Galaktic::Core::Managers {
+    /**
+     * @class HotReloadManager
+     * @brief Reloads textures, animations and scripts when their files change
+     *
+     * The texture, animation and local script folders of the project are watched with a
+     * \c FileWatcher, every changed file is reloaded in place by its manager so entities keep
+     * their IDs. Textures and animations are decoded by the \c AssetLoader and swapped once
+     * uploaded, scripts are executed again on the main thread (Lua isn't thread safe), a
+     * script that fails to compile keeps the previous version.
+     *
+     * New files are added to their manager with a new ID, deleted files are ignored.
+     */
+    class HotReloadManager {
+        public:
+            /**
+             * @brief Starts watching the project folders
+             * @param projectPath Project folder
+             */
+            static void Start(const path& projectPath);
+            static void Stop();
+            static bool IsRunning() { return m_watcher != nullptr; }
+
+            /**
+             * @brief Reloads the files whose changes were debounced, call it once per frame
+             * @param renderer SDL_Renderer, used when the asset loader isn't running
+             */
+            static void Update(SDL_Renderer* renderer);
+        private:
+            static unique_ptr<Filesystem::FileWatcher> m_watcher;
+            static path m_projectPath;
+            static vector<path> m_changed;
+
+            static void Reload(const path& file, SDL_Renderer* renderer);
+            static bool IsInside(const path& file, const path& folder);
+    };
+}
@@ -33,6 +33,13 @@ namespace Galaktic::Core::Managers {
             static void AddInlineScript(const string& scriptName, const string& script);
             static void AddScriptFromFile(const string& scriptPath);
 
+            /**
+             * @brief Executes a script file again after it changed, the script keeps its ID.
+             *        If the new version fails the previous one is kept
+             * @param scriptPath Script's path
+             */
+            static void ReloadScript(const path& scriptPath);
+
             static void RunScript(const string& scriptName);
             static void DeleteScriptFromList(const string& scriptName);
 
@@ -42,7 +49,6 @@ namespace Galaktic::Core::Managers {
             static Script::Script_List& GetScriptList() { return m_scriptList; }
         private:
             static Script::Script_List m_scriptList;
-            static unordered_map<ScriptID, string> m_IDToNameList;
             static lua_State* m_luaState;
             static void ExecuteGalakticModule();
     };
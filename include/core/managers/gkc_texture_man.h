@@ -23,12 +23,16 @@
 
 #pragma once
 #include <pch.hpp>
+#include <core/managers/gkc_asset_budget.h>
+#include <core/managers/gkc_asset_table.h>
 
 namespace Galaktic::Render {
     struct TextureInfo;
     class Texture;
-    typedef unordered_map<string, shared_ptr<TextureInfo>> Texture_List;
-    typedef unordered_map<TextureID, string> TextureID_List;
+    class TextureAtlas;
+    struct AtlasRegion;
+    struct BakedAtlas;
+    typedef Core::Managers::AssetTable<shared_ptr<TextureInfo>> Texture_List;
 }
 
 namespace Galaktic::ECS { 
@@ -48,15 +52,24 @@ namespace Galaktic::Core::Managers {
     * using \c LoadAllTextures() , individual textures can also be loaded, if they
     * don't exist they will be automatically added to the texture list
     * 
-    * Textures are stored in the list with their filename (extension included: e.g. texture.png)
-    * as a key and the value stored inside a TextureInfo struct.
+    * Textures are stored in an \c AssetTable inside a TextureInfo struct, the filename
+    * (extension included: e.g. texture.png) is only used to find the ID when loading,
+    * the drawer retrieves textures by ID with a single array access.
+    *
+    * By default \c LoadAllTextures() packs every texture into a \c TextureAtlas so the
+    * drawer can reuse the same SDL_Texture for many entities, textures that don't fit
+    * in the atlas are loaded individually. The atlas layout is cached in the cache folder.
+    *
+    * Standalone textures can be evicted when \c AssetBudget gives textures a budget,
+    * atlased textures are never evicted since their pages are shared.
     */
     class TextureManager {
         public:
             /**
              * @param path folder path
+             * @param cacheFolder folder where the atlas is cached, if empty it's rebuilt every time
              */
-            TextureManager(const string& path);
+            TextureManager(const string& path, const std::filesystem::path& cacheFolder = {});
 
             /**
              * @brief Adds a texture to this instance's list
@@ -85,6 +98,62 @@ namespace Galaktic::Core::Managers {
              * were automatically added inside \c m_texturePathList
              */
             static void LoadAllTextures(SDL_Renderer* renderer);
+
+            /**
+             * @brief Same as \c LoadAllTextures() but the textures are decoded by the
+             *        \c AssetLoader, they are available once \c AssetLoader::Pump() uploads them.
+             *        If the atlas cache is valid the atlas is loaded right away
+             * @param renderer SDL_Renderer
+             */
+            static void LoadAllTexturesAsync(SDL_Renderer* renderer);
+
+            /**
+             * @brief Uploads a texture decoded by the \c AssetLoader
+             * @param path Texture's path
+             * @param surface Decoded texture (not destroyed), nullptr if the decoding failed
+             * @param renderer SDL_Renderer
+             */
+            static void FinishTexture(const path& path, SDL_Surface* surface, SDL_Renderer* renderer);
+
+            /**
+             * @brief Uploads an atlas baked by the \c AssetLoader and queues the textures
+             *        that didn't fit
+             * @param baked Baked atlas, nullptr if the bake failed
+             * @param renderer SDL_Renderer
+             */
+            static void FinishAtlas(Render::BakedAtlas* baked, SDL_Renderer* renderer);
+
+            /**
+             * @brief Loads a texture again after its file changed, the texture keeps its ID.
+             *        If the \c AssetLoader is running the texture is decoded in the background
+             *        and swapped once uploaded. Atlased textures are replaced by a standalone
+             *        texture until the atlas is baked again
+             * @param path Texture's path
+             * @param renderer SDL_Renderer
+             */
+            static void ReloadTexture(const path& path, SDL_Renderer* renderer);
+
+            /**
+             * @brief Packs all textures in \c m_texturePathList into the atlas
+             * @param renderer SDL_Renderer
+             * @return true if the atlas was built or loaded from the cache
+             */
+            static bool BuildAtlas(SDL_Renderer* renderer);
+
+            /**
+             * @brief Destroys the atlas pages, atlased textures become invalid
+             */
+            static void DestroyAtlas();
+
+            /**
+             * @brief Gets the atlas region of a texture
+             * @param id The ID of the texture
+             * @return Pointer to the region, nullptr if the texture isn't atlased
+             */
+            static const Render::AtlasRegion* GetAtlasRegion(TextureID id);
+
+            static void SetAtlasEnabled(bool enabled) { m_useAtlas = enabled; }
+            static bool IsAtlasEnabled() { return m_useAtlas; }
             
             /**
              * @brief Deletes the texture on the list
@@ -111,6 +180,20 @@ namespace Galaktic::Core::Managers {
              */
             static shared_ptr<Render::Texture> GetTextureByID(TextureID id);
 
+            /**
+             * @brief Gets a handle to the texture, it won't be evicted while the handle is alive
+             * @param id The ID of the texture
+             * @return Handle to the texture, empty if it doesn't exist or isn't loaded yet
+             */
+            static AssetHandle<Render::Texture> AcquireTexture(TextureID id);
+
+            /**
+             * @brief Unloads the least recently used standalone textures until the loaded
+             *        ones fit in the budget, called by \c AssetBudget::Collect()
+             * @param budget Max bytes of loaded textures
+             */
+            static void Evict(size_t budget);
+
             /**
              * Gets a pointer to the texture info, this function is used to retrieve
              * the info (ID + Texture's instance), this function is used by the
@@ -139,15 +222,28 @@ namespace Galaktic::Core::Managers {
              */
             static void PrintList();
 
+            /**
+             * @param id The ID of the texture
+             * @return Name of the texture (the key used by the other functions), nullptr if it doesn't exist
+             */
+            static const string* GetTextureName(TextureID id) { return m_textureList.GetName(id); }
+
             static Render::Texture_List& GetTextureList() { return m_textureList; }
-            static Render::TextureID_List& GetIDTextureList() { return m_IDToNameList; } 
             static vector<path>& GetTexturePathList() { return m_texturePathList; }
         private:
             static Render::Texture_List m_textureList;
             static vector<path> m_texturePathList;
-            static Render::TextureID_List m_IDToNameList;
             static SDL_Texture* m_missingTexture;
+            static Render::TextureAtlas m_atlas;
+            static path m_cacheFolder;
+            static bool m_useAtlas;
         private:
             static const void* TakeAdressOfTexture(const Render::TextureInfo* textureInfo);
+
+            /**
+             * @brief Points every texture that is inside the atlas to its region
+             */
+            static void AssignAtlasTextures();
+            static void QueueMissingTextures();
     };
 }
\ No newline at end of file
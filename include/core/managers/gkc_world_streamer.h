@@ -0,0 +1,188 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+#pragma once
+#include <pch.hpp>
+#include <filesys/gkc_archive.h>
+#include <filesys/gkc_scene_format.h>
+
+namespace Galaktic::ECS {
+    class Registry;
+}
+
+namespace Galaktic::Core::Managers {
+    class ECS_Manager;
+
+    inline constexpr double GKC_WORLD_MERGE_BUDGET_MS = 2.0;   // Default time spent adding cells per frame
+
+    /**
+     * @enum Cell_State
+     * @brief Where a cell of a streamed world is at
+     */
+    enum class Cell_State {
+        Unloaded,
+        Loading,        // Queued or being read by the worker
+        Loaded,
+        Corrupted       // Couldn't be read, it isn't tried again
+    };
+
+    /**
+     * @class WorldStreamer
+     * @brief Streams the cells of a world (.gkworld) around a point, usually the active camera
+     *
+     * Cells inside the load radius are read and decompressed by a worker thread into a registry
+     * of their own, the main thread moves their components into the scene in \c Update() .
+     * Cells further than the unload radius are unloaded, the gap between both radii keeps
+     * a cell on the edge from being loaded and unloaded every frame.
+     *
+     * Entities keep the ID they have in the world and entities created while streaming get
+     * higher ones. World entities whose ID is taken by an entity of the scene aren't loaded,
+     * an error is logged. An entity that walked into another loaded cell is handed to it,
+     * otherwise it's unloaded with its cell and comes back with it.
+     *
+     * Cells are read only, the streamed entities that changed (according to the change
+     * tracking of the registry) or were destroyed are kept in an overlay when their cell is
+     * unloaded or the scene is saved (see \c CollectChanges() ). The overlay replaces them
+     * when their cell is loaded again and it's written next to the world by \c SaveOverlay() ,
+     * an entity comes back with the cell it was saved in, not with the cell it walked into.
+     * Loading and unloading cells isn't recorded as a change of the scene and the streamed
+     * entities aren't saved with it (see \c IsStreamed() ).
+     *
+     * @note The worker reads the \c ComponentRegistry but never registers types, \c Open()
+     *       registers the engine components on the main thread. The streamer has to be closed
+     *       before the registered component types are cleared (see \c ComponentRegistry::Clear() )
+     */
+    class WorldStreamer {
+        public:
+            WorldStreamer(ECS_Manager& manager, ECS::Registry& registry);
+            ~WorldStreamer();
+
+            WorldStreamer(const WorldStreamer&) = delete;
+            WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+            /**
+             * @brief Maps a world and loads its persistent cell, a previously opened world is closed
+             * @param world Path of the world, it can be inside a mounted archive
+             * @return true if the world was opened
+             */
+            bool Open(const path& world);
+
+            /**
+             * @brief Unloads every cell and stops the worker, the changes that weren't written
+             *        with \c SaveOverlay() are lost
+             */
+            void Close();
+
+            /**
+             * @brief Keeps the changed and destroyed streamed entities in the overlay, call it
+             *        before the scene saves (saving clears the changes recorded by the registry)
+             */
+            void CollectChanges();
+
+            /**
+             * @brief Writes the overlay next to the world (.gkworld.overlay) if it changed
+             *        since it was last written
+             * @return true if the overlay was written or had nothing new
+             */
+            bool SaveOverlay();
+
+            /**
+             * @param loadRadius Cells closer than this are loaded (px)
+             * @param unloadRadius Cells further than this are unloaded, it can't be less than loadRadius
+             */
+            void SetRadius(float loadRadius, float unloadRadius);
+
+            /**
+             * @brief Unloads the far cells, queues the cells around the center (nearest first)
+             *        and adds the cells the worker finished to the scene
+             * @param center Point the cells are streamed around (e.g. the center of the camera)
+             * @param budgetMs Time in milliseconds after which no more cells are added, at least
+             *        one cell is added per call
+             */
+            void Update(Render::Vec2 center, double budgetMs = GKC_WORLD_MERGE_BUDGET_MS);
+
+            /**
+             * @param x Cell column (see \c GetWorldCell() )
+             * @param y Cell row
+             * @return State of the cell, Unloaded if the world has no cell there
+             */
+            [[nodiscard]] Cell_State GetCellState(Sint32 x, Sint32 y) const;
+            /**
+             * @param id Entity's ID
+             * @return true if the entity was loaded from a cell of the world
+             */
+            [[nodiscard]] bool IsStreamed(EntityID id) const { return m_streamed.contains(id); }
+            [[nodiscard]] size_t GetLoadedCellCount() const { return m_loadedCount; }
+            [[nodiscard]] float GetCellSize() const { return m_header.cellSize_; }
+            [[nodiscard]] bool IsOpen() const { return m_data != nullptr; }
+        private:
+            struct Cell {
+                Filesystem::WorldCell entry_;
+                Cell_State state_ = Cell_State::Unloaded;
+                vector<EntityID> entities_;         // Loaded entities that belong to the cell
+            };
+
+            struct CellResult {
+                size_t index_ = 0;
+                unique_ptr<ECS::Registry> registry_;
+                vector<EntityID> entities_;
+                bool loaded_ = false;
+            };
+
+            ECS_Manager& m_manager;
+            ECS::Registry& m_registry;
+            Filesystem::MappedFile m_file;
+            const Uint8* m_data = nullptr;          // The mapped file or the archived world
+            size_t m_size = 0;
+            Filesystem::WorldHeader m_header{};
+            vector<Cell> m_cells;                   // Only changes while the worker is stopped
+            unordered_map<Uint64, size_t> m_cellIndex;
+            vector<size_t> m_active;                // Loading and loaded cells, the persistent ones aren't
+            unordered_set<EntityID> m_streamed;     // Entities of the loaded cells
+            unique_ptr<ECS::Registry> m_overlay;    // Last state of the streamed entities that changed
+            unordered_set<EntityID> m_overlayIDs;   // Entities inside the overlay
+            unordered_set<EntityID> m_destroyed;    // Streamed entities destroyed by the scene
+            path m_overlayPath;
+            bool m_overlayChanged = false;          // Not written since it last changed
+            size_t m_loadedCount = 0;
+            float m_loadRadius = Filesystem::GKC_WORLD_CELL_SIZE;
+            float m_unloadRadius = Filesystem::GKC_WORLD_CELL_SIZE * 1.5f;
+
+            std::thread m_worker;
+            std::deque<size_t> m_requests;
+            std::deque<CellResult> m_results;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            bool m_stop = false;
+
+            void WorkerLoop();
+            CellResult LoadCell(size_t index) const;
+            void AddCell(CellResult& result);
+            void UnloadCell(Cell& cell);
+            void LoadOverlay();
+            void KeepEntity(EntityID id);
+            void KeepDestroyedEntity(EntityID id);
+            [[nodiscard]] bool HasChanges(EntityID id) const;
+            [[nodiscard]] Cell* FindLoadedCell(EntityID id);
+            [[nodiscard]] float GetDistance(const Filesystem::WorldCell& cell, Render::Vec2 point) const;
+    };
+}
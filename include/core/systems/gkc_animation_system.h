@@ -0,0 +1,74 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+#pragma once
+#include <pch.hpp>
+#include <core/systems/gkc_system.h>
+
+namespace Galaktic::ECS {
+    class Registry;
+    struct AnimationComponent;
+}
+
+namespace Galaktic::Render {
+    class Animation;
+}
+
+namespace Galaktic::Core::Systems {
+    /**
+     * @class AnimationSystem
+     *
+     * Advances the playback state stored in every \c AnimationComponent, only the
+     * animation pool of the registry is walked, so entities without animations are never
+     * touched. Paused entities and entities hidden by their \c VisibilityComponent are skipped.
+     *
+     * The playing entities are first gathered into dense arrays (elapsed time, speed and
+     * delay of the current frame), the time step is then applied in a single flat loop and
+     * only the entities that reached the end of their frame are advanced one by one.
+     */
+    class AnimationSystem final : public BaseSystem {
+        public:
+            /**
+             * @param registry Registry that owns the animation components
+             */
+            explicit AnimationSystem(ECS::Registry& registry) : m_registry(registry) {}
+
+            /**
+             * Advances the animations of all visible and playing entities
+             * @param dt Delta time
+             */
+            void Update(float dt) override;
+        private:
+            ECS::Registry& m_registry;
+
+            // Scratch arrays, reused every update to avoid allocations
+            vector<ECS::AnimationComponent*> m_components;
+            vector<const Render::Animation*> m_animations;
+            vector<float> m_elapsed;
+            vector<float> m_speeds;
+            vector<float> m_delays;
+            unordered_map<AnimationID, shared_ptr<Render::Animation>> m_animationCache;
+
+            void Gather();
+            void Advance(size_t index);
+    };
+}
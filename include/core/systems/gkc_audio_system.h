@@ -0,0 +1,106 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+#include <core/systems/gkc_system.h>
+#include <audio/gkc_audio.h>
+
+namespace Galaktic::ECS {
+    class Registry;
+    struct AudioEmitterComponent;
+}
+
+namespace Galaktic::Core::Systems {
+    inline constexpr Sint64 GKC_AUDIO_EMITTER_FADE_MS = 50;    // Culled emitters fade out to avoid clicks
+    inline constexpr float GKC_AUDIO_MIN_GAIN = 0.001f;        // Quieter emitters are culled
+    inline constexpr float GKC_AUDIO_PARAMETER_EPSILON = 0.005f;
+
+    /**
+     * @class AudioSystem
+     *
+     * Plays the sound of every \c AudioEmitterComponent at its entity's \c TransformComponent,
+     * gain falls off with the distance to the listener (the center of the active camera) and
+     * panning follows the horizontal offset.
+     *
+     * Emitters past their max distance are culled before they take a voice, only the audible
+     * ones play. Looping emitters that lose audibility release their voice with a short fade
+     * and take a new one once they are audible again, one shots are finished instead (they
+     * aren't replayed from the start when the listener comes back). Emitters only steal voices
+     * playing less important sounds, a looping emitter whose voice was stolen takes another one
+     * once a voice is free, a stolen one shot is finished. Gain and panning changes of all
+     * emitters are sent to the mixer in a single batch per update.
+     */
+    class AudioSystem final : public BaseSystem {
+        public:
+            /**
+             * @param registry Registry that owns the emitter components
+             */
+            explicit AudioSystem(ECS::Registry& registry) : m_registry(registry) {}
+            ~AudioSystem() override;
+
+            /**
+             * @param position World position the emitters are heard from
+             */
+            void SetListener(const Render::Vec2& position) { m_listener = position; }
+
+            /**
+             * Starts, updates and culls the voices of the emitters
+             * @param dt Delta time
+             */
+            void Update(float dt) override;
+        private:
+            struct EmitterState {
+                Audio::VoiceID voice_;
+                float gain_;
+                float pan_;
+                Uint64 frame_;              // Last update the emitter was audible
+            };
+
+            struct PendingEmitter {
+                EntityID id_;
+                const ECS::AudioEmitterComponent* emitter_;
+                float gain_;
+                float pan_;
+            };
+
+            ECS::Registry& m_registry;
+            Render::Vec2 m_listener{0.f, 0.f};
+            Uint64 m_frame = 0;
+            unordered_map<EntityID, EmitterState> m_emitters;
+
+            // Scratch arrays, reused every update to avoid allocations
+            vector<PendingEmitter> m_pending;
+            vector<Audio::VoiceParameters> m_parameters;
+
+            /**
+             * @brief Computes gain and panning of an emitter
+             * @param offset Emitter position relative to the listener
+             * @return false if the emitter can't be heard
+             */
+            static bool Attenuate(const ECS::AudioEmitterComponent& emitter, const Render::Vec2& offset,
+                float& gain, float& pan);
+            void StartPending();
+            void FinishOneShot(EntityID id, ECS::AudioEmitterComponent& emitter);
+    };
+}
@@ -76,4 +76,4 @@ namespace Galaktic::Core::Systems {
     typedef unordered_map<string, shared_ptr<BaseSystem>> System_List;
 }
 
-constexpr int GKC_SYSTEMS_COUNTER = 8;
\ No newline at end of file
+constexpr int GKC_SYSTEMS_COUNTER = 10;
\ No newline at end of file
@@ -40,6 +40,10 @@ namespace Galaktic::ECS {
      * from an entity as well as define automatically the write/read behaviour IF the component
      * is not a POD struct (Plain Old Data)
      *
+     * The scene saver and the world streamer read the registered types from their own threads,
+     * every access is guarded by a shared mutex. Types are only registered the first time
+     * and never removed while a scene is running (only \c Clear() removes them, once the
+     * saver and the streamer are stopped), so the returned \c ComponentTypeInfo stay valid.
      */
     class ComponentRegistry {
         public:
@@ -59,27 +63,53 @@ namespace Galaktic::ECS {
             static void RegisterComponent(EntityID id, bool isTag = false) {
                 const type_index typeIndex(typeid(Component));
                 constexpr bool isPOD = std::is_trivially_copyable_v<Component>;
+                const std::string_view name = ComponentName<Component>.empty()
+                    ? std::string_view(typeid(Component).name()) : ComponentName<Component>;
+                // Adding a component registers its type, only the first one writes
+                if (IsRegistered(typeIndex))
+                    return;
 
                 if constexpr (IsTag<Component>) {
                     ComponentTypeInfo info(
                         typeIndex,
+                        name,
                         0,
                         id,
                         true,
                         false,
                         [](const any&) -> size_t { return 0ull; },
-                        [](const any&, ofstream&) {},
-                        [](any&, ifstream&) {}
+                        [](const any&, Filesystem::ByteBuffer&) {},
+                        [](any& a, Filesystem::ByteReader&) { a.emplace<Component>(); return true; },
+                        [](const Uint8*, size_t, const EntityID* ids, Uint32 count,
+                           unordered_map<EntityID, any>& pool, std::span<const Filesystem::SceneField>) {
+                            for (Uint32 i = 0; i < count; ++i)
+                                pool[ids[i]].emplace<Component>();
+                            return true;
+                        },
+                        {}
                     );
 
+                    std::unique_lock lock(m_mutex);
                     m_compTypes.emplace(typeIndex, std::move(info));
                     return;
                 }
 
+                constexpr bool isReflected = !ComponentFields<Component>.empty();
+                static_assert(!isReflected || isPOD, "Only trivially copyable components can have reflected fields");
+                static_assert(AreFieldIDsUnique(ComponentFields<Component>), "Two fields share the same ID");
+
                 size_t sizeValue = 0;
                 size_t (*sizeFn)(const any&) = nullptr;
 
-                if constexpr (IsNonPOD<Component>) {
+                if constexpr (isReflected) {
+                    sizeValue = sizeof(Component);
+                    sizeFn = [](const any&) -> size_t {
+                        size_t size = 0;
+                        for (const ComponentField& field : ComponentFields<Component>)
+                            size += field.size_;
+                        return size;
+                    };
+                } else if constexpr (IsNonPOD<Component>) {
                     sizeFn = [](const any& a) -> size_t {
                         const Component& c = std::any_cast<const Component&>(a);
                         return Component::Size(c);
@@ -91,23 +121,60 @@ namespace Galaktic::ECS {
                     };
                 }
 
-                auto serializeFn = [](const any& a, ofstream& file) {
+                auto serializeFn = [](const any& a, Filesystem::ByteBuffer& buffer) {
                     const Component& c = std::any_cast<const Component&>(a);
-                    if constexpr (isPOD) {
-                        file.write(GKC_WRITE_BINARY(c), sizeof(Component));
+                    if constexpr (isReflected) {
+                        // Field by field, the padding between them isn't written
+                        const auto* bytes = reinterpret_cast<const Uint8*>(&c);
+                        for (const ComponentField& field : ComponentFields<Component>)
+                            buffer.Append(bytes + field.offset_, field.size_);
+                    } else if constexpr (isPOD) {
+                        buffer.Append(&c, sizeof(Component));
                     } else {
-                        Component::Write(file, c);
+                        Component::Write(buffer, c);
                     }
                 };
 
-                auto deserializeFn = [](any& a, ifstream& file) {
+                auto deserializeFn = [](any& a, Filesystem::ByteReader& reader) {
                     Component c{};
+                    bool read = false;
                     if constexpr (isPOD) {
-                        file.read(GKC_READ_BINARY(c), sizeof(Component));
+                        read = reader.Read(&c, sizeof(Component));
                     } else {
-                        Component::Read(file, c);
+                        read = Component::Read(reader, c);
                     }
                     a = std::move(c);
+                    return read;
+                };
+
+                // POD columns are a packed array, the components are copied straight from it
+                auto readColumnFn = [](const Uint8* data, size_t size, const EntityID* ids, Uint32 count,
+                                       unordered_map<EntityID, any>& pool,
+                                       std::span<const Filesystem::SceneField> fields) {
+                    if constexpr (isReflected) {
+                        if (!fields.empty())
+                            return ReadFieldColumn<Component>(data, size, ids, count, pool, fields);
+                    } else if (!fields.empty()) {
+                        return false;
+                    }
+
+                    if constexpr (isPOD) {
+                        if (size != static_cast<size_t>(count) * sizeof(Component))
+                            return false;
+                        for (Uint32 i = 0; i < count; ++i) {
+                            auto& c = pool[ids[i]].emplace<Component>();
+                            std::memcpy(&c, data + static_cast<size_t>(i) * sizeof(Component), sizeof(Component));
+                        }
+                    } else {
+                        Filesystem::ByteReader reader(data, size);
+                        for (Uint32 i = 0; i < count; ++i) {
+                            Component c{};
+                            if (!Component::Read(reader, c))
+                                return false;
+                            pool[ids[i]] = std::move(c);
+                        }
+                    }
+                    return true;
                 };
 
                 GKC_ASSERT(std::is_trivially_copyable_v<Component> ||
@@ -116,51 +183,148 @@ namespace Galaktic::ECS {
 
                 ComponentTypeInfo info(
                     typeIndex,
+                    name,
                     sizeValue,
                     id,
                     isTag,
                     isPOD,
                     sizeFn,
                     serializeFn,
-                    deserializeFn
+                    deserializeFn,
+                    readColumnFn,
+                    ComponentFields<Component>
                 );
 
+                std::unique_lock lock(m_mutex);
                 m_compTypes.emplace(typeIndex, info);
             }
 
+            /**
+             * @brief Registers every component of the engine, scenes can be read before
+             *        any entity used them. Only the first call after \c Clear() registers,
+             *        the next ones don't write
+             */
+            static void RegisterEngineComponents();
+
+            /**
+             * @param name Name stored in the scene file (\c ComponentTypeInfo::m_name )
+             * @return Registered type with that name, nullptr if there's none
+             */
+            static const ComponentTypeInfo* FindByName(std::string_view name) {
+                std::shared_lock lock(m_mutex);
+                for (const auto& [type, info] : m_compTypes) {
+                    if (info.m_name == name)
+                        return &info;
+                }
+                return nullptr;
+            }
+
+            /**
+             * @param type Type of the component, it has to be registered (see \c IsRegistered() )
+             */
             static const ComponentTypeInfo& Get(const type_index& type) {
-                return m_compTypes.find(type)->second;
+                std::shared_lock lock(m_mutex);
+                auto it = m_compTypes.find(type);
+                GKC_RELEASE_ASSERT(it != m_compTypes.end(), "Component type is not registered");
+                return it->second;
             }
 
             static void RegisterComponentByType(const type_index& type, EntityID id, bool isTag) {
-                auto it = m_compTypes.find(type);
-                if (it == m_compTypes.end())
+                if (!IsRegistered(type))
                     GKC_RELEASE_ASSERT(false, "Attempted to deserialize unregistered component type");
             }
-            
+
+            /**
+             * @warning The \c ComponentTypeInfo of the type is destroyed, it can't be called
+             *          while the scene saver or the world streamer are running
+             */
             static void UnregisterComponentByType(const type_index& type) {
-                if(m_compTypes.contains(type)) {
-                    m_compTypes.erase(type);
-                }
+                std::unique_lock lock(m_mutex);
+                m_compTypes.erase(type);
             }
 
             static bool IsRegistered(const type_index& type) {
+                std::shared_lock lock(m_mutex);
                 return m_compTypes.contains(type);
             }
 
             /**
              * @brief Clears all registered component types
-             * @note Useful for cleanup between scenes
+             * @note Useful for cleanup between scenes, the scene saver and the world streamer
+             *       have to be stopped first
              */
             static void Clear() {
+                std::unique_lock lock(m_mutex);
                 m_compTypes.clear();
+                m_engineRegistered = false;
             }
 
-            static unordered_map<type_index, ComponentTypeInfo>& GetComponentTypes() {
-                return m_compTypes;
+            /**
+             * @brief Calls a function for every type registered when it's called, the function
+             *        runs without the lock so it can use the registry
+             * @param func Function to call
+             */
+            static void ForEachComponentType(const std::function<void(const ComponentTypeInfo&)>& func) {
+                vector<const ComponentTypeInfo*> types;
+                {
+                    std::shared_lock lock(m_mutex);
+                    types.reserve(m_compTypes.size());
+                    for (const auto& [type, info] : m_compTypes)
+                        types.push_back(&info);
+                }
+                for (const ComponentTypeInfo* info : types)
+                    func(*info);
             }
         private:
+            /**
+             * @brief Reads a column stored field by field, the stored fields are matched with
+             *        the current ones once and then every component is copied field by field.
+             *        Removed fields are skipped, added fields (or fields that changed size) keep
+             *        the value the default constructor gives them
+             */
+            template<typename Component>
+            static bool ReadFieldColumn(const Uint8* data, size_t size, const EntityID* ids, Uint32 count,
+                                        unordered_map<EntityID, any>& pool,
+                                        std::span<const Filesystem::SceneField> stored) {
+                struct FieldCopy {
+                    size_t from_;       // Offset inside the stored component
+                    Uint32 to_;         // Offset inside the component
+                    Uint16 size_;
+                };
+                constexpr auto& fields = ComponentFields<Component>;
+                array<FieldCopy, fields.size()> copies{};
+                size_t copyCount = 0;
+                size_t stride = 0;
+
+                for (const Filesystem::SceneField& storedField : stored) {
+                    if (storedField.size_ == 0)
+                        return false;
+                    for (const ComponentField& field : fields) {
+                        if (field.id_ != storedField.id_ || field.size_ != storedField.size_)
+                            continue;
+                        if (copyCount == copies.size())
+                            return false;
+                        copies[copyCount++] = { stride, field.offset_, field.size_ };
+                        break;
+                    }
+                    stride += storedField.size_;
+                }
+                if (size != static_cast<size_t>(count) * stride)
+                    return false;
+
+                for (Uint32 i = 0; i < count; ++i) {
+                    auto& c = pool[ids[i]].emplace<Component>();
+                    auto* bytes = reinterpret_cast<Uint8*>(&c);
+                    const Uint8* element = data + static_cast<size_t>(i) * stride;
+                    for (size_t j = 0; j < copyCount; ++j)
+                        std::memcpy(bytes + copies[j].to_, element + copies[j].from_, copies[j].size_);
+                }
+                return true;
+            }
+
             static unordered_map<type_index, ComponentTypeInfo> m_compTypes;
+            static std::shared_mutex m_mutex;
+            static std::atomic<bool> m_engineRegistered;
     };
 }
 
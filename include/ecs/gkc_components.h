@@ -25,6 +25,8 @@
 #include <pch.hpp>
 #include "core/gkc_exception.h"
 #include "core/gkc_logger.h"
+#include "filesys/gkc_byte_buffer.h"
+#include "filesys/gkc_scene_format.h"
 
 namespace Galaktic::ECS {
     struct TransformComponent {
@@ -118,19 +120,12 @@ namespace Galaktic::ECS {
         NameComponent(const string& name) : m_name(name) {}
         string m_name = "";
 
-        static void Write(ofstream& file, const NameComponent& comp) {
-            GKC_ENSURE_FILE_OPEN(file, Debug::WritingException);
-            auto len = static_cast<Uint32>(comp.m_name.size());
-            file.write(GKC_WRITE_BINARY(len), sizeof(len));
-            file.write(comp.m_name.data(), len);
+        static void Write(Filesystem::ByteBuffer& buffer, const NameComponent& comp) {
+            buffer.WriteString(comp.m_name);
         }
 
-        static void Read(ifstream& file, NameComponent& comp) {
-            GKC_ENSURE_FILE_OPEN(file, Debug::ReadingException);
-            Uint32 len;
-            file.read(GKC_READ_BINARY(len), sizeof(len));
-            comp.m_name.resize(len);
-            file.read(comp.m_name.data(), len);
+        static bool Read(Filesystem::ByteReader& reader, NameComponent& comp) {
+            return reader.ReadString(comp.m_name);
         }
 
         static size_t Size(const NameComponent& comp) {
@@ -184,10 +179,25 @@ namespace Galaktic::ECS {
         ScriptID m_id = 0;
     };
 
+    /**
+     * @brief Animation used by the entity and its own playback state, entities sharing
+     *        an animation are animated independently by the \c AnimationSystem
+     */
     struct AnimationComponent {
         AnimationComponent() {}
         AnimationComponent(AnimationID id) : m_id(id) {}
+        AnimationComponent(AnimationID id, bool looping, float speed)
+            : m_id(id), m_speed(speed), m_isLooping(looping) {
+            // Animations can't play backwards, a negative speed falls back to the normal one
+            if(m_speed < 0.f) m_speed = 1.f;
+        }
+
         AnimationID m_id = 0;
+        Uint32 m_frame = 0;
+        float m_elapsed = 0.f;      // Seconds spent on the current frame
+        float m_speed = 1.f;        // Playback speed multiplier
+        bool m_isPlaying = true;
+        bool m_isLooping = true;
     };
 
     struct VisibilityComponent {
@@ -196,6 +206,28 @@ namespace Galaktic::ECS {
         bool m_visible = true;
     };
 
+    /**
+     * @brief Sound played at the entity's \c TransformComponent, the \c AudioSystem sets its
+     *        gain and panning from the distance to the active camera
+     */
+    struct AudioEmitterComponent {
+        AudioEmitterComponent() {}
+        AudioEmitterComponent(AudioID id, float maxDistance, bool looping)
+            : m_id(id), m_maxDistance(maxDistance), m_isLooping(looping) {
+            // Ensure the distances are positive and ordered
+            if(m_maxDistance <= 0.f) m_maxDistance = 640.f;
+            if(m_minDistance > m_maxDistance) m_minDistance = m_maxDistance;
+        }
+
+        AudioID m_id = 0;
+        float m_volume = 1.f;
+        float m_minDistance = 64.f;     // Full volume inside this distance (px)
+        float m_maxDistance = 640.f;    // Silent and without a voice past this distance (px)
+        int m_priority = 0;
+        bool m_isPlaying = true;
+        bool m_isLooping = true;        // Non looping emitters stop playing once the sound ends or is cut
+    };
+
     struct PhysicsObjectTag {};
     struct StaticObjectTag {};
     struct LightTag {};
@@ -203,17 +235,62 @@ namespace Galaktic::ECS {
     struct EnemyTag {};
     struct CameraTag {};
 
+    /**
+     * @struct ComponentField
+     * @brief Field of a component that is saved, declared with \c GKC_FIELD in \c ComponentFields
+     */
+    struct ComponentField {
+        Uint16 id_;                 // Stored in scene files, never reuse the ID of a removed field
+        Uint16 size_;
+        Uint32 offset_;             // Offset inside the component
+    };
+
+    template<typename T>
+    consteval Uint16 GetFieldSize() {
+        static_assert(std::is_trivially_copyable_v<T>, "Reflected fields are copied byte by byte");
+        static_assert(sizeof(T) <= 0xFFFF, "Reflected fields are too big");
+        return static_cast<Uint16>(sizeof(T));
+    }
+
+    /**
+     * @brief Checks that every field has its own ID, IDs are what match stored fields with the
+     *        current ones
+     */
+    template<size_t N>
+    consteval bool AreFieldIDsUnique(const array<ComponentField, N>& fields) {
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = i + 1; j < N; ++j) {
+                if (fields[i].id_ == fields[j].id_)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads a whole column of a .gkscene into a component pool
+     * @param fields Fields the components were stored with, empty if they are stored as a
+     *        whole (POD and non-POD columns)
+     * @return false if the column data is malformed
+     */
+    typedef bool (*ComponentColumnReader)(const Uint8* data, size_t size, const EntityID* ids,
+        Uint32 count, unordered_map<EntityID, any>& pool, std::span<const Filesystem::SceneField> fields);
+
     struct ComponentTypeInfo {
         ComponentTypeInfo(type_index type,
+            std::string_view name,
             size_t size,
             EntityID parentID,
             bool isTag,
             bool isPOD,
             size_t (*sizeFn)(const any&),
-            void (*serializeFn)(const any&, ofstream&),
-            void (*deserializeFn)(any&, ifstream&)
+            void (*serializeFn)(const any&, Filesystem::ByteBuffer&),
+            bool (*deserializeFn)(any&, Filesystem::ByteReader&),
+            ComponentColumnReader readColumnFn,
+            std::span<const ComponentField> fields
         )
             : m_type(type)
+            , m_name(name)
             , m_size(size)
             , m_parentID(parentID)
             , m_isTag(isTag)
@@ -221,9 +298,54 @@ namespace Galaktic::ECS {
             , m_sizeFunc(sizeFn)
             , m_serialize(serializeFn)
             , m_deserialize(deserializeFn)
+            , m_readColumn(readColumnFn)
+            , m_fields(fields)
         {}
+
+        [[nodiscard]] bool IsReflected() const { return !m_fields.empty(); }
+
+        /**
+         * @return Flags of the columns this component is written to
+         */
+        [[nodiscard]] Uint32 GetColumnFlags() const {
+            if (m_isTag)
+                return Filesystem::SCENE_COLUMN_TAG;
+            if (IsReflected())
+                return Filesystem::SCENE_COLUMN_FIELDS;
+            return m_isPOD ? Filesystem::SCENE_COLUMN_POD : Filesystem::SCENE_COLUMN_NONE;
+        }
+
+        /**
+         * @return Size of a component inside a column, 0 if every component has its own size
+         */
+        [[nodiscard]] Uint32 GetElementSize() const {
+            if (IsReflected()) {
+                Uint32 size = 0;
+                for (const ComponentField& field : m_fields)
+                    size += field.size_;
+                return size;
+            }
+            return m_isPOD && !m_isTag ? static_cast<Uint32>(m_size) : 0;
+        }
+
+        /**
+         * @brief Checks if a stored column can be read into this component, reflected components
+         *        read any field column and the raw columns saved before they were reflected
+         * @param flags Scene_Column_Flags of the column
+         * @param elementSize Size of a component inside the column
+         */
+        [[nodiscard]] bool CanReadColumn(Uint32 flags, Uint32 elementSize) const {
+            const bool isTag = (flags & Filesystem::SCENE_COLUMN_TAG) != 0;
+            const bool isPOD = (flags & Filesystem::SCENE_COLUMN_POD) != 0;
+            if (isTag != m_isTag)
+                return false;
+            if ((flags & Filesystem::SCENE_COLUMN_FIELDS) != 0)
+                return IsReflected();
+            return isPOD == m_isPOD && (!isPOD || elementSize == m_size);
+        }
         
         type_index m_type;
+        std::string_view m_name;    // Stable name stored in scene files
         size_t m_size;
         EntityID m_parentID;
         bool m_isTag;
@@ -231,7 +353,9 @@ namespace Galaktic::ECS {
 
         // Modifiable Lambdas for writing/reading/size
         size_t (*m_sizeFunc)(const std::any&);
-        void (*m_serialize)(const std::any&, ofstream&);
-        void (*m_deserialize)(std::any&, ifstream&);
+        void (*m_serialize)(const std::any&, Filesystem::ByteBuffer&);
+        bool (*m_deserialize)(std::any&, Filesystem::ByteReader&);
+        ComponentColumnReader m_readColumn;
+        std::span<const ComponentField> m_fields;   // Empty if the component isn't reflected
     };
 }
\ No newline at end of file
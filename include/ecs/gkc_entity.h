@@ -62,6 +62,11 @@ namespace Galaktic::ECS {
                 return m_registry->Get<T>(m_ID);
             }
 
+            template<typename T>
+            const T& Read() const {
+                return m_registry->Read<T>(m_ID);
+            }
+
             template<typename T>
             [[nodiscard]] bool Has() const {
                 return m_registry->Has<T>(m_ID);
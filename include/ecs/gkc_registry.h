@@ -30,9 +30,22 @@ namespace Galaktic::Core {
 }
 
 namespace Galaktic::ECS {
+    /**
+     * @struct ComponentChanges
+     * @brief Entities whose component of one type changed or was removed since the last save
+     */
+    struct ComponentChanges {
+        unordered_set<EntityID> changed_;
+        unordered_set<EntityID> removed_;
+    };
+
     /**
      * @class Registry
      * @brief Intermediary class between the ECS Manager and the Scene
+     *
+     * When change tracking is enabled every component that is added, removed or accessed
+     * with \c Get() is recorded, incremental saves only write those. Use \c Read() to access
+     * a component without marking it as changed.
      */
     class Registry {
         public:
@@ -46,6 +59,7 @@ namespace Galaktic::ECS {
              */
             template<typename T, typename... Args>
             T& Add(EntityID id, Args&&... args) {
+                MarkChanged(typeid(T), id);
                 auto& any = m_componentPools[typeid(T)][id];
                 any.emplace<T>(std::forward<Args>(args)...);
                 return std::any_cast<T&>(any);
@@ -53,24 +67,41 @@ namespace Galaktic::ECS {
 
             template<typename T>
             T& Add(EntityID id) {
+                MarkChanged(typeid(T), id);
                 auto& any = m_componentPools[typeid(T)][id];
                 any.emplace<T>();
                 return std::any_cast<T&>(any);
             }
 
             /**
-             * @brief Get a component from the specified entity
+             * @brief Get a component from the specified entity, the component is marked
+             *        as changed, use \c Read() if it's not modified
              * @tparam T Component Type
              * @param id Entity ID
              * @return The component from the entity
              */
             template<typename T>
             T& Get(EntityID id) {
+                MarkChanged(typeid(T), id);
                 return std::any_cast<T&>(
                     m_componentPools[typeid(T)][id]
                 );
             }
 
+            /**
+             * @brief Get a read only component from the specified entity
+             * @tparam T Component Type
+             * @param id Entity ID
+             * @return The component from the entity
+             * @throws std::out_of_range if the entity doesn't have the component
+             */
+            template<typename T>
+            const T& Read(EntityID id) const {
+                return std::any_cast<const T&>(
+                    m_componentPools.at(typeid(T)).at(id)
+                );
+            }
+
             /**
              * @brief Checks if the entity by ID has a specific component
              * @tparam T Component Type
@@ -101,7 +132,21 @@ namespace Galaktic::ECS {
              */
             template<typename T>
             void Remove(EntityID id) {
-                m_componentPools[typeid(T)].erase(id);
+                if (m_componentPools[typeid(T)].erase(id) > 0)
+                    MarkRemoved(typeid(T), id);
+            }
+
+            /**
+             * @brief Gets the pool of a component type
+             * @tparam T Component Type
+             * @return Pointer to the pool, nullptr if no entity has ever had the component
+             */
+            template<typename T>
+            unordered_map<EntityID, any>* GetPool() {
+                auto it = m_componentPools.find(typeid(T));
+                if (it == m_componentPools.end())
+                    return nullptr;
+                return &it->second;
             }
 
             unordered_map<type_index,unordered_map<EntityID, any>>& GetComponentPools() {
@@ -141,9 +186,7 @@ namespace Galaktic::ECS {
             }
             
             void ForEachRegisteredComponent(const std::function<void(const ComponentTypeInfo&)>& fn) const {
-                for (const auto& [type, info] : ComponentRegistry::GetComponentTypes()) {
-                    fn(info);
-                }
+                ComponentRegistry::ForEachComponentType(fn);
             }
 
             size_t GetAllComponentsSize(EntityID id) {
@@ -165,7 +208,131 @@ namespace Galaktic::ECS {
             bool IsComponentType(const type_index& type) {
                 return type == type_index(typeid(T));
             }
+
+            // Change Tracking
+
+            /**
+             * @brief Enables or disables change tracking, the recorded changes are cleared
+             */
+            void SetChangeTracking(bool enabled) {
+                m_trackChanges = enabled;
+                ClearChanges();
+            }
+            [[nodiscard]] bool IsTrackingChanges() const { return m_trackChanges; }
+
+            /**
+             * @brief Marks a component as changed, used when a component is modified
+             *        through its pool (e.g. \c GetPool() )
+             */
+            template<typename T>
+            void MarkChanged(EntityID id) {
+                MarkChanged(typeid(T), id);
+            }
+
+            void MarkChanged(const type_index& type, EntityID id) {
+                if (!m_trackChanges)
+                    return;
+                auto& changes = m_componentChanges[type];
+                changes.changed_.insert(id);
+                changes.removed_.erase(id);
+            }
+
+            void MarkRemoved(const type_index& type, EntityID id) {
+                if (!m_trackChanges)
+                    return;
+                auto& changes = m_componentChanges[type];
+                changes.changed_.erase(id);
+                changes.removed_.insert(id);
+            }
+
+            void MarkEntityCreated(EntityID id) {
+                if (m_trackChanges)
+                    m_createdEntities.insert(id);
+            }
+
+            /**
+             * @brief Records that the entity was destroyed, its component changes are dropped
+             *        since loading the destroyed entity already removes its components
+             */
+            void MarkEntityDestroyed(EntityID id) {
+                if (!m_trackChanges)
+                    return;
+                m_createdEntities.erase(id);
+                m_destroyedEntities.insert(id);
+                for (auto& [type, changes] : m_componentChanges) {
+                    changes.changed_.erase(id);
+                    changes.removed_.erase(id);
+                }
+            }
+
+            /**
+             * @brief Drops what was recorded about the entity without recording it as destroyed,
+             *        used when an entity is unloaded but still exists in its file (see \c WorldStreamer )
+             */
+            void ForgetEntity(EntityID id) {
+                m_createdEntities.erase(id);
+                for (auto& [type, changes] : m_componentChanges) {
+                    changes.changed_.erase(id);
+                    changes.removed_.erase(id);
+                }
+            }
+
+            [[nodiscard]] bool HasChanges() const {
+                if (!m_createdEntities.empty() || !m_destroyedEntities.empty())
+                    return true;
+                for (const auto& [type, changes] : m_componentChanges) {
+                    if (!changes.changed_.empty() || !changes.removed_.empty())
+                        return true;
+                }
+                return false;
+            }
+
+            void ClearChanges() {
+                m_componentChanges.clear();
+                m_createdEntities.clear();
+                m_destroyedEntities.clear();
+            }
+
+            /**
+             * @brief Copies the components and the recorded changes into another registry, the
+             *        copy can be serialized in another thread while this registry keeps changing
+             * @param target Registry to copy to, its previous content is replaced
+             * @param changesOnly Only the changed components are copied (enough for an incremental save)
+             */
+            void CopyTo(Registry& target, bool changesOnly) const {
+                target.m_componentChanges = m_componentChanges;
+                target.m_createdEntities = m_createdEntities;
+                target.m_destroyedEntities = m_destroyedEntities;
+                target.m_trackChanges = false;
+                if (!changesOnly) {
+                    target.m_componentPools = m_componentPools;
+                    return;
+                }
+
+                target.m_componentPools.clear();
+                for (const auto& [type, changes] : m_componentChanges) {
+                    auto pool = m_componentPools.find(type);
+                    if (pool == m_componentPools.end())
+                        continue;
+
+                    auto& copy = target.m_componentPools[type];
+                    copy.reserve(changes.changed_.size());
+                    for (EntityID id : changes.changed_) {
+                        auto it = pool->second.find(id);
+                        if (it != pool->second.end())
+                            copy.emplace(id, it->second);
+                    }
+                }
+            }
+
+            const unordered_map<type_index, ComponentChanges>& GetComponentChanges() const { return m_componentChanges; }
+            const unordered_set<EntityID>& GetCreatedEntities() const { return m_createdEntities; }
+            const unordered_set<EntityID>& GetDestroyedEntities() const { return m_destroyedEntities; }
         private:
             unordered_map<type_index,unordered_map<EntityID, any>> m_componentPools;
+            unordered_map<type_index, ComponentChanges> m_componentChanges;
+            unordered_set<EntityID> m_createdEntities;
+            unordered_set<EntityID> m_destroyedEntities;
+            bool m_trackChanges = false;
     };
 }
\ No newline at end of file
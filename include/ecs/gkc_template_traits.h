@@ -39,4 +39,117 @@ namespace Galaktic::ECS {
     inline constexpr bool IsNonPOD = false;
     template<> inline constexpr bool IsNonPOD<ECS::NameComponent> = true;
 
+    /**
+     * @brief Name of the component stored in scene files, it has to stay the same between
+     *        versions of the engine. Components without a name use the compiler's type name
+     *        which is only stable for the same build
+     */
+    template<typename C>
+    inline constexpr std::string_view ComponentName = {};
+    template<> inline constexpr std::string_view ComponentName<ECS::TransformComponent> = "TransformComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::HealthComponent> = "HealthComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::JumpComponent> = "JumpComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::RigidBody> = "RigidBody";
+    template<> inline constexpr std::string_view ComponentName<ECS::CollisionComponent> = "CollisionComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::SpeedComponent> = "SpeedComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::ColorComponent> = "ColorComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::NameComponent> = "NameComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::LightComponent> = "LightComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::CameraComponent> = "CameraComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::TextureComponent> = "TextureComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::ScriptComponent> = "ScriptComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::AnimationComponent> = "AnimationComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::VisibilityComponent> = "VisibilityComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::AudioEmitterComponent> = "AudioEmitterComponent";
+    template<> inline constexpr std::string_view ComponentName<ECS::PhysicsObjectTag> = "PhysicsObjectTag";
+    template<> inline constexpr std::string_view ComponentName<ECS::StaticObjectTag> = "StaticObjectTag";
+    template<> inline constexpr std::string_view ComponentName<ECS::LightTag> = "LightTag";
+    template<> inline constexpr std::string_view ComponentName<ECS::PlayerTag> = "PlayerTag";
+    template<> inline constexpr std::string_view ComponentName<ECS::EnemyTag> = "EnemyTag";
+    template<> inline constexpr std::string_view ComponentName<ECS::CameraTag> = "CameraTag";
+
+    /**
+     * @brief Declares a saved field of a component, the ID is what identifies the field in
+     *        scene files so renaming or moving the member keeps old saves working
+     */
+    #define GKC_FIELD(Component, ID, Member) \
+        ::Galaktic::ECS::ComponentField{ ID, ::Galaktic::ECS::GetFieldSize<decltype(Component::Member)>(), \
+            static_cast<Uint32>(offsetof(Component, Member)) }
+
+    /**
+     * @brief Fields saved of a component, components with fields are stored field by field so
+     *        fields can be added (they keep their default when loading older saves) or removed
+     *        without breaking scenes. Components without fields are stored as a whole
+     */
+    template<typename C>
+    inline constexpr auto ComponentFields = array<ComponentField, 0>{};
+    template<> inline constexpr auto ComponentFields<ECS::TransformComponent> = array{
+        GKC_FIELD(TransformComponent, 1, m_location),
+        GKC_FIELD(TransformComponent, 2, m_size),
+        GKC_FIELD(TransformComponent, 3, m_rotation)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::HealthComponent> = array{
+        GKC_FIELD(HealthComponent, 1, m_currentHealth),
+        GKC_FIELD(HealthComponent, 2, m_maxHealth),
+        GKC_FIELD(HealthComponent, 3, m_canTakeDamage)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::JumpComponent> = array{
+        GKC_FIELD(JumpComponent, 1, m_jumpHeight),
+        GKC_FIELD(JumpComponent, 2, m_canJump)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::RigidBody> = array{
+        GKC_FIELD(RigidBody, 1, m_velocity),
+        GKC_FIELD(RigidBody, 2, m_force),
+        GKC_FIELD(RigidBody, 3, m_mass)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::CollisionComponent> = array{
+        GKC_FIELD(CollisionComponent, 1, m_collisionBox),
+        GKC_FIELD(CollisionComponent, 2, m_collidable)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::SpeedComponent> = array{
+        GKC_FIELD(SpeedComponent, 1, m_maxSpeed)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::ColorComponent> = array{
+        GKC_FIELD(ColorComponent, 1, m_color)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::LightComponent> = array{
+        GKC_FIELD(LightComponent, 1, m_location),
+        GKC_FIELD(LightComponent, 2, m_watts),
+        GKC_FIELD(LightComponent, 3, m_radius),
+        GKC_FIELD(LightComponent, 4, m_color)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::CameraComponent> = array{
+        GKC_FIELD(CameraComponent, 1, m_location),
+        GKC_FIELD(CameraComponent, 2, m_entityToFollowID),
+        GKC_FIELD(CameraComponent, 3, m_zoom),
+        GKC_FIELD(CameraComponent, 4, m_smoothing),
+        GKC_FIELD(CameraComponent, 5, m_isActive)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::TextureComponent> = array{
+        GKC_FIELD(TextureComponent, 1, m_id)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::ScriptComponent> = array{
+        GKC_FIELD(ScriptComponent, 1, m_id)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::AnimationComponent> = array{
+        GKC_FIELD(AnimationComponent, 1, m_id),
+        GKC_FIELD(AnimationComponent, 2, m_frame),
+        GKC_FIELD(AnimationComponent, 3, m_elapsed),
+        GKC_FIELD(AnimationComponent, 4, m_speed),
+        GKC_FIELD(AnimationComponent, 5, m_isPlaying),
+        GKC_FIELD(AnimationComponent, 6, m_isLooping)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::VisibilityComponent> = array{
+        GKC_FIELD(VisibilityComponent, 1, m_visible)
+    };
+    template<> inline constexpr auto ComponentFields<ECS::AudioEmitterComponent> = array{
+        GKC_FIELD(AudioEmitterComponent, 1, m_id),
+        GKC_FIELD(AudioEmitterComponent, 2, m_volume),
+        GKC_FIELD(AudioEmitterComponent, 3, m_minDistance),
+        GKC_FIELD(AudioEmitterComponent, 4, m_maxDistance),
+        GKC_FIELD(AudioEmitterComponent, 5, m_priority),
+        GKC_FIELD(AudioEmitterComponent, 6, m_isPlaying),
+        GKC_FIELD(AudioEmitterComponent, 7, m_isLooping)
+    };
+
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Filesystem {
+    inline constexpr Uint32 GKC_VERSION_ARCHIVE = 1;        // Version of the .gkpak layout
+    inline constexpr Uint64 GKC_ARCHIVE_ALIGNMENT = 16;     // Alignment of every file inside the archive
+    inline const string GKC_ARCHIVE_EXTENSION = ".gkpak";
+    inline const vector<path> GKC_ARCHIVE_FOLDERS = { "assets", "scenes", "scripts" };
+
+    /**
+     * @enum Archive_Flags
+     * @brief Flags of a file stored inside an archive
+     */
+    enum Archive_Flags : Uint32 {
+        ARCHIVE_FLAG_NONE = 0,
+        ARCHIVE_FLAG_COMPRESSED = 1 << 0,   // Reserved, the data has to be decompressed to rawSize_ bytes
+    };
+
+    /**
+     * @struct ArchiveHeader
+     * @brief First bytes of a .gkpak file
+     */
+    struct ArchiveHeader {
+        char magic_[4];             // "GKPK"
+        Uint32 version_;
+        Uint32 entryCount_;
+        Uint32 flags_;
+        Uint64 tocOffset_;          // Table of contents, entryCount_ ArchiveEntry sorted by hash
+        Uint64 namesOffset_;        // Names of the files, not null terminated
+    };
+
+    /**
+     * @struct ArchiveEntry
+     * @brief Table of contents entry of a file stored inside an archive
+     */
+    struct ArchiveEntry {
+        Uint64 hash_;               // FNV-1a of the name
+        Uint64 offset_;             // Offset of the data from the start of the archive
+        Uint64 size_;               // Stored size
+        Uint64 rawSize_;            // Size once decompressed (same as size_ if not compressed)
+        Uint32 nameOffset_;         // Offset of the name inside the names block
+        Uint32 nameLength_;
+        Uint32 flags_;              // Archive_Flags
+        Uint32 reserved_;
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 32, "ArchiveHeader layout changed!");
+    static_assert(sizeof(ArchiveEntry) == 48, "ArchiveEntry layout changed!");
+
+    /**
+     * @class MappedFile
+     * @brief Read only memory mapping of a whole file (mmap / CreateFileMapping)
+     */
+    class MappedFile {
+        public:
+            MappedFile() = default;
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * @brief Maps a file, a previously mapped file is unmapped
+             * @param file File path
+             * @return true if the file was mapped
+             */
+            bool Open(const path& file);
+            void Close();
+
+            [[nodiscard]] const Uint8* GetData() const { return m_data; }
+            [[nodiscard]] size_t GetSize() const { return m_size; }
+            [[nodiscard]] bool IsOpen() const { return m_data != nullptr; }
+        private:
+            const Uint8* m_data = nullptr;
+            size_t m_size = 0;
+            #ifdef _WIN32
+                void* m_file = nullptr;
+                void* m_mapping = nullptr;
+            #endif
+    };
+
+    /**
+     * @class Archive
+     * @brief Packed asset archive (.gkpak) read from a memory mapped file
+     *
+     * An archive is a header, the data of every file (aligned to \c GKC_ARCHIVE_ALIGNMENT),
+     * a table of contents sorted by the FNV-1a hash of the file names and a block with the
+     * names. Files are looked up with a binary search over the table and their data is
+     * read straight from the mapping, no file is opened, seeked or copied.
+     *
+     * Names are relative to the folder that was packed with forward slashes
+     * (e.g. assets/textures/player.png).
+     */
+    class Archive {
+        public:
+            /**
+             * @brief Maps and validates an archive
+             * @param file Archive path
+             * @return true if the archive is valid
+             */
+            bool Open(const path& file);
+            void Close();
+
+            /**
+             * @brief Finds a file inside the archive
+             * @param name Name of the file relative to the packed folder
+             * @return Pointer to the entry, nullptr if the file isn't in the archive
+             */
+            [[nodiscard]] const ArchiveEntry* Find(std::string_view name) const;
+
+            [[nodiscard]] const Uint8* GetData(const ArchiveEntry& entry) const;
+            [[nodiscard]] std::string_view GetName(const ArchiveEntry& entry) const;
+            [[nodiscard]] size_t GetEntryCount() const { return m_entryCount; }
+            [[nodiscard]] const ArchiveEntry& GetEntry(size_t index) const { return m_entries[index]; }
+            [[nodiscard]] const path& GetPath() const { return m_path; }
+
+            /**
+             * @brief Packs every file inside the folders of a project into an archive
+             * @param root Project folder, names are stored relative to it
+             * @param folders Folders inside root to pack
+             * @param output Archive path
+             * @return true if the archive was written
+             */
+            static bool Pack(const path& root, const vector<path>& folders, const path& output);
+        private:
+            MappedFile m_file;
+            path m_path;
+            const ArchiveEntry* m_entries = nullptr;
+            const char* m_names = nullptr;
+            size_t m_entryCount = 0;
+    };
+
+    /**
+     * @brief Mounts an archive, its files can then be opened as if they were inside mountPoint.
+     *        Mounted archives are searched before the disk
+     * @param archivePath Archive path
+     * @param mountPoint Folder that was packed (usually the project folder)
+     * @return true if the archive was mounted
+     */
+    extern bool MountArchive(const path& archivePath, const path& mountPoint);
+
+    /**
+     * @brief Mounts every archive found directly inside a folder
+     * @param folder Folder to search (usually the project folder), it's also the mount point
+     */
+    extern void MountArchivesInFolder(const path& folder);
+
+    /**
+     * @brief Unmounts every archive, data previously retrieved from them becomes invalid
+     */
+    extern void UnmountArchives();
+
+    /**
+     * @brief Finds a file inside the mounted archives
+     * @param file File path (as if it was on disk)
+     * @param size Size of the data
+     * @return Pointer to the mapped data, nullptr if no archive contains the file
+     */
+    extern const Uint8* FindArchivedFile(const path& file, size_t& size);
+
+    /**
+     * @brief Finds the mounted archive that contains a file
+     * @param file File path (as if it was on disk)
+     * @return The archive, nullptr if no archive contains the file
+     */
+    extern const Archive* FindFileArchive(const path& file);
+
+    /**
+     * @brief Lists the archived files inside a folder
+     * @param folder Folder path (as if it was on disk)
+     * @return File paths inside the folder and its subfolders
+     */
+    extern vector<string> GetArchivedFilesInFolder(const path& folder);
+
+    /**
+     * @brief Checks if a file exists inside a mounted archive or on disk
+     * @param file File path
+     */
+    extern bool AssetExists(const path& file);
+
+    /**
+     * @brief Opens an asset for reading, archived files are read from the mapping
+     *        (SDL_IOFromConstMem), other files from disk
+     * @param file File path
+     * @return SDL_IOStream that has to be closed by the caller (or by SDL with closeio),
+     *         nullptr if the file couldn't be opened
+     */
+    extern SDL_IOStream* OpenAssetIO(const path& file);
+
+    /**
+     * @brief Gets all the bytes of an asset, archived files aren't copied
+     * @param file File path
+     * @param storage Buffer used to read files from disk, keep it alive while using the bytes
+     * @param size Number of bytes
+     * @return Pointer to the bytes, nullptr if the file couldn't be read
+     */
+    extern const Uint8* ReadAsset(const path& file, vector<Uint8>& storage, size_t& size);
+
+    /**
+     * @class MemoryStreamBuf
+     * @brief Read only stream buffer over a block of memory, the memory isn't copied
+     */
+    class MemoryStreamBuf : public std::streambuf {
+        public:
+            MemoryStreamBuf() = default;
+            MemoryStreamBuf(const Uint8* data, size_t size) { SetData(data, size); }
+
+            void SetData(const Uint8* data, size_t size);
+        protected:
+            pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+            pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+    };
+
+    /**
+     * @class AssetStream
+     * @brief Input stream that reads a file from the mounted archives, or from disk if
+     *        no archive contains it. Can be used anywhere an ifstream was used for reading
+     */
+    class AssetStream : public std::istream {
+        public:
+            explicit AssetStream(const path& file);
+
+            // Same name as ifstream's so GKC_ENSURE_FILE_OPEN works with both
+            [[nodiscard]] bool is_open() const { return m_isOpen; }
+        private:
+            MemoryStreamBuf m_memory;
+            std::filebuf m_file;
+            bool m_isOpen = false;
+    };
+}
@@ -0,0 +1,124 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Filesystem {
+    inline constexpr Uint32 GKC_VERSION_ASSET_INDEX = 2;            // Version of the index file
+    inline constexpr Sint64 GKC_ASSET_INDEX_TIME_SLACK_MS = 2000;   // Coarsest folder time (FAT)
+    inline const string GKC_ASSET_INDEX_FILE = "assets.gkindex";    // File inside the project's cache folder
+    inline const vector<path> GKC_ASSET_INDEX_FOLDERS = { "assets", "scripts" };
+
+    /**
+     * @enum Asset_Type
+     * @brief Kinds of asset the managers load, every kind has its own extensions
+     */
+    enum class Asset_Type : Uint8 {
+        Texture,
+        Animation,
+        Audio,
+        Script,
+        Tilemap
+    };
+
+    /**
+     * @brief Checks the extension of a file, the file itself isn't touched
+     * @param file File path
+     * @param type Kind of asset
+     * @return true if the extension is one of the extensions of the type
+     * @note GIF files are textures and animations, the folder they are in decides
+     */
+    extern bool IsAssetExtension(const path& file, Asset_Type type);
+
+    /**
+     * @class AssetIndex
+     * @brief Index of the files inside the asset folders of a project, kept between runs
+     *
+     * Listing the asset folders with a recursive scan and checking every file again costs
+     * thousands of \c stat calls, which is slow on network drives. The index keeps the names
+     * of the files of every folder along with the modification time of the folder and is
+     * saved in the project's cache folder. A folder only changes its time when a file is
+     * added, removed or renamed inside it, so refreshing the index checks the folders and
+     * lists again only the ones that changed, the files themselves are never checked.
+     * Some filesystems round the folder times, a folder changed right after it was listed
+     * can keep its time, so folders whose time isn't older than the last listing (minus
+     * \c GKC_ASSET_INDEX_TIME_SLACK_MS ) are always listed again.
+     *
+     * Files modified in place keep their entry, their content is checked by whoever reads
+     * them (see \c DecodeCache ). Files inside mounted archives are listed first, the
+     * loose copies of archived files are skipped like \c GetFilenamesInFolder() does.
+     *
+     * Every function is safe to call from the asset loader threads.
+     */
+    class AssetIndex {
+        public:
+            /**
+             * @brief Loads the index of a project and refreshes it, the index is saved
+             *        again if anything changed
+             * @param projectPath Folder of the project, its asset folders are indexed
+             * @param indexFile File the index is kept in, if empty it isn't saved
+             */
+            static void Open(const path& projectPath, const path& indexFile);
+            static void Close();
+            static bool IsOpen() { return !m_projectPath.empty(); }
+
+            /**
+             * @brief Lists again the folders whose modification time changed, new folders are
+             *        added and removed ones are dropped
+             * @return true if anything changed
+             */
+            static bool Refresh();
+
+            /**
+             * @brief Lists the files of a type inside a folder and its subfolders, folders
+             *        outside the index (or any folder before \c Open() ) are scanned
+             * @param folder Folder path
+             * @param type Kind of asset
+             * @return File paths, archived files first
+             */
+            static vector<string> GetFiles(const path& folder, Asset_Type type);
+        private:
+            /**
+             * @struct IndexedFolder
+             * @brief Entries of a folder when it was last listed
+             */
+            struct IndexedFolder {
+                Sint64 time_ = 0;
+                vector<string> files_;
+                vector<string> folders_;
+                bool isVisited_ = false;    // Reached by the current refresh
+            };
+
+            static path m_projectPath;
+            static path m_indexFile;
+            static map<string, IndexedFolder> m_folders;   // By path relative to the project (generic format)
+            static Sint64 m_time;                           // When the folders were last listed (file clock)
+            static std::mutex m_mutex;
+
+            static bool Update();
+            static bool RefreshFolder(const string& folder);
+            static bool Load();
+            static void Save();
+    };
+}
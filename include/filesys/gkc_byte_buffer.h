@@ -0,0 +1,165 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Filesystem {
+    /**
+     * @class ByteBuffer
+     * @brief Growable memory buffer used to serialize data before writing it in one go
+     *
+     * Values are appended at the end, sizes that are only known after writing what follows
+     * them are reserved with \c Reserve() and filled later with \c Patch() . The storage grows
+     * geometrically so serializing a big scene only reallocates a handful of times.
+     */
+    class ByteBuffer {
+        public:
+            ByteBuffer() = default;
+            explicit ByteBuffer(size_t capacity) { m_data.reserve(capacity); }
+
+            void Append(const void* data, size_t bytes) {
+                const auto* begin = static_cast<const Uint8*>(data);
+                m_data.insert(m_data.end(), begin, begin + bytes);
+            }
+
+            template<typename T>
+            void Write(const T& value) {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+                Append(&value, sizeof(T));
+            }
+
+            /**
+             * @brief Writes the length (Uint32) followed by the characters
+             */
+            void WriteString(std::string_view str) {
+                Write(static_cast<Uint32>(str.size()));
+                Append(str.data(), str.size());
+            }
+
+            /**
+             * @brief Leaves room for a value that is written later with \c Patch()
+             * @return Offset of the reserved value
+             */
+            template<typename T>
+            size_t Reserve(size_t count = 1) {
+                size_t offset = m_data.size();
+                m_data.resize(offset + sizeof(T) * count);
+                return offset;
+            }
+
+            /**
+             * @brief Pads the buffer with zeros until its size is a multiple of alignment
+             */
+            void Align(size_t alignment) {
+                m_data.resize((m_data.size() + alignment - 1) / alignment * alignment);
+            }
+
+            template<typename T>
+            void Patch(size_t offset, const T& value) {
+                GKC_ASSERT(offset + sizeof(T) <= m_data.size(), "Patch out of the buffer");
+                std::memcpy(m_data.data() + offset, &value, sizeof(T));
+            }
+
+            /**
+             * @brief Drops everything after size, used to give back the unused part of a reserve
+             */
+            void Truncate(size_t size) {
+                GKC_ASSERT(size <= m_data.size(), "Truncate out of the buffer");
+                m_data.resize(size);
+            }
+
+            void ReserveCapacity(size_t capacity) { m_data.reserve(capacity); }
+            void Clear() { m_data.clear(); }
+
+            [[nodiscard]] Uint8* GetData() { return m_data.data(); }
+            [[nodiscard]] const Uint8* GetData() const { return m_data.data(); }
+            [[nodiscard]] size_t GetSize() const { return m_data.size(); }
+            [[nodiscard]] bool IsEmpty() const { return m_data.empty(); }
+        private:
+            vector<Uint8> m_data;
+    };
+
+    /**
+     * @class ByteReader
+     * @brief Cursor over memory written by a \c ByteBuffer (usually a mapped file)
+     *
+     * Every read is bounds checked, once a read fails the reader stays failed and
+     * the next reads return false, so a whole record can be checked once at the end.
+     */
+    class ByteReader {
+        public:
+            ByteReader(const Uint8* data, size_t size) : m_data(data), m_size(size) {}
+
+            bool Read(void* out, size_t bytes) {
+                const Uint8* current = Skip(bytes);
+                if (current == nullptr)
+                    return false;
+                std::memcpy(out, current, bytes);
+                return true;
+            }
+
+            template<typename T>
+            bool Read(T& value) {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+                return Read(&value, sizeof(T));
+            }
+
+            /**
+             * @brief Reads a string written by \c ByteBuffer::WriteString()
+             */
+            bool ReadString(string& str) {
+                Uint32 length = 0;
+                if (!Read(length))
+                    return false;
+                const Uint8* chars = Skip(length);
+                if (chars == nullptr)
+                    return false;
+                str.assign(reinterpret_cast<const char*>(chars), length);
+                return true;
+            }
+
+            /**
+             * @return Pointer to the skipped bytes, nullptr if there weren't enough bytes left
+             */
+            const Uint8* Skip(size_t bytes) {
+                if (m_failed || bytes > m_size - m_offset) {
+                    m_failed = true;
+                    return nullptr;
+                }
+                const Uint8* current = m_data + m_offset;
+                m_offset += bytes;
+                return current;
+            }
+
+            [[nodiscard]] const Uint8* GetCurrent() const { return m_data + m_offset; }
+            [[nodiscard]] size_t GetOffset() const { return m_offset; }
+            [[nodiscard]] size_t GetRemaining() const { return m_size - m_offset; }
+            [[nodiscard]] bool IsGood() const { return !m_failed; }
+        private:
+            const Uint8* m_data;
+            size_t m_size;
+            size_t m_offset = 0;
+            bool m_failed = false;
+    };
+}
@@ -0,0 +1,71 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+#include <filesys/gkc_byte_buffer.h>
+
+namespace Galaktic::Filesystem {
+    inline constexpr int GKC_ZSTD_LEVEL = 9;        // Zstd is used for small files, LZ4 for fast ones
+
+    /**
+     * @enum Compression_Type
+     * @brief Codecs a block of data can be compressed with, stored in files (don't reorder)
+     */
+    enum class Compression_Type : Uint32 {
+        None = 0,
+        LZ4 = 1,
+        Zstd = 2
+    };
+
+    /**
+     * @brief Checks if the engine was built with the codec (\c GKC_HAS_LZ4 , \c GKC_HAS_ZSTD )
+     * @param type Codec
+     * @return true if blocks can be compressed and decompressed with it
+     */
+    extern bool IsCompressionAvailable(Compression_Type type);
+
+    extern const char* GetCompressionName(Compression_Type type);
+
+    /**
+     * @brief Compresses a block and appends it to the buffer
+     * @param type Codec
+     * @param data Data to compress
+     * @param size Size of the data in bytes
+     * @param output Buffer the compressed block is appended to
+     * @return Size of the compressed block, 0 if the codec isn't available, the compression
+     *         failed or the block didn't get smaller (nothing is appended then)
+     */
+    extern size_t CompressBlock(Compression_Type type, const void* data, size_t size, ByteBuffer& output);
+
+    /**
+     * @brief Decompresses a block compressed by \c CompressBlock()
+     * @param type Codec
+     * @param data Compressed block
+     * @param size Size of the compressed block
+     * @param output Destination, it has to fit rawSize bytes
+     * @param rawSize Size of the block once decompressed
+     * @return true if the block was decompressed to exactly rawSize bytes
+     */
+    extern bool DecompressBlock(Compression_Type type, const Uint8* data, size_t size, Uint8* output, size_t rawSize);
+}
@@ -0,0 +1,86 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Filesystem {
+    inline constexpr Uint64 GKC_FILE_WATCH_DEBOUNCE_MS = 200;  // Quiet time before a change is reported
+    inline constexpr Uint64 GKC_FILE_WATCH_POLL_MS = 500;      // Rescan interval of the polling fallback
+
+    /**
+     * @class FileWatcher
+     * @brief Reports files that were created or modified inside watched folders
+     *
+     * On Linux the folders (and their subfolders) are watched with inotify, so checking for
+     * changes is a single non blocking read. A watched folder that is deleted or moved loses
+     * its watch, it's checked every \c GKC_FILE_WATCH_POLL_MS and watched again once it
+     * exists at its path (its files are reported as changed). On other platforms the folders
+     * are rescanned every \c GKC_FILE_WATCH_POLL_MS comparing the modification times.
+     *
+     * Changes are debounced, editors usually write a file in several steps (truncate, write,
+     * rename...), a file is only reported once no event arrived for \c GKC_FILE_WATCH_DEBOUNCE_MS.
+     */
+    class FileWatcher {
+        public:
+            FileWatcher();
+            ~FileWatcher();
+
+            FileWatcher(const FileWatcher&) = delete;
+            FileWatcher& operator=(const FileWatcher&) = delete;
+
+            /**
+             * @brief Watches a folder and its subfolders
+             * @param folder Folder path
+             * @return true if the folder is being watched
+             */
+            bool Watch(const path& folder);
+
+            /**
+             * @brief Collects the changed files whose debounce time elapsed, call it once per frame
+             * @param changed Changed file paths are appended here
+             */
+            void Poll(vector<path>& changed);
+        private:
+            unordered_map<string, Uint64> m_pending;    // Changed file -> tick of its last event
+
+            #ifdef __linux__
+                int m_fd = -1;
+                unordered_map<int, path> m_watches;
+                vector<path> m_lost;                    // Deleted or moved folders, watched again once they exist
+                Uint64 m_lastRetry = 0;
+
+                bool AddWatch(const path& folder);
+                void ReadEvents(Uint64 now);
+                void RemoveWatches(const path& folder);
+                void LoseWatch(const path& folder);
+                void RetryLostWatches(Uint64 now);
+            #else
+                vector<path> m_folders;
+                unordered_map<string, std::filesystem::file_time_type> m_times;
+                Uint64 m_lastScan = 0;
+
+                void Scan(Uint64 now, bool notify);
+            #endif
+    };
+}
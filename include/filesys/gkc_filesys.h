@@ -69,6 +69,26 @@ namespace Galaktic::Filesystem {
 	 */
 	extern void RenameFile(const path& old_path, const path& new_path);
 
+	/**
+	 * @brief Writes the data to a temporary file next to \c file , flushes it to the disk
+	 * 		  and renames it over \c file . A crash in the middle leaves the old file intact
+	 * @param file File to write
+	 * @param data Data to write
+	 * @param size Size of the data in bytes
+	 * @return true if the file was written and replaced, false otherwise
+	 */
+	extern bool WriteFileAtomic(const path& file, const void* data, size_t size);
+
+	/**
+	 * @brief Appends the data at the end of the file (it's created if it doesn't exist)
+	 * 		  and flushes it to the disk before returning
+	 * @param file File to append to
+	 * @param data Data to append
+	 * @param size Size of the data in bytes
+	 * @return true if the data was appended, false otherwise
+	 */
+	extern bool AppendFileSynced(const path& file, const void* data, size_t size);
+
 	/**
 	 * @brief Deletes a file at the specified path.
 	 * @param filepath filepath
@@ -141,8 +161,8 @@ namespace Galaktic::Filesystem {
 
 	const inline vector<path> APP_DIRECTORY_STRUCTURE = {
 		"assets", "assets/textures", "assets/sounds", "assets/animations",
-		"scenes", "scripts", "scripts/local", "scripts/modules",
-		"scripts/modules/Galaktic", "config"
+		"assets/tilemaps", "scenes", "scripts", "scripts/local", "scripts/modules",
+		"scripts/modules/Galaktic", "config", "cache"
 	};
 }
 
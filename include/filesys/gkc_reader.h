@@ -23,6 +23,8 @@
 
 #pragma once
 #include <pch.hpp>
+#include <filesys/gkc_compression.h>
+#include <filesys/gkc_scene_format.h>
 
 namespace Galaktic::Core::Managers {
     class ECS_Manager;
@@ -47,52 +49,110 @@ namespace Galaktic::Filesystem {
     class FileReader {
         public:
             /**
-             * @brief Reads a string from an input file stream.
-             * @param file Input file stream to read from.
+             * @brief Reads a string from an input stream.
+             * @param file Input stream to read from.
              * @param str String reference to store the result.
              */
-            static void ReadString(ifstream& file, string& str);
+            static void ReadString(std::istream& file, string& str);
 
             /**
-             * @brief Reads a generic data type from an input file stream.
+             * @brief Reads a generic data type from an input stream.
              * @tparam T Type of the value to read.
-             * @param file Input file stream to read from.
+             * @param file Input stream to read from (file or \c AssetStream).
              * @param value Variable to store the read value.
              */
             template<typename T>
-            static void Read(ifstream& file, T& value) {
+            static void Read(std::istream& file, T& value) {
                 file.read(reinterpret_cast<char*>(&value), sizeof(T));
             }
             
             /**
-             * Reads an entity from a input file stream, adding its components to the provided
-             * ECS_Manager and Registry. No checks are made to verify the integrity of the data,
-             * if a scene has been tampered with, it may lead to crashes or undefined behavior.
-             * 
-             * @attention Many versions of reading or writing functions may be incompatible with different
-             * verions of Galaktic. Please ensure that the version of the engine used to read a scene
-             * matches the version used to write it.
-             * @param file File stream to read from
+             * Loads a scene from memory, adding its entities and components to the provided
+             * ECS_Manager and Registry. Scenes in the current format are read column by column
+             * straight from the data, scenes written by older versions are read with the old
+             * layout.
+             *
+             * The columns of a version 5 scene are checked against their checksums first (by
+             * several threads when the scene is big), damaged or missing columns are dropped
+             * and the intact blocks of compressed ones are kept.
+             *
+             * Big scenes are decoded by several threads, every column is split at its blocks (or
+             * in ranges of entities) and each part is read into a pool of its own. The entities,
+             * the pools and the names are then added to the manager and the registry by the
+             * calling thread.
+             *
+             * @param data Scene data (usually a mapped file)
+             * @param size Size of the data
+             * @param manager ECS_Manager
+             * @param registry Registry (ECS)
+             * @param sceneName Name of the scene stored in the file
+             * @param registerTypes Registers the engine components before reading, threads that
+             *        only read the registry pass false once the main thread registered them
+             * @return true if the scene was loaded, false if it's corrupted
+             */
+            static bool LoadScene(const Uint8* data, size_t size, Core::Managers::ECS_Manager& manager,
+                ECS::Registry* registry, string& sceneName, bool registerTypes = true);
+
+            /**
+             * @brief Reads a single entity and its components from a scene through its entity
+             *        index, the rest of the scene isn't read. Compressed blocks are checked
+             *        against their checksum, use \c VerifyScene() to check the whole scene.
+             * @param data Scene data (usually a mapped file), saved by version 5 or newer
+             * @param size Size of the data
+             * @param id ID of the entity, its components replace the ones it already has
              * @param manager ECS_Manager
              * @param registry Registry (ECS)
+             * @return true if the entity was found and read
              */
-            static void ReadEntity(ifstream& file, Core::Managers::ECS_Manager& manager,
-                ECS::Registry* registry);
+            static bool LoadSceneEntity(const Uint8* data, size_t size, EntityID id,
+                Core::Managers::ECS_Manager& manager, ECS::Registry* registry);
+
+            /**
+             * @brief Checks the tables and every column of a scene against their checksums,
+             *        the damaged columns are logged
+             * @param file Scene to check, it can be inside a mounted archive
+             * @return true if the scene is intact, scenes saved before version 5 only have
+             *         their tables checked
+             */
+            static bool VerifyScene(const path& file);
 
             /**
              * Reads the scene from a file path, adding its entities and components to the provided
-             * ECS_Manager and Registry. No checks are made to verify the integrity of the data,
-             * if a scene has been tampered with, it may lead to crashes or undefined behavior.
+             * ECS_Manager and Registry. The file is memory mapped and read with \c LoadScene() , then
+             * its journal (incremental saves, see \c SceneJournal ) is applied,
+             * offsets and sizes are validated but the components themselves aren't, if a scene has
+             * been tampered with, it may lead to undefined behavior.
              * 
              * @attention Many versions of reading or writing functions may be incompatible with different
              * verions of Galaktic. Please ensure that the version of the engine used to read a scene
              * matches the version used to write it.
-             * @param path Path to the scene file (.gkscene)
+             * @param path Path to the scene file (.gkscene), it can be inside a mounted archive
              * @param manager ECS_Manager
              * @param registry Registry (ECS)
              * @param scene Scene reference to read data into
              */
             static void ReadScene(const path& path, Core::Managers::ECS_Manager& manager,
                 ECS::Registry* registry, Core::Scene& scene);
+
+            /**
+             * @brief Rewrites a scene in the current format (e.g. a scene saved by an older version)
+             * @param input Scene to convert, it can be inside a mounted archive
+             * @param output Path of the converted scene, it can be the same as input
+             * @param compression Codec the converted scene is compressed with
+             * @return true if the scene was converted
+             */
+            static bool ConvertScene(const path& input, const path& output,
+                Compression_Type compression = Compression_Type::None);
+
+            /**
+             * @brief Splits a scene in cells that can be streamed (see \c FileWriter::SerializeWorld() )
+             * @param input Scene to split, it can be inside a mounted archive
+             * @param output Path of the world (.gkworld)
+             * @param cellSize Side of a cell in pixels
+             * @param compression Codec the cells are compressed with
+             * @return true if the world was written
+             */
+            static bool ConvertSceneToWorld(const path& input, const path& output,
+                float cellSize = GKC_WORLD_CELL_SIZE, Compression_Type compression = Compression_Type::None);
     };
 }
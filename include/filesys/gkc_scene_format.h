@@ -0,0 +1,333 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+#include <core/gkc_hash.h>
+#include <filesys/gkc_compression.h>
+
+namespace Galaktic::Filesystem {
+    inline constexpr char GKC_SCENE_MAGIC[4] = { 'G', 'K', 'S', 'N' };
+    inline constexpr Uint64 GKC_SCENE_ALIGNMENT = 16;       // Alignment of every column inside the scene
+    inline constexpr Uint32 GKC_SCENE_BLOCK_SIZE = 64 * 1024;          // Raw size compressed columns are split at
+    inline constexpr Uint32 GKC_SCENE_MAX_BLOCK_SIZE = 64 * 1024 * 1024;   // Bigger blocks are treated as corrupted
+    inline constexpr size_t GKC_SCENE_PARALLEL_SIZE = 1024 * 1024;  // Smaller scenes are checked and read by one thread
+    inline constexpr size_t GKC_SCENE_HEADER_SIZE_V2 = 48;  // Version 2 headers end before compression_
+    inline constexpr size_t GKC_SCENE_HEADER_SIZE_V3 = 56;  // Version 3 and 4 headers end before indexOffset_
+    inline constexpr size_t GKC_SCENE_COLUMN_SIZE_V4 = 40;  // Columns before version 5 end before checksum_
+    inline const string GKC_SCENE_FOOTER_V1 = "Wrote in Galaktic ^o^";
+    inline constexpr char GKC_SCENE_JOURNAL_MAGIC[4] = { 'G', 'K', 'J', 'N' };
+    inline constexpr Uint32 GKC_VERSION_SCENE_JOURNAL = 1;
+    inline const string GKC_SCENE_JOURNAL_EXTENSION = ".journal";
+    inline constexpr char GKC_WORLD_MAGIC[4] = { 'G', 'K', 'W', 'D' };
+    inline constexpr Uint32 GKC_VERSION_WORLD = 1;
+    inline constexpr float GKC_WORLD_CELL_SIZE = 2048.f;   // Default side of a world cell in pixels
+    inline const string GKC_WORLD_EXTENSION = ".gkworld";
+    inline constexpr char GKC_WORLD_OVERLAY_MAGIC[4] = { 'G', 'K', 'W', 'O' };
+    inline constexpr Uint32 GKC_VERSION_WORLD_OVERLAY = 1;
+    inline const string GKC_WORLD_OVERLAY_EXTENSION = ".overlay";
+
+    /**
+     * @enum Scene_Column_Flags
+     * @brief Flags of a component column stored in a scene
+     */
+    enum Scene_Column_Flags : Uint32 {
+        SCENE_COLUMN_NONE = 0,
+        SCENE_COLUMN_TAG = 1 << 0,      // Only the entity IDs are stored
+        SCENE_COLUMN_POD = 1 << 1,      // The data is a packed array of elementSize_ components
+        SCENE_COLUMN_COMPRESSED = 1 << 2,   // The IDs and the data are split in SceneBlock
+        SCENE_COLUMN_FIELDS = 1 << 3,       // Every component is its fieldCount_ SceneField one after the other
+    };
+
+    /**
+     * @struct SceneHeader
+     * @brief First bytes of a .gkscene file (version 5)
+     *
+     * A scene is the header, a table with one \c SceneColumn per component type, the IDs of
+     * every entity, the columns and a block with the names. A column is the IDs of the entities
+     * that have the component followed by the components in the same order, so a whole
+     * component type is read at once from the mapped file.
+     *
+     * When the scene is compressed every column is a list of \c SceneBlock instead, each block
+     * holds whole components so they are decompressed and read one block at a time. Version 2
+     * headers are the same without \c compression_ and \c fieldCount_ .
+     *
+     * Components with reflected fields (see \c ComponentFields ) are stored field by field
+     * without padding, the \c SceneField table after the column table tells which fields a
+     * column holds so components keep loading after fields are added or removed.
+     *
+     * Since version 5 everything but the columns (header, tables, IDs, names and the entity
+     * index) comes first and is covered by \c checksum_ , every column and every compressed
+     * block has a CRC32C of its own. A damaged or truncated scene keeps its intact columns
+     * and blocks. The entity index (see \c SceneIndexEntry ) locates the components of an
+     * entity without reading the columns. Version 2 to 4 headers end before \c indexOffset_
+     * and their columns before \c SceneColumn::checksum_ .
+     */
+    struct SceneHeader {
+        char magic_[4];             // "GKSN"
+        Uint32 version_;
+        Uint32 entityCount_;
+        Uint32 columnCount_;
+        Uint64 columnsOffset_;      // columnCount_ SceneColumn
+        Uint64 entitiesOffset_;     // entityCount_ EntityID
+        Uint64 namesOffset_;        // Scene name followed by the component names, not null terminated
+        Uint32 nameLength_;         // Length of the scene name
+        Uint32 snapshot_;           // Identifies this save, a journal only applies to the snapshot it was started on
+        Uint32 compression_;        // Compression_Type of the compressed columns
+        Uint32 fieldCount_;         // SceneField after the column table, 0 before version 4
+        Uint64 indexOffset_;        // entityCount_ + 1 Uint32 (first entry of every entity) followed by the entries
+        Uint32 indexCount_;         // SceneIndexEntry of the index, one per stored component
+        Uint32 checksum_;           // CRC32C of the header (up to here) and everything up to the end of the index
+    };
+
+    /**
+     * @struct SceneColumn
+     * @brief Table entry of a component column stored in a scene
+     */
+    struct SceneColumn {
+        Uint64 offset_;             // count_ EntityID followed by the data (or the first block), from the start of the file
+        Uint64 dataSize_;           // Size of the data after the IDs (or of all the blocks)
+        Uint32 count_;
+        Uint32 elementSize_;        // Size of a component in POD and field columns, 0 otherwise
+        Uint32 nameOffset_;         // Offset of the component name inside the names block
+        Uint32 nameLength_;
+        Uint32 flags_;              // Scene_Column_Flags
+        Uint32 fieldCount_;         // Fields of the column, they follow the fields of the previous columns
+        Uint32 checksum_;           // CRC32C of the IDs and the data (or of all the blocks)
+        Uint32 reserved_;
+    };
+
+    /**
+     * @struct SceneField
+     * @brief Field of a component as it was stored, in the order the fields are packed
+     */
+    struct SceneField {
+        Uint16 id_;                 // ComponentField::id_ , stays the same when fields are added or removed
+        Uint16 size_;
+    };
+
+    /**
+     * @struct SceneBlock
+     * @brief Header of a block of a compressed column, the block is count_ EntityID followed
+     *        by their components once decompressed
+     */
+    struct SceneBlock {
+        Uint32 rawSize_;            // Size once decompressed
+        Uint32 storedSize_;         // Size stored after this header, same as rawSize_ if stored raw
+        Uint32 count_;
+        Uint32 checksum_;           // CRC32C of the stored bytes, 0 before version 5
+    };
+
+    /**
+     * @struct SceneIndexEntry
+     * @brief Component of an entity in the entity index, the entries of an entity are in
+     *        column order and the entities in the order of their IDs
+     */
+    struct SceneIndexEntry {
+        Uint32 column_;
+        Uint32 offset_;             // From SceneColumn::offset_ to the component, to its ID in tag
+                                    // columns and to the SceneBlock that holds it in compressed ones
+    };
+
+    /**
+     * @enum World_Cell_Flags
+     * @brief Flags of a cell stored in a world
+     */
+    enum World_Cell_Flags : Uint32 {
+        WORLD_CELL_NONE = 0,
+        WORLD_CELL_PERSISTENT = 1 << 0,     // Entities without a TransformComponent, loaded with the world
+    };
+
+    /**
+     * @struct WorldHeader
+     * @brief First bytes of a .gkworld file
+     *
+     * A world is a scene split in square cells by the location of its entities, every cell is
+     * a whole .gkscene (aligned to \c GKC_SCENE_ALIGNMENT ) so it's read with the scene reader
+     * and only the cells around the camera have to be in memory (see \c WorldStreamer ).
+     * Entities keep the ID they had in the scene.
+     */
+    struct WorldHeader {
+        char magic_[4];             // "GKWD"
+        Uint32 version_;
+        Uint32 cellCount_;
+        float cellSize_;            // Side of a cell in pixels
+        Uint64 cellsOffset_;        // cellCount_ WorldCell sorted by y_ and x_
+        Uint32 maxEntityID_;        // Highest ID of the world, entities created while streaming get higher ones
+        Uint32 reserved_;
+    };
+
+    /**
+     * @struct WorldCell
+     * @brief Table entry of a cell stored in a world
+     */
+    struct WorldCell {
+        Sint32 x_;                  // Location of the cell divided by cellSize_
+        Sint32 y_;
+        Uint64 offset_;             // Scene of the cell, from the start of the file
+        Uint64 size_;
+        Uint32 entityCount_;
+        Uint32 flags_;              // World_Cell_Flags
+    };
+
+    /**
+     * @brief Cell of a world that holds a point
+     * @param coordinate X or Y of the point
+     * @param cellSize Side of a cell
+     */
+    inline Sint32 GetWorldCell(float coordinate, float cellSize) {
+        return static_cast<Sint32>(std::floor(coordinate / cellSize));
+    }
+
+    inline Uint64 GetWorldCellKey(Sint32 x, Sint32 y) {
+        return (static_cast<Uint64>(static_cast<Uint32>(y)) << 32) | static_cast<Uint32>(x);
+    }
+
+    /**
+     * @struct WorldOverlayHeader
+     * @brief First bytes of the overlay of a world (.gkworld.overlay)
+     *
+     * Worlds are read only, the streamed entities that changed or were destroyed are kept in
+     * the overlay: the IDs of the destroyed entities follow the header and the last state of
+     * the changed entities is stored as a whole .gkscene (aligned to \c GKC_SCENE_ALIGNMENT ).
+     */
+    struct WorldOverlayHeader {
+        char magic_[4];             // "GKWO"
+        Uint32 version_;
+        Uint32 destroyedCount_;
+        Uint32 reserved_;
+        Uint64 sceneOffset_;
+        Uint64 sceneSize_;
+    };
+
+    /**
+     * @struct JournalHeader
+     * @brief First bytes of a scene journal (.gkscene.journal)
+     *
+     * A journal is a list of deltas appended after the snapshot saved in the .gkscene, each
+     * one is a \c JournalRecord followed by the changes: the destroyed entities, the created
+     * entities and one column per changed component type with the IDs of the changed and
+     * removed components followed by the changed components. Columns stored field by field
+     * list their \c SceneField before the IDs.
+     */
+    struct JournalHeader {
+        char magic_[4];             // "GKJN"
+        Uint32 version_;
+        Uint32 snapshot_;           // SceneHeader::snapshot_ of the scene the deltas apply to
+        Uint32 reserved_;
+    };
+
+    /**
+     * @struct JournalRecord
+     * @brief Header of a delta inside a journal
+     */
+    struct JournalRecord {
+        Uint64 size_;               // Size of the delta after this record
+        Uint64 checksum_;           // FNV-1a of the delta, a torn write at the end is detected and dropped
+    };
+
+    static_assert(sizeof(SceneHeader) == 72, "SceneHeader layout changed!");
+    static_assert(sizeof(SceneBlock) == 16, "SceneBlock layout changed!");
+    static_assert(sizeof(JournalHeader) == 16, "JournalHeader layout changed!");
+    static_assert(sizeof(JournalRecord) == 16, "JournalRecord layout changed!");
+    static_assert(sizeof(SceneColumn) == 48, "SceneColumn layout changed!");
+    static_assert(sizeof(SceneIndexEntry) == 8, "SceneIndexEntry layout changed!");
+    static_assert(sizeof(SceneField) == 4, "SceneField layout changed!");
+    static_assert(sizeof(WorldHeader) == 32, "WorldHeader layout changed!");
+    static_assert(sizeof(WorldCell) == 32, "WorldCell layout changed!");
+    static_assert(sizeof(WorldOverlayHeader) == 32, "WorldOverlayHeader layout changed!");
+
+    /**
+     * @brief Reads the header of a column oriented scene (version 2 or newer)
+     * @param data Scene data
+     * @param size Size of the data
+     * @param header Header to read into, older headers are completed with the defaults
+     * @return true if the data starts with a header this version can read
+     */
+    inline bool ReadSceneHeader(const Uint8* data, size_t size, SceneHeader& header) {
+        header = {};
+        if (data == nullptr || size < GKC_SCENE_HEADER_SIZE_V2)
+            return false;
+        std::memcpy(&header, data, GKC_SCENE_HEADER_SIZE_V2);
+        if (std::memcmp(header.magic_, GKC_SCENE_MAGIC, sizeof(GKC_SCENE_MAGIC)) != 0
+            || header.version_ < 2 || header.version_ > GKC_VERSION_SCENE) {
+            return false;
+        }
+        const size_t headerSize = header.version_ >= 5 ? sizeof(SceneHeader)
+            : header.version_ >= 3 ? GKC_SCENE_HEADER_SIZE_V3 : GKC_SCENE_HEADER_SIZE_V2;
+        if (size < headerSize)
+            return false;
+        std::memcpy(&header, data, headerSize);
+        return true;
+    }
+
+    /**
+     * @param version Version of the scene
+     * @return Size of an entry of the column table
+     */
+    inline size_t GetSceneColumnSize(Uint32 version) {
+        return version >= 5 ? sizeof(SceneColumn) : GKC_SCENE_COLUMN_SIZE_V4;
+    }
+
+    /**
+     * @brief Reads an entry of the column table, the table has to be in range
+     * @param data Scene data
+     * @param header Header of the scene
+     * @param index Index of the column
+     * @param column Column to read into, older entries are completed with the defaults
+     */
+    inline void ReadSceneColumn(const Uint8* data, const SceneHeader& header, Uint32 index, SceneColumn& column) {
+        column = {};
+        const size_t columnSize = GetSceneColumnSize(header.version_);
+        std::memcpy(&column, data + header.columnsOffset_ + index * columnSize, columnSize);
+    }
+
+    /**
+     * @param header Header of a version 5 scene
+     * @return Offset where the entity index ends, the columns start after it
+     */
+    inline Uint64 GetSceneIndexEnd(const SceneHeader& header) {
+        return header.indexOffset_ + (static_cast<Uint64>(header.entityCount_) + 1) * sizeof(Uint32)
+            + static_cast<Uint64>(header.indexCount_) * sizeof(SceneIndexEntry);
+    }
+
+    /**
+     * @brief Computes \c SceneHeader::checksum_ , the checksum itself is skipped
+     * @param data Scene data, at least \c GetSceneIndexEnd() bytes
+     * @param header Header of the scene
+     */
+    inline Uint32 GetSceneChecksum(const Uint8* data, const SceneHeader& header) {
+        const Uint32 crc = Core::HashCRC32C(data, offsetof(SceneHeader, checksum_));
+        return Core::HashCRC32C(data + sizeof(SceneHeader), GetSceneIndexEnd(header) - sizeof(SceneHeader), crc);
+    }
+
+    /**
+     * @param data Scene data
+     * @param size Size of the data
+     * @return Snapshot ID of a column oriented scene, 0 otherwise
+     */
+    inline Uint32 GetSceneSnapshot(const Uint8* data, size_t size) {
+        SceneHeader header{};
+        return ReadSceneHeader(data, size, header) ? header.snapshot_ : 0;
+    }
+}
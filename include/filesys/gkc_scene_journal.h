@@ -0,0 +1,125 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+#include <filesys/gkc_byte_buffer.h>
+
+namespace Galaktic::Core::Managers {
+    class ECS_Manager;
+}
+namespace Galaktic::ECS {
+    class Entity;
+    class Registry;
+    typedef unordered_map<EntityID, Entity> Entity_List;
+}
+
+namespace Galaktic::Filesystem {
+    inline constexpr Uint64 GKC_SCENE_JOURNAL_COMPACT_MIN = 256 * 1024;    // Smaller journals are never compacted
+    inline constexpr Uint64 GKC_SCENE_JOURNAL_COMPACT_RATIO = 2;           // Compacted once bigger than snapshot / ratio
+
+    /**
+     * @class SceneJournal
+     * @brief Incremental saves of a scene (see gkc_scene_format.h)
+     *
+     * Instead of writing the whole scene every time, only the components recorded by the
+     * \c Registry change tracking are appended to a journal next to the .gkscene file.
+     * When a scene is read its journal is replayed over the snapshot. Once the journal grows
+     * too big it's compacted in a background thread: the snapshot and the journal are merged
+     * into a new snapshot and the journal starts again.
+     *
+     * @note The compaction reads the \c ComponentRegistry , \c WaitForCompaction() has to be
+     *       called before the registered component types are cleared
+     */
+    class SceneJournal {
+        public:
+            /**
+             * @param scene Path of the .gkscene file
+             * @return Path of its journal
+             */
+            static path GetJournalPath(const path& scene);
+
+            /**
+             * @brief Serializes the changes recorded by the registry into a delta
+             * @param buffer Buffer to serialize to
+             * @param entities Entities of the scene
+             * @param registry Registry (ECS) with change tracking enabled
+             */
+            static void SerializeDelta(ByteBuffer& buffer, const ECS::Entity_List& entities, ECS::Registry* registry);
+
+            /**
+             * @brief Appends a delta to the journal of the scene and flushes it to the disk, the
+             *        journal is started if it doesn't exist or belongs to an older snapshot
+             * @param scene Path of the .gkscene file, it has to exist
+             * @param delta Delta serialized by \c SerializeDelta()
+             * @return true if the delta was appended
+             */
+            static bool Append(const path& scene, const ByteBuffer& delta);
+
+            /**
+             * @brief Applies the journal of the scene (if any) to a scene that was just read
+             * @param scene Path of the .gkscene file
+             * @param snapshot Snapshot ID of the read scene
+             * @param manager ECS_Manager the scene was read into
+             * @param registry Registry (ECS) the scene was read into
+             * @return Number of deltas applied
+             */
+            static size_t Replay(const path& scene, Uint32 snapshot, Core::Managers::ECS_Manager& manager,
+                ECS::Registry* registry);
+
+            /**
+             * @brief Merges the journal into a new snapshot of the scene
+             * @param scene Path of the .gkscene file
+             * @return true if the scene was compacted
+             */
+            static bool Compact(const path& scene);
+
+            /**
+             * @brief Same as \c Compact() but in a background thread, ignored if a compaction
+             *        is already running
+             * @param scene Path of the .gkscene file
+             */
+            static void CompactAsync(const path& scene);
+
+            /**
+             * @return true if the journal is big enough (compared to the snapshot) to be compacted
+             */
+            static bool NeedsCompaction(const path& scene);
+
+            /**
+             * @brief Blocks until the background compaction (if any) finishes
+             */
+            static void WaitForCompaction();
+
+            /**
+             * @brief Deletes the journal of the scene, used after a full save
+             */
+            static void Discard(const path& scene);
+
+            static bool IsCompacting() { return m_compacting.load(); }
+        private:
+            static std::mutex m_mutex;
+            static std::thread m_compactor;
+            static std::atomic<bool> m_compacting;
+    };
+}
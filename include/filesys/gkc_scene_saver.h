@@ -0,0 +1,116 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+#include <ecs/gkc_entity.h>
+#include <filesys/gkc_compression.h>
+
+namespace Galaktic::Filesystem {
+    /**
+     * @struct SceneSnapshot
+     * @brief Copy of the state of a scene that can be saved while the scene keeps running
+     */
+    struct SceneSnapshot {
+        path scene_;                            // Path of the .gkscene file
+        string name_;
+        ECS::Entity_List entities_;             // Entities point to the copied registry
+        unique_ptr<ECS::Registry> registry_;
+        bool full_ = false;                     // Whole scene, otherwise only the recorded changes
+        Compression_Type compression_ = Compression_Type::None;    // Codec of a full save
+    };
+
+    /**
+     * @class SceneSaver
+     * @brief Saves scenes in a background thread
+     *
+     * \c Capture() runs on the main thread and only copies what the save needs: the changed
+     * components for an incremental save, every pool for a full one. The changes recorded
+     * by the registry are cleared so the next capture starts from there. The serialization,
+     * the disk I/O and the journal compaction happen in the saver thread, saves are written
+     * in the order they were queued.
+     *
+     * @note The saver reads the \c ComponentRegistry (its accesses are locked), \c Stop() has
+     *       to be called before the registered component types are cleared
+     */
+    class SceneSaver {
+        public:
+            /**
+             * @brief Copies the state of a scene, the changes recorded by the registry are cleared
+             * @param scene Path of the .gkscene file
+             * @param name Name of the scene
+             * @param entities Entities of the scene
+             * @param registry Registry (ECS) with change tracking enabled
+             * @param full Copies the whole scene instead of the recorded changes
+             * @param compression Codec the scene is compressed with if it's saved whole
+             * @return Snapshot to pass to \c Save() or \c SaveAsync()
+             */
+            static SceneSnapshot Capture(const path& scene, const string& name, const ECS::Entity_List& entities,
+                ECS::Registry* registry, bool full, Compression_Type compression = Compression_Type::None);
+
+            /**
+             * @brief Writes a snapshot in the calling thread, a full snapshot replaces the
+             *        scene and its journal, otherwise the changes are appended to the journal
+             * @param snapshot Snapshot made by \c Capture()
+             * @return true if the snapshot was written
+             */
+            static bool Save(const SceneSnapshot& snapshot);
+
+            /**
+             * @brief Queues a snapshot to be written by the saver thread, the thread is
+             *        started if it isn't running
+             * @param snapshot Snapshot made by \c Capture()
+             */
+            static void SaveAsync(SceneSnapshot snapshot);
+
+            /**
+             * @brief Blocks until every queued snapshot is written
+             */
+            static void Flush();
+
+            /**
+             * @brief Writes the queued snapshots and joins the saver thread
+             */
+            static void Stop();
+
+            /**
+             * @brief Checks if a queued snapshot failed to be written since the last call,
+             *        the changes it held are lost and the next save has to be a full one
+             */
+            static bool ConsumeFailure() { return m_failed.exchange(false); }
+
+            static size_t GetPendingCount() { return m_pending.load(); }
+            static bool IsRunning() { return m_worker.joinable(); }
+        private:
+            static std::thread m_worker;
+            static std::deque<SceneSnapshot> m_queue;
+            static std::mutex m_mutex;
+            static std::condition_variable m_condition;
+            static std::condition_variable m_idle;
+            static std::atomic<size_t> m_pending;
+            static std::atomic<bool> m_failed;
+            static bool m_stop;
+
+            static void WorkerLoop();
+    };
+}
@@ -23,6 +23,9 @@
 
 #pragma once
 #include <pch.hpp>
+#include <filesys/gkc_byte_buffer.h>
+#include <filesys/gkc_compression.h>
+#include <filesys/gkc_scene_format.h>
 
 namespace Galaktic::Core {
     class Scene;
@@ -30,6 +33,7 @@ namespace Galaktic::Core {
 namespace Galaktic::ECS {
     class Entity;
     class Registry;
+    typedef unordered_map<EntityID, Entity> Entity_List;
 }
 
 namespace Galaktic::Filesystem {
@@ -62,24 +66,32 @@ namespace Galaktic::Filesystem {
             }
 
             /**
-             * Writes an entity to an output file stream, retrieving its components to the provided
-             * entity and Registry. No checks are made to verify the integrity of the data,
-             * if a scene has been tampered with, it may lead to crashes or undefined behavior.
-             * 
-             * @attention Many versions of reading or writing functions may be incompatible with different
-             * verions of Galaktic. Please ensure that the version of the engine used to read a scene
-             * matches the version used to write it.
-             * @param file File stream to write to
-             * @param entity Entity to write
-             * @param registry Registry (ECS)
+             * Serializes the entities of a scene into a buffer using the column oriented
+             * format (see gkc_scene_format.h), one column is written per component type
+             * with the IDs of the entities that have it followed by the components.
+             *
+             * If a codec is given the columns are split in blocks of about \c GKC_SCENE_BLOCK_SIZE
+             * and every block is compressed on its own, a codec the engine wasn't built with
+             * writes the scene uncompressed. Every column and block gets a CRC32C and an index
+             * with the components of every entity is written before the columns.
+             *
+             * @param buffer Buffer to serialize to
+             * @param sceneName Name of the scene
+             * @param entities Entities to write
+             * @param registry Registry (ECS) holding the components of the entities
+             * @param compression Codec the columns are compressed with
+             * @return Snapshot ID stored in the header (never 0)
              */
-            static void WriteEntity(ofstream& file, const ECS::Entity& entity,
-                ECS::Registry* registry);
+            static Uint32 SerializeScene(ByteBuffer& buffer, const string& sceneName,
+                const ECS::Entity_List& entities, ECS::Registry* registry,
+                Compression_Type compression = Compression_Type::None);
 
             /**
              * Writes the scene to a file path, adding its entities and components to the provided
-             * ECS_Manager and Registry. No checks are made to verify the integrity of the data,
-             * if a scene has been tampered with, it may lead to crashes or undefined behavior.
+             * ECS_Manager and Registry. The whole scene is serialized in memory first and written
+             * with a single call, the file is flushed to the disk and then renamed over the old
+             * scene so a crash never leaves a half written scene. The checksums let the reader drop
+             * the columns of a scene that was damaged afterwards.
              * 
              * @attention Many versions of reading or writing functions may be incompatible with different
              * verions of Galaktic. Please ensure that the version of the engine used to read a scene
@@ -87,8 +99,29 @@ namespace Galaktic::Filesystem {
              * @param name Name of the file to output, (can be different from the scene name)
              * @param scene Scene reference to write data from
              * @param registry Registry (ECS)
+             * @param compression Codec the columns are compressed with
+             * @throws Debug::WritingException if the scene couldn't be written
+             */
+            static void WriteScene(const path& name, Core::Scene &scene, ECS::Registry *registry,
+                Compression_Type compression = Compression_Type::None);
+
+            /**
+             * Serializes the entities of a scene into a world (see \c WorldHeader ), the entities
+             * are grouped in cells by the center of their \c TransformComponent and every cell
+             * is serialized with \c SerializeScene() . Entities without a transform go to the
+             * persistent cell.
+             *
+             * @param buffer Buffer to serialize to
+             * @param sceneName Name of the scene, every cell keeps it
+             * @param entities Entities to write
+             * @param registry Registry (ECS) holding the components of the entities
+             * @param cellSize Side of a cell in pixels
+             * @param compression Codec the cells are compressed with
+             * @return Number of cells written
              */
-            static void WriteScene(const path& name, Core::Scene &scene, ECS::Registry *registry);
+            static Uint32 SerializeWorld(ByteBuffer& buffer, const string& sceneName,
+                const ECS::Entity_List& entities, ECS::Registry* registry, float cellSize = GKC_WORLD_CELL_SIZE,
+                Compression_Type compression = Compression_Type::None);
 
     };
 }
\ No newline at end of file
@@ -12,6 +12,14 @@
 #include <unordered_set>
 #include <iomanip>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <array>
+#include <span>
 #include <SDL3/SDL.h>
 #include <../libs/SDL_mixer/include/SDL3_mixer/SDL_mixer.h>
 #include <SDL3/SDL_video.h>
@@ -23,48 +23,127 @@
 
 #pragma once
 #include <pch.hpp>
+#include <core/managers/gkc_asset_table.h>
 
 namespace Galaktic::Render {
+    /**
+     * @struct AnimationFrame
+     * @brief Location and duration of a frame inside an animation sheet
+     */
+    struct AnimationFrame {
+        Uint32 sheet_ = 0;
+        SDL_FRect rect_{};
+        float delay_ = 0;   // Seconds
+    };
+
+    /**
+     * @struct BakedAnimation
+     * @brief Sprite sheets of an animation in CPU memory, waiting to be uploaded
+     */
+    struct BakedAnimation {
+        BakedAnimation() = default;
+        ~BakedAnimation();
+
+        BakedAnimation(const BakedAnimation&) = delete;
+        BakedAnimation& operator=(const BakedAnimation&) = delete;
+
+        vector<SDL_Surface*> sheets_;
+        vector<AnimationFrame> frames_;
+        int width_ = 0;
+        int height_ = 0;
+    };
+
+    /**
+     * @class Animation
+     * @brief Animation loaded from a GIF/APNG file
+     *
+     * All the frames are packed in a grid into one sprite sheet texture (or a few if the
+     * frames don't fit inside the renderer's max texture size), each frame is rendered
+     * using its sheet and source rect. The decoded frames are freed after the sheets are
+     * uploaded, so only the GPU copy stays resident.
+     *
+     * The baked sheets are stored in the \c DecodeCache, so the file is only decoded again
+     * when it changes.
+     *
+     * An animation is immutable resource data shared by every entity using it, the playback
+     * state lives inside each entity's \c AnimationComponent (see \c AnimationSystem).
+     */
     class Animation {
         public:
 			Animation(const path& path, SDL_Renderer* renderer);
+
+            /**
+             * @brief Creates the animation uploading sheets baked with \c Bake(), the frames
+             *        are moved out of \c baked
+             */
+            Animation(BakedAnimation& baked, SDL_Renderer* renderer);
             ~Animation();
 
-            void Update(float deltaTime);
-            void Render(SDL_Renderer *renderer, const SDL_FRect &rect);
-            void Play();
-            void Pause();
-            void Stop();
-            void Reset();
-            void SetLoop(bool loop) { m_isLooping = loop; }
-            void SetFrame(int frame);
-
-            [[nodiscard]] IMG_Animation* GetAnimation() { return m_animation; }
-			int GetWidth() const { return m_animation ? m_animation->w : 0; }
-            int GetHeight() const { return m_animation ? m_animation->h : 0; }
-            int GetFrameCount() const { return m_animation ? m_animation->count : 0; }
-            int GetCurrentFrame() const { return m_currentFrame; }
-            bool IsPlaying() const { return m_isPlaying; }
-            bool IsLooping() const { return m_isLooping; }
-            bool IsFinished() const { return !m_isLooping && m_currentFrame >= GetFrameCount() - 1; }
-            bool IsValid() const { return m_animation != nullptr && m_textures != nullptr; }
+            Animation(const Animation&) = delete;
+            Animation& operator=(const Animation&) = delete;
+
+            /**
+             * @brief Decodes an animation file and packs its frames into sheets in CPU memory,
+             *        safe to call from any thread
+             * @param path Path to the animation file
+             * @param maxSheetSize Max width/height of a sheet, see \c GetMaxSheetSize()
+             * @return The baked sheets, nullptr if the animation failed to load
+             */
+            static unique_ptr<BakedAnimation> Bake(const path& path, int maxSheetSize);
+
+            /**
+             * @brief Gets the max texture size supported by the renderer
+             */
+            static int GetMaxSheetSize(SDL_Renderer* renderer);
+
+            /**
+             * @brief Renders a frame of the animation
+             * @param renderer SDL_Renderer
+             * @param rect Destination rect
+             * @param frame Frame index, nothing is rendered if it's out of range
+             */
+            void Render(SDL_Renderer *renderer, const SDL_FRect &rect, Uint32 frame) const;
+
+            /**
+             * @brief Gets a frame of the animation
+             * @param frame Frame index
+             * @return Pointer to the frame, nullptr if the index is out of range
+             */
+            [[nodiscard]] const AnimationFrame* GetFrame(int frame) const;
+            [[nodiscard]] SDL_Texture* GetSheet(Uint32 sheet) const;
+            [[nodiscard]] size_t GetSheetCount() const { return m_sheets.size(); }
+			int GetWidth() const { return m_width; }
+            int GetHeight() const { return m_height; }
+            int GetFrameCount() const { return static_cast<int>(m_frames.size()); }
+            bool IsValid() const { return !m_frames.empty() && !m_sheets.empty(); }
+
+            /**
+             * @brief Estimates the VRAM used by the sheets
+             * @return Bytes used
+             */
+            [[nodiscard]] size_t GetMemorySize() const;
 		private:
-			IMG_Animation* m_animation = nullptr;
-            SDL_Texture** m_textures = nullptr;
-            
-            int m_currentFrame = 0;
-            float m_accumulatedTime = 0;
-            bool m_isPlaying = true;
-            bool m_isLooping = true;
+            vector<SDL_Texture*> m_sheets;
+            vector<AnimationFrame> m_frames;
+            int m_width = 0;
+            int m_height = 0;
+
+            static unique_ptr<BakedAnimation> BakeSheets(const IMG_Animation* animation, int maxSheetSize);
+            static unique_ptr<BakedAnimation> LoadCachedSheets(Uint64 key);
+            static void StoreCachedSheets(Uint64 key, const BakedAnimation& baked);
+            bool Upload(BakedAnimation& baked, SDL_Renderer* renderer);
     };
 
     struct AnimationInfo {
         AnimationID id_;
         shared_ptr<Animation> animation_;
+        path path_;                     // Used to reload the animation once evicted
+        Uint64 lastUsedFrame_ = 0;
+        size_t bytes_ = 0;
+        bool requested_ = false;        // Queued in the asset loader
     };
 
-    typedef unordered_map<string, shared_ptr<Render::AnimationInfo>> Animation_List;
-    typedef unordered_map<AnimationID, string> AnimationID_List;
+    typedef Core::Managers::AssetTable<shared_ptr<Render::AnimationInfo>> Animation_List;
 
     bool CheckAnimationExtension(const path& path);
 }
\ No newline at end of file
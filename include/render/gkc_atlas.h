@@ -0,0 +1,221 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Render {
+    inline constexpr int GKC_ATLAS_PAGE_SIZE = 2048;    // Width and height of an atlas page
+    inline constexpr int GKC_ATLAS_PADDING = 1;         // Empty pixels between packed images
+    inline constexpr Uint32 GKC_VERSION_ATLAS = 1;      // Version of the atlas layout cache
+
+    /**
+     * @struct AtlasRegion
+     * @brief Location of a packed image inside an atlas page
+     *
+     * \c rect_ is given in pixels (used as the source rect when rendering) and
+     * \c uv_ is the same rect normalized to the page size (0..1)
+     */
+    struct AtlasRegion {
+        Uint32 page_ = 0;
+        SDL_FRect rect_{};
+        SDL_FRect uv_{};
+    };
+
+    /**
+     * @class SkylinePacker
+     * @brief Packs rectangles inside a fixed size area using the skyline bottom-left heuristic
+     *
+     * The skyline is a list of horizontal segments representing the top edge of the
+     * already packed rectangles, a new rectangle is placed where its top edge is the lowest
+     * (ties are broken by the narrowest segment) which keeps the packing tight without
+     * tracking every free rectangle.
+     */
+    class SkylinePacker {
+        public:
+            /**
+             * @param width Width of the area to pack
+             * @param height Height of the area to pack
+             */
+            SkylinePacker(int width, int height);
+
+            /**
+             * @brief Tries to pack a rectangle
+             * @param width Width of the rectangle
+             * @param height Height of the rectangle
+             * @param out Position of the packed rectangle (only valid if it was packed)
+             * @return true if the rectangle was packed, false if there is no space left
+             */
+            bool Pack(int width, int height, SDL_Rect& out);
+
+            /**
+             * @brief Removes all packed rectangles
+             */
+            void Reset();
+        private:
+            struct SkylineNode {
+                int x_;
+                int y_;
+                int width_;
+            };
+
+            vector<SkylineNode> m_skyline;
+            int m_width;
+            int m_height;
+
+            /**
+             * @brief Gets the Y coordinate where a rectangle would rest if placed at the node
+             * @return Y coordinate, -1 if the rectangle doesn't fit
+             */
+            int FitAt(size_t index, int width, int height) const;
+            void AddLevel(size_t index, const SDL_Rect& rect);
+    };
+
+    /**
+     * @struct BakedAtlas
+     * @brief Atlas pages packed in CPU memory, waiting to be uploaded with \c TextureAtlas::Upload()
+     */
+    struct BakedAtlas {
+        BakedAtlas() = default;
+        ~BakedAtlas();
+
+        BakedAtlas(const BakedAtlas&) = delete;
+        BakedAtlas& operator=(const BakedAtlas&) = delete;
+
+        vector<SDL_Surface*> pages_;
+        unordered_map<string, AtlasRegion> regions_;
+    };
+
+    /**
+     * @struct AtlasImage
+     * @brief Decoded image waiting to be packed by \c TextureAtlas::Pack()
+     */
+    struct AtlasImage {
+        path path_;
+        SDL_Surface* surface_ = nullptr;    // nullptr if the image couldn't be decoded
+    };
+
+    /**
+     * @class TextureAtlas
+     * @brief Packs many image files into a few large textures (pages)
+     *
+     * All images are decoded, packed with a \c SkylinePacker and blitted into
+     * \c GKC_ATLAS_PAGE_SIZE pages that are uploaded as single SDL_Textures, each image
+     * can then be drawn using its page and \c AtlasRegion as the source rect.
+     *
+     * The packed layout and the pages are cached inside a folder (the project's cache
+     * folder), if none of the source files changed since the last bake the pages
+     * are loaded directly from the cache instead of decoding and packing every image again.
+     * Images bigger than a page are skipped and have to be loaded as standalone textures.
+     *
+     * \c Build() does everything at once, the slow part can also be done on a worker thread
+     * with \c Bake() (it doesn't touch the renderer) and then uploaded with \c Upload().
+     * \c Bake() is \c LoadSurface() on every file followed by \c Pack() , the images can
+     * also be decoded by several threads and packed once all of them are done.
+     */
+    class TextureAtlas {
+        public:
+            TextureAtlas() = default;
+            ~TextureAtlas();
+
+            TextureAtlas(const TextureAtlas&) = delete;
+            TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+            /**
+             * @brief Builds the atlas from the given image files
+             * @param files Image filepaths
+             * @param renderer SDL_Renderer
+             * @param cacheFolder Folder where the baked layout and pages are stored, if empty
+             *        nothing is cached
+             * @return true if at least one page was created
+             */
+            bool Build(const vector<path>& files, SDL_Renderer* renderer, const path& cacheFolder);
+
+            /**
+             * @brief Loads the pages from the cache if none of the files changed
+             * @return true if the cached atlas was loaded, false if it has to be baked again
+             */
+            bool LoadCache(const vector<path>& files, SDL_Renderer* renderer, const path& cacheFolder);
+
+            /**
+             * @brief Decodes and packs the files into pages in CPU memory and updates the cache,
+             *        safe to call from any thread
+             * @param files Image filepaths
+             * @param cacheFolder Folder where the baked layout and pages are stored, if empty
+             *        nothing is cached
+             * @return The baked pages
+             */
+            static unique_ptr<BakedAtlas> Bake(const vector<path>& files, const path& cacheFolder);
+
+            /**
+             * @brief Packs decoded images into pages in CPU memory and updates the cache,
+             *        safe to call from any thread
+             * @param decoded Decoded images, their surfaces are destroyed (and set to nullptr)
+             * @param cacheFolder Folder where the baked layout and pages are stored, if empty
+             *        nothing is cached
+             * @return The baked pages
+             */
+            static unique_ptr<BakedAtlas> Pack(vector<AtlasImage>& decoded, const path& cacheFolder);
+
+            /**
+             * @brief Uploads baked pages replacing the current ones, the regions are moved
+             *        out of \c baked
+             * @return true if at least one page was uploaded
+             */
+            bool Upload(BakedAtlas& baked, SDL_Renderer* renderer);
+
+            /**
+             * @brief Destroys all pages and regions
+             */
+            void Clear();
+
+            /**
+             * @brief Gets the region of a packed image
+             * @param name Filename of the image (extension included)
+             * @return Pointer to the region, nullptr if the image isn't in the atlas
+             */
+            [[nodiscard]] const AtlasRegion* GetRegion(const string& name) const;
+
+            [[nodiscard]] SDL_Texture* GetPage(Uint32 page) const;
+            [[nodiscard]] size_t GetPageCount() const { return m_pages.size(); }
+            [[nodiscard]] const unordered_map<string, AtlasRegion>& GetRegions() const { return m_regions; }
+        private:
+            /**
+             * @struct CacheEntry
+             * @brief Source file information used to detect stale cached layouts
+             */
+            struct CacheEntry {
+                string name_;
+                Uint64 size_;
+                Sint64 time_;                       // Last write, of the archive for archived files
+                AtlasRegion region_;
+            };
+
+            vector<SDL_Texture*> m_pages;
+            unordered_map<string, AtlasRegion> m_regions;
+
+            static void SaveCache(const vector<CacheEntry>& entries, const vector<SDL_Surface*>& pages,
+                const path& cacheFolder);
+            static CacheEntry MakeCacheEntry(const path& file);
+    };
+}
@@ -0,0 +1,108 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Render {
+    inline constexpr Uint32 GKC_VERSION_DECODE_CACHE = 1;      // Version of the decoded entries
+    inline const string GKC_DECODE_CACHE_FOLDER = "decoded";  // Folder inside the project's cache folder
+    inline constexpr Uint64 GKC_DECODE_CACHE_MAX_SIZE = 1ull << 30;     // Bytes kept when the folder is set
+
+    /**
+     * @class DecodeCache
+     * @brief Content addressed disk cache of decoded images
+     *
+     * Decoding PNG/JPEG/WebP/GIF files is the slowest part of loading textures and animations,
+     * the decoded RGBA32 pixels are stored in the cache folder under a key made from the
+     * FNV-1a hash of the source bytes and the import settings (e.g. the max sheet size of
+     * an animation). A modified source or different settings produce a different key, so
+     * stale entries are never read. Reading an entry refreshes its modification time, when the
+     * folder is set the least recently used entries are removed until the cache fits in
+     * \c GKC_DECODE_CACHE_MAX_SIZE (stale entries aren't read anymore, they go first).
+     *
+     * An entry holds one or more images plus an optional metadata block (used by animations
+     * to store their frames). When the engine is built with LZ4 (\c GKC_HAS_LZ4) the pixels
+     * are compressed, otherwise they are stored raw.
+     *
+     * Every function is safe to call from the asset loader threads.
+     */
+    class DecodeCache {
+        public:
+            /**
+             * @param folder Folder where the entries are stored, if empty the cache is disabled
+             */
+            static void SetFolder(const path& folder);
+            static const path& GetFolder() { return m_folder; }
+            static bool IsEnabled() { return !m_folder.empty(); }
+
+            /**
+             * @brief Makes the key of an entry
+             * @param data Source file bytes
+             * @param size Number of bytes
+             * @param settings Import settings that change the decoded output
+             * @return Key of the entry
+             */
+            static Uint64 MakeKey(const void* data, size_t size, std::string_view settings);
+
+            /**
+             * @brief Loads an entry
+             * @param key Key of the entry
+             * @param images Decoded images (RGBA32), owned by the caller
+             * @param metadata Metadata stored with the images
+             * @return true if the entry exists and is valid
+             */
+            static bool Load(Uint64 key, vector<SDL_Surface*>& images, vector<Uint8>& metadata);
+
+            /**
+             * @brief Stores an entry, an entry with the same key is replaced
+             * @param key Key of the entry
+             * @param images Decoded images, converted to RGBA32 if needed
+             * @param metadata Metadata stored with the images
+             */
+            static void Store(Uint64 key, const vector<SDL_Surface*>& images, const vector<Uint8>& metadata);
+
+            /**
+             * @brief Same as \c Load() for an entry with a single image and no metadata
+             * @return Decoded image, nullptr if the entry doesn't exist
+             */
+            static SDL_Surface* LoadImage(Uint64 key);
+            static void StoreImage(Uint64 key, SDL_Surface* image);
+
+            /**
+             * @brief Removes the least recently used entries until the cache fits in maxSize,
+             *        and temporary files left by an interrupted \c Store()
+             * @param maxSize Bytes the remaining entries can take
+             */
+            static void Prune(Uint64 maxSize = GKC_DECODE_CACHE_MAX_SIZE);
+
+            /**
+             * @brief Removes every entry
+             */
+            static void Clear();
+        private:
+            static path m_folder;
+
+            static path GetEntryPath(Uint64 key);
+    };
+}
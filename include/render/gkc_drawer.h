@@ -33,9 +33,31 @@ namespace Galaktic::Core::Systems {
 }
 
 namespace Galaktic::Render {
+    inline constexpr size_t GKC_MAX_DIRTY_RECTS = 16;  // More dirty rects than this redraw everything
+
+    /**
+     * @struct DrawSnapshot
+     * @brief Everything needed to draw an entity, used to detect what changed between frames
+     *        in retained mode
+     */
+    struct DrawSnapshot {
+        SDL_FRect rect_{};              // Screen rect
+        SDL_Texture* texture_ = nullptr; // nullptr draws a filled rect with \c color_
+        SDL_FRect source_{};
+        bool hasSource_ = false;
+        SDL_Color color_{};
+
+        bool operator==(const DrawSnapshot& other) const;
+    };
+
     /**
      * @class Drawer
      * @brief Helper to render different things on the scene
+     *
+     * In retained mode the entities are drawn into a persistent canvas (render target) and
+     * only the regions of the entities whose rect, color, texture or animation frame changed
+     * are cleared and redrawn, the canvas is then drawn over the backbuffer with a single call.
+     * Any camera movement or canvas resize redraws the whole canvas.
      */
     class Drawer {
         public:
@@ -47,5 +69,33 @@ namespace Galaktic::Render {
              */
             static void DrawEntities(const unordered_map<EntityID, ECS::Entity>& list, SDL_Renderer* renderer,
                 Core::Systems::CameraSystem& cameraSystem);
+
+            /**
+             * @brief Enables or disables retained mode, the canvas is released when disabled
+             * @param enabled true to draw only what changed
+             */
+            static void SetRetainedMode(bool enabled);
+            static bool IsRetainedMode() { return m_retainedMode; }
+
+            /**
+             * @brief Forces a full redraw of the canvas in the next frame
+             */
+            static void InvalidateCanvas() { m_fullRedraw = true; }
+
+            /**
+             * @brief Destroys the retained canvas, it has to be called before the renderer is destroyed
+             */
+            static void ReleaseCanvas();
+        private:
+            static bool m_retainedMode;
+            static bool m_fullRedraw;
+            static SDL_Texture* m_canvas;
+            static Vec2 m_lastCamera;
+            static vector<std::pair<EntityID, DrawSnapshot>> m_snapshots;
+            static unordered_map<EntityID, DrawSnapshot> m_previousSnapshots;
+
+            static void TakeSnapshots(const unordered_map<EntityID, ECS::Entity>& list, const Vec2& camera);
+            static void DrawRetained(SDL_Renderer* renderer, const Vec2& camera);
+            static bool PrepareCanvas(SDL_Renderer* renderer);
     };
 }
\ No newline at end of file
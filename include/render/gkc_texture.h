@@ -23,6 +23,8 @@
 
 #pragma once
 #include <pch.hpp>
+#include "gkc_atlas.h"
+#include <core/managers/gkc_asset_table.h>
 
 namespace Galaktic::Render {
     /**
@@ -33,15 +35,48 @@ namespace Galaktic::Render {
      * A path has to be provided to load the texture from a file, and open the SDL_Texture using the provided SDL_Renderer.
      * If the path doesn't exist or the texture fails to load, an error is logged and \b HAS to be checked
      * in a function using a Texture object, to avoid undefined behavior. Use \c IsValid() for that.
+     *
+     * A texture can also reference a region of a \c TextureAtlas page, in that case the page
+     * is owned by the atlas and \c GetSourceRect() has to be used as the source rect when rendering.
      */
     class Texture {
         public:
             Texture(const path& path, SDL_Renderer* renderer);
+
+            /**
+             * @brief Uploads an already decoded surface (the surface isn't destroyed)
+             * @param surface Decoded image
+             * @param renderer SDL_Renderer
+             */
+            Texture(SDL_Surface* surface, SDL_Renderer* renderer);
+
+            /**
+             * @brief Creates a texture that references a region of an atlas page
+             * @param page Atlas page (not destroyed with the texture)
+             * @param region Region of the image inside the page
+             */
+            Texture(SDL_Texture* page, const AtlasRegion& region);
             ~Texture();
             [[nodiscard]] SDL_Texture* GetSDLTexture() const { return m_texture; }
             bool IsValid() const { return m_texture != nullptr; }
+
+            /**
+             * @brief Gets the source rect to use when rendering
+             * @return Region inside the atlas page, nullptr if the texture isn't atlased (whole texture)
+             */
+            [[nodiscard]] const SDL_FRect* GetSourceRect() const { return m_isAtlased ? &m_region.rect_ : nullptr; }
+            [[nodiscard]] bool IsAtlased() const { return m_isAtlased; }
+            [[nodiscard]] const AtlasRegion& GetAtlasRegion() const { return m_region; }
+
+            /**
+             * @brief Estimates the VRAM used by the texture
+             * @return Bytes used, 0 for atlased textures (the page belongs to the atlas)
+             */
+            [[nodiscard]] size_t GetMemorySize() const;
         private:
             SDL_Texture* m_texture = nullptr;
+            AtlasRegion m_region;
+            bool m_isAtlased = false;
     };
 
     /**
@@ -50,9 +85,13 @@ namespace Galaktic::Render {
     struct TextureInfo {
         TextureID id_;
         shared_ptr<Texture> texture_;
+        path path_;                     // Used to reload the texture once evicted
+        Uint64 lastUsedFrame_ = 0;
+        size_t bytes_ = 0;
+        bool requested_ = false;        // Queued in the asset loader
     };
 
-    typedef unordered_map<string, shared_ptr<TextureInfo>> Texture_List;
+    typedef Core::Managers::AssetTable<shared_ptr<TextureInfo>> Texture_List;
 
     /**
      * @brief Checks if the file is an image file
@@ -60,6 +99,14 @@ namespace Galaktic::Render {
      * @return true if the file is an image file, false otherwise
      */
     extern bool CheckTextureExtension(const path& path);
+
+    /**
+     * @brief Decodes an image file into a RGBA32 surface, if the \c DecodeCache is enabled
+     *        the pixels are read from it instead when the file didn't change
+     * @param path filepath
+     * @return The surface (destroy it with SDL_DestroySurface), nullptr if it failed to load
+     */
+    extern SDL_Surface* LoadSurface(const path& path);
 }
 
 /**
@@ -0,0 +1,148 @@
+/*
+  Galaktic Engine
+  Copyright (C) 2026 SummerChip
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+#pragma once
+#include <pch.hpp>
+
+namespace Galaktic::Render {
+    inline constexpr Uint32 GKC_TILEMAP_CHUNK_SIZE = 32;     // Tiles per chunk side
+    inline constexpr Uint16 GKC_EMPTY_TILE = 0;              // Tile ID that isn't drawn
+    inline constexpr Uint32 GKC_VERSION_TILEMAP = 1;         // Version of the .gktilemap format
+    inline constexpr Uint32 GKC_TILEMAP_CHUNK_MARGIN = 1;    // Baked chunks kept around the view
+
+    /**
+     * @struct TileLayer
+     * @brief Grid of tile IDs, tile \c n is the \c n-1 tile of the tileset (row by row),
+     *        \c GKC_EMPTY_TILE leaves the cell empty
+     */
+    struct TileLayer {
+        string name_;
+        vector<Uint16> tiles_;
+        bool visible_ = true;
+    };
+
+    /**
+     * @class Tilemap
+     * @brief Static tile layers drawn with a single tileset texture
+     *
+     * The map is split in chunks of \c GKC_TILEMAP_CHUNK_SIZE x \c GKC_TILEMAP_CHUNK_SIZE tiles,
+     * each chunk pre-renders all its visible layers into a render target texture once and
+     * then it's drawn as a single texture. Only the chunks inside the camera view (plus
+     * \c GKC_TILEMAP_CHUNK_MARGIN) are baked and kept, chunks that leave that area are released
+     * and baked again when they come back. Changing a tile only marks its chunk as dirty.
+     *
+     * Tilemaps are saved in a binary file (.gktilemap), the tileset is stored by texture name
+     * and resolved with the \c TextureManager when loading.
+     */
+    class Tilemap {
+        public:
+            /**
+             * @param width Width of the map in tiles
+             * @param height Height of the map in tiles
+             * @param tileSize Size in pixels of a tile (tiles are squares)
+             * @param tileset ID of the tileset texture
+             */
+            Tilemap(Uint32 width, Uint32 height, Uint32 tileSize, TextureID tileset);
+            ~Tilemap();
+
+            Tilemap(const Tilemap&) = delete;
+            Tilemap& operator=(const Tilemap&) = delete;
+
+            /**
+             * @brief Loads a tilemap from a .gktilemap file
+             * @param path Path to the tilemap file
+             * @return The tilemap
+             * @throw ReadingException if the file can't be read or isn't a valid tilemap
+             */
+            static unique_ptr<Tilemap> Load(const path& path);
+
+            /**
+             * @brief Saves the tilemap to a .gktilemap file
+             * @param path Path to the tilemap file
+             * @throw WritingException if the file can't be written
+             */
+            void Save(const path& path) const;
+
+            /**
+             * @brief Adds an empty layer, layers are drawn in the order they were added
+             * @param name Name of the layer
+             * @return Index of the layer
+             */
+            size_t AddLayer(const string& name);
+
+            void SetTile(size_t layer, Uint32 x, Uint32 y, Uint16 tile);
+            [[nodiscard]] Uint16 GetTile(size_t layer, Uint32 x, Uint32 y) const;
+            void SetLayerVisible(size_t layer, bool visible);
+
+            /**
+             * @brief Draws the chunks visible by the camera, dirty chunks are baked first
+             * @param renderer SDL_Renderer
+             * @param camera Location of the camera (top-left corner of the view)
+             * @param viewWidth Width of the view in pixels
+             * @param viewHeight Height of the view in pixels
+             */
+            void Render(SDL_Renderer* renderer, const Vec2& camera, Uint32 viewWidth, Uint32 viewHeight);
+
+            /**
+             * @brief Marks every chunk as dirty (e.g. render targets were lost or the
+             *        tileset was reloaded)
+             */
+            void MarkAllDirty();
+
+            /**
+             * @brief Destroys all baked chunk textures
+             */
+            void ReleaseChunks();
+
+            [[nodiscard]] Uint32 GetWidth() const { return m_width; }
+            [[nodiscard]] Uint32 GetHeight() const { return m_height; }
+            [[nodiscard]] Uint32 GetTileSize() const { return m_tileSize; }
+            [[nodiscard]] TextureID GetTileset() const { return m_tileset; }
+            [[nodiscard]] size_t GetLayerCount() const { return m_layers.size(); }
+            [[nodiscard]] const TileLayer& GetLayer(size_t layer) const { return m_layers[layer]; }
+        private:
+            struct TilemapChunk {
+                SDL_Texture* texture_ = nullptr;
+                bool dirty_ = true;
+            };
+
+            Uint32 m_width;
+            Uint32 m_height;
+            Uint32 m_tileSize;
+            TextureID m_tileset;
+            Uint32 m_chunksX;
+            Uint32 m_chunksY;
+            vector<TileLayer> m_layers;
+            vector<TilemapChunk> m_chunks;
+
+            void BakeChunk(SDL_Renderer* renderer, Uint32 chunkX, Uint32 chunkY);
+            void ReleaseChunksOutside(Uint32 firstX, Uint32 firstY, Uint32 lastX, Uint32 lastY);
+            [[nodiscard]] bool IsInside(Uint32 x, Uint32 y) const { return x < m_width && y < m_height; }
+    };
+
+    /**
+     * @brief Checks if the file is a tilemap file
+     * @param path filepath
+     * @return true if the file is a tilemap file (.gktilemap), false otherwise
+     */
+    extern bool CheckTilemapExtension(const path& path);
+}
@@ -23,6 +23,7 @@
 
 #pragma once
 #include <pch.hpp>
+#include <core/managers/gkc_asset_table.h>
 
 namespace Galaktic::Script {
     class GKC_Script {
@@ -59,7 +60,7 @@ namespace Galaktic::Script {
         ScriptType scriptType_;
     };
     
-    typedef unordered_map<string, ScriptInfo> Script_List;
+    typedef Core::Managers::AssetTable<ScriptInfo> Script_List;
 
     extern bool CheckScriptExtension(const path& path);
 }
\ No newline at end of file
@@ -2,33 +2,105 @@
 #include "core/gkc_exception.h"
 #include "core/gkc_logger.h"
 #include "filesys/gkc_filesys.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_asset_index.h"
+#include "filesys/gkc_writer.h"
 
 using namespace Galaktic;
 
-Audio::AudioFile::AudioFile(const path &filepath, MIX_Mixer* mixer) {
-    if (filepath.empty() || !Filesystem::CheckFile(filepath)) {
+Audio::AudioFile::AudioFile(const path &filepath, MIX_Mixer* mixer, Audio_Mode mode) {
+    if (filepath.empty() || !Filesystem::AssetExists(filepath)) {
         GKC_ENGINE_ERROR("given path doesn't exists!");
         return;
     }
 
-    m_audio = MIX_LoadAudio(mixer, filepath.string().c_str(), true);
+    SDL_IOStream* io = Filesystem::OpenAssetIO(filepath);
+    if (io == nullptr) {
+        GKC_ENGINE_ERROR("failed to load audio!");
+        return;
+    }
+
+    Sint64 size = SDL_GetIOSize(io);
+    m_encodedSize = size > 0 ? static_cast<size_t>(size) : 0;
+    if (mode == Audio_Mode::Auto)
+        mode = ChooseAudioMode(filepath, m_encodedSize);
+    m_streamed = mode == Audio_Mode::Streamed;
+
+    // Without predecoding the mixer keeps the encoded data and every track decodes it in chunks
+    m_audio = MIX_LoadAudio_IO(mixer, io, !m_streamed, true);
     if (m_audio == nullptr) {
         GKC_ENGINE_ERROR("failed to load audio!");
     }
 }
 
+Audio::AudioFile::~AudioFile() {
+    if (m_audio != nullptr) {
+        MIX_DestroyAudio(m_audio);
+        m_audio = nullptr;
+    }
+}
+
+size_t Audio::AudioFile::GetMemorySize() const {
+    if (m_audio == nullptr)
+        return 0;
+    if (m_streamed)
+        return m_encodedSize;
+
+    SDL_AudioSpec spec{};
+    Sint64 frames = MIX_GetAudioDuration(m_audio);
+    if (frames <= 0 || !MIX_GetAudioFormat(m_audio, &spec))
+        return 0;
+    return static_cast<size_t>(frames) * spec.channels * SDL_AUDIO_BYTESIZE(spec.format);
+}
+
 bool Audio::AudioFile::IsValid() const {
     return m_audio != nullptr;
 }
 
-bool Audio::CheckAudioExtension(const path &path) {
-    if (path.empty() || !Filesystem::CheckFile(path)) {
+Audio::Audio_Mode Audio::ChooseAudioMode(const path& path, size_t encodedSize) {
+    auto extension = path.extension().string();
+    // Their encoded data already is PCM, streaming them saves nothing
+    if (extension == ".wav" || extension == ".aiff")
+        return Audio_Mode::Predecoded;
+    return encodedSize <= GKC_AUDIO_PREDECODE_MAX ? Audio_Mode::Predecoded : Audio_Mode::Streamed;
+}
+
+bool Audio::WriteWAV(const path& file, const SDL_AudioSpec& spec, const vector<Uint8>& pcm) {
+    using Filesystem::FileWriter;
+    ofstream output(file, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        GKC_ENGINE_ERROR("Failed to write WAV file: {}", file.string());
         return false;
     }
-    auto pathStr = path.extension().string();
 
-    if (pathStr == ".wav" || pathStr == ".mp3" || pathStr == ".mp2" || pathStr == ".aiff"
-        || pathStr == ".aac" || pathStr == ".ogg") { return true; }
+    const auto bits = static_cast<Uint16>(SDL_AUDIO_BITSIZE(spec.format));
+    const auto channels = static_cast<Uint16>(spec.channels);
+    const auto blockAlign = static_cast<Uint16>(channels * bits / 8);
+    const auto dataSize = static_cast<Uint32>(pcm.size());
+
+    // Samples are written as they are, SDL's native formats are little endian like WAV
+    output.write("RIFF", 4);
+    FileWriter::Write(output, static_cast<Uint32>(36 + dataSize));
+    output.write("WAVEfmt ", 8);
+    FileWriter::Write(output, static_cast<Uint32>(16));
+    FileWriter::Write(output, static_cast<Uint16>(SDL_AUDIO_ISFLOAT(spec.format) ? 3 : 1));
+    FileWriter::Write(output, channels);
+    FileWriter::Write(output, static_cast<Uint32>(spec.freq));
+    FileWriter::Write(output, static_cast<Uint32>(spec.freq) * blockAlign);
+    FileWriter::Write(output, blockAlign);
+    FileWriter::Write(output, bits);
+    output.write("data", 4);
+    FileWriter::Write(output, dataSize);
+    output.write(reinterpret_cast<const char*>(pcm.data()), static_cast<std::streamsize>(pcm.size()));
 
-    return false;
+    if (!output.good()) {
+        GKC_ENGINE_ERROR("Failed to write WAV file: {}", file.string());
+        return false;
+    }
+    return true;
+}
+
+bool Audio::CheckAudioExtension(const path &path) {
+    // The extension goes first, it doesn't touch the disk
+    return Filesystem::IsAssetExtension(path, Filesystem::Asset_Type::Audio) && Filesystem::AssetExists(path);
 }
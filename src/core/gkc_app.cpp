@@ -1,6 +1,9 @@
 #include <core/gkc_app.h>
 #include <core/gkc_logger.h>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_archive.h>
+#include <filesys/gkc_asset_index.h>
+#include <render/gkc_decode_cache.h>
 #include <core/gkc_debugger.h>
 #include <core/gkc_scene.h>
 #include "core/gkc_exception.h"
@@ -9,6 +12,7 @@
 #include <core/managers/gkc_texture_man.h>
 #include <core/managers/gkc_script_man.h>
 #include <core/managers/gkc_animation_man.h>
+#include <core/managers/gkc_hot_reload.h>
 #include <script/gkc_library.h>
 #include <config/gkc_config.h>
 
@@ -47,6 +51,11 @@ App::App(const path& project_path, const string &title)
     Debug::StartLibraries();
     Filesystem::CreateFolder(title);
     Filesystem::CreateAppDirectoryStructure(project_path / title);
+    // Packed builds ship their assets inside .gkpak files next to the project folders
+    Filesystem::MountArchivesInFolder(project_path / title);
+    // The managers list their folders from the index, only the folders that changed are scanned
+    Filesystem::AssetIndex::Open(project_path / title, project_path / title / GKC_CACHE_PATH / Filesystem::GKC_ASSET_INDEX_FILE);
+    Render::DecodeCache::SetFolder(project_path / title / GKC_CACHE_PATH / Render::GKC_DECODE_CACHE_FOLDER);
     ScreenStartup();
     
     GKC_RELEASE_ASSERT(Script::LuaGalaktic::Initialize(), "Failed to initialize Lua!");
@@ -55,10 +64,15 @@ App::App(const path& project_path, const string &title)
     m_managersWrapper = make_unique<ManagersWrapper>();
     GKC_RELEASE_ASSERT(m_managersWrapper != nullptr, "CRITICAL ERROR CREATING MANAGER WRAPPER!");
     m_managersWrapper->m_audioManager = new Managers::AudioManager(path(project_path / title /GKC_SOUND_PATH).string());
-    m_managersWrapper->m_textureManager = new Managers::TextureManager(path(project_path / title / GKC_TEXTURE_PATH).string());
+    m_managersWrapper->m_textureManager = new Managers::TextureManager(path(project_path / title / GKC_TEXTURE_PATH).string(),
+        project_path / title / GKC_CACHE_PATH);
     m_managersWrapper->m_scriptManager = new Managers::ScriptManager(path(project_path / title / GKC_SCRIPT_PATH).string(), Script::LuaGalaktic::GetLuaState());
     m_managersWrapper->m_animationManager = new Managers::AnimationManager(path(project_path / title / GKC_ANIMATION_PATH).string());
 
+    #if GKC_DEBUG
+        Managers::HotReloadManager::Start(project_path / title);
+    #endif
+
     // Execute scripts to init managers
 
     m_sceneManager = new Managers::SceneManager(project_path / title, m_managersWrapper.get(), m_deviceInfo);
@@ -0,0 +1,105 @@
+#include <core/gkc_hash.h>
+
+// SSE 4.2 is checked at runtime, the ARMv8 crc32 extension is known when compiling
+#if defined(__x86_64__) || defined(__amd64__) || defined(_M_X64)
+    #include <nmmintrin.h>
+    #define GKC_HAS_CRC32_INSTRUCTION 1
+    #define GKC_CRC32_SSE42 1
+#elif defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define GKC_HAS_CRC32_INSTRUCTION 1
+#elif defined(_M_ARM64)
+    #include <intrin.h>
+    #define GKC_HAS_CRC32_INSTRUCTION 1
+#else
+    #define GKC_HAS_CRC32_INSTRUCTION 0
+#endif
+
+using namespace Galaktic;
+
+namespace {
+    constexpr Uint32 GKC_CRC32C_POLYNOMIAL = 0x82f63b78u;     // Reversed Castagnoli polynomial
+
+    // 8 tables so the software path handles 8 bytes per step (slicing by 8)
+    constexpr array<array<Uint32, 256>, 8> MakeCRC32CTables() {
+        array<array<Uint32, 256>, 8> tables{};
+        for (Uint32 i = 0; i < 256; ++i) {
+            Uint32 crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (GKC_CRC32C_POLYNOMIAL & (0u - (crc & 1u)));
+            tables[0][i] = crc;
+        }
+        for (Uint32 i = 0; i < 256; ++i) {
+            for (size_t t = 1; t < tables.size(); ++t)
+                tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xff];
+        }
+        return tables;
+    }
+
+    constexpr auto CRC32C_TABLES = MakeCRC32CTables();
+
+    // The 8 bytes are read as a little endian word, big endian CPUs would need to swap them
+    Uint32 SoftwareCRC32C(const Uint8* bytes, size_t size, Uint32 crc) {
+        while (size >= 8) {
+            Uint64 word = 0;
+            std::memcpy(&word, bytes, sizeof(word));
+            word ^= crc;
+            crc = CRC32C_TABLES[7][word & 0xff] ^ CRC32C_TABLES[6][(word >> 8) & 0xff]
+                ^ CRC32C_TABLES[5][(word >> 16) & 0xff] ^ CRC32C_TABLES[4][(word >> 24) & 0xff]
+                ^ CRC32C_TABLES[3][(word >> 32) & 0xff] ^ CRC32C_TABLES[2][(word >> 40) & 0xff]
+                ^ CRC32C_TABLES[1][(word >> 48) & 0xff] ^ CRC32C_TABLES[0][word >> 56];
+            bytes += 8;
+            size -= 8;
+        }
+        while (size-- > 0)
+            crc = (crc >> 8) ^ CRC32C_TABLES[0][(crc ^ *bytes++) & 0xff];
+        return crc;
+    }
+
+#if defined(GKC_CRC32_SSE42)
+    #if !defined(_MSC_VER) || defined(__clang__)
+    __attribute__((target("sse4.2")))
+    #endif
+    Uint32 HardwareCRC32C(const Uint8* bytes, size_t size, Uint32 crc) {
+        Uint64 crc64 = crc;
+        while (size >= 8) {
+            Uint64 word = 0;
+            std::memcpy(&word, bytes, sizeof(word));
+            crc64 = _mm_crc32_u64(crc64, word);
+            bytes += 8;
+            size -= 8;
+        }
+        crc = static_cast<Uint32>(crc64);
+        while (size-- > 0)
+            crc = _mm_crc32_u8(crc, *bytes++);
+        return crc;
+    }
+
+    const bool HAS_CRC32_INSTRUCTION = SDL_HasSSE42();
+#elif GKC_HAS_CRC32_INSTRUCTION
+    Uint32 HardwareCRC32C(const Uint8* bytes, size_t size, Uint32 crc) {
+        while (size >= 8) {
+            Uint64 word = 0;
+            std::memcpy(&word, bytes, sizeof(word));
+            crc = __crc32cd(crc, word);
+            bytes += 8;
+            size -= 8;
+        }
+        while (size-- > 0)
+            crc = __crc32cb(crc, *bytes++);
+        return crc;
+    }
+
+    constexpr bool HAS_CRC32_INSTRUCTION = true;
+#endif
+}
+
+Uint32 Core::HashCRC32C(const void* data, size_t size, Uint32 previous) {
+    const auto* bytes = static_cast<const Uint8*>(data);
+    const Uint32 crc = ~previous;
+#if GKC_HAS_CRC32_INSTRUCTION
+    if (HAS_CRC32_INSTRUCTION)
+        return ~HardwareCRC32C(bytes, size, crc);
+#endif
+    return ~SoftwareCRC32C(bytes, size, crc);
+}
@@ -20,12 +20,21 @@
 #include "core/systems/gkc_window_system.h"
 #include "core/systems/gkc_ecs_event_system.h"
 #include "core/systems/gkc_script_system.h"
+#include "core/systems/gkc_animation_system.h"
+#include "core/systems/gkc_audio_system.h"
 #include "filesys/gkc_writer.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_scene_journal.h"
+#include "filesys/gkc_scene_saver.h"
 #include "render/gkc_drawer.h"
+#include "render/gkc_tilemap.h"
 #include "script/gkc_script.h"
 #include "core/helpers/gkc_texture_helper.h"
 #include "core/helpers/gkc_animation_helper.h" 
 #include "core/managers/gkc_animation_man.h"
+#include "core/managers/gkc_hot_reload.h"
+#include "core/managers/gkc_asset_loader.h"
+#include "core/managers/gkc_world_streamer.h"
 #include "script/gkc_library.h"
 #include "ecs/gkc_component_registry.h"
 
@@ -54,6 +63,7 @@ Scene::Scene(const string& name, ManagersWrapper* wrapper, const DeviceInformati
 
     // Managers Initialization
     m_registry = new ECS::Registry();
+    m_registry->SetChangeTracking(true);
     m_systemList.reserve(GKC_SYSTEMS_COUNTER);
     m_ecsManager = new Managers::ECS_Manager(m_registry);
     m_ecsHelper = new Helpers::ECS_Helper(m_ecsManager);
@@ -79,6 +89,8 @@ Scene::Scene(const string& name, ManagersWrapper* wrapper, const DeviceInformati
     auto window_system = make_shared<Systems::WindowSystem>();
     auto camera_system = make_shared<Systems::CameraSystem>(camera);
     auto entity_event_system = make_shared<Systems::ECS_EventSystem>(*m_ecsManager);
+    auto animation_system = make_shared<Systems::AnimationSystem>(*m_registry);
+    auto audio_system = make_shared<Systems::AudioSystem>(*m_registry);
 
     //@FIX ME use following only a camera
     camera_system->SetFollowEntity(2);
@@ -93,6 +105,8 @@ Scene::Scene(const string& name, ManagersWrapper* wrapper, const DeviceInformati
     m_systemList.emplace("WindowSystem",window_system);             // 5
     m_systemList.emplace("CameraSystem", camera_system);            // 6
     m_systemList.emplace("EntityEventSystem", entity_event_system); // 7
+    m_systemList.emplace("AnimationSystem", animation_system);      // 8
+    m_systemList.emplace("AudioSystem", audio_system);              // 9
     m_appPath = path.filename();
     
     GKC_RELEASE_ASSERT(m_registry != nullptr, "Failed to create entity manager!");
@@ -105,6 +119,9 @@ Scene::Scene(const string& name, ManagersWrapper* wrapper, const DeviceInformati
 Scene::~Scene() {
     // CRITICAL FIX: Properly destroy all allocated resources
     GKC_ENGINE_INFO("Cleaning up scene resources...");
+
+    // Streamed cells are unloaded before the worker loses the registered component types
+    m_worldStreamer.reset();
     
     // Clear all entities and their components first
     auto& entityList = m_ecsManager->GetEntityList();
@@ -117,6 +134,8 @@ Scene::~Scene() {
     }
     
     // Clear component registry
+    SceneSaver::Stop();
+    SceneJournal::WaitForCompaction();
     ECS::ComponentRegistry::Clear();
     
     // Delete helper objects
@@ -128,6 +147,12 @@ Scene::~Scene() {
     delete m_ecsManager;
     delete m_registry;
     
+    // Atlas pages and tilemap chunks have to be destroyed before the renderer
+    Managers::AssetLoader::Stop();
+    m_tilemap.reset();
+    Render::Drawer::ReleaseCanvas();
+    m_managerWrapper->m_textureManager->DestroyAtlas();
+
     // Delete Window Manager
     delete m_windowManager;
     
@@ -150,22 +175,30 @@ void Scene::Run()  {
     auto movement_system = m_systemList.find("MovementSystem")->second;
     auto camera_system = m_systemList.find("CameraSystem")->second;
     auto ecsEventSystem = m_systemList.find("EntityEventSystem")->second;
+    auto animation_system = m_systemList.find("AnimationSystem")->second;
+    auto audio_system = m_systemList.find("AudioSystem")->second;
 
     // Used only in rendering
     auto camera_systemPtr = std::dynamic_pointer_cast<Systems::CameraSystem>(camera_system);
+    // The listener follows the active camera
+    auto audio_systemPtr = std::dynamic_pointer_cast<Systems::AudioSystem>(audio_system);
 
     GKC_RELEASE_ASSERT(camera_systemPtr != nullptr || camera_system != nullptr, "CameraSystem is NULL!");
     GKC_RELEASE_ASSERT(physics_system != nullptr, "physics_system is NULL!");
     GKC_RELEASE_ASSERT(movement_system != nullptr, "movement_system is NULL!");
     GKC_RELEASE_ASSERT(ecsEventSystem != nullptr, "entity_event_system is NULL!");
+    GKC_RELEASE_ASSERT(animation_system != nullptr, "animation_system is NULL!");
+    GKC_RELEASE_ASSERT(audio_systemPtr != nullptr, "audio_system is NULL!");
 
     // @TODO Add a modifiable function to edit
     // Add Debug Information
     Debug::Console::SetRenderer(GKC_GET_RENDERER(m_window));
     strcpy(Debug::Console::GetDebugInformation()->engine_name_, Debug::Logger::GetEngineName().c_str());
 
-    m_managerWrapper->m_textureManager->LoadAllTextures(GKC_GET_RENDERER(m_window));
-    m_managerWrapper->m_animationManager->LoadAllAnimations(GKC_GET_RENDERER(m_window));
+    // Assets are decoded in the background, the missing texture is shown until they are uploaded
+    Managers::AssetLoader::Start();
+    m_managerWrapper->m_textureManager->LoadAllTexturesAsync(GKC_GET_RENDERER(m_window));
+    m_managerWrapper->m_animationManager->LoadAllAnimationsAsync(GKC_GET_RENDERER(m_window));
     
     auto& player = m_ecsHelper->GetEntityByName("Player");
     auto& player_transform = player.Get<ECS::TransformComponent>();
@@ -190,8 +223,15 @@ void Scene::Run()  {
         Debug::Console::GetDebugInformation()->y_coordinate_ = player_transform.m_location.y;
 
         m_window->PollEvents();
+        if (m_autosaveInterval > 0.0) {
+            m_autosaveTimer += delta_time;
+            if (m_autosaveTimer >= m_autosaveInterval) {
+                m_autosaveTimer = 0.0;
+                SaveIncremental();
+            }
+        }
         if (m_window->ShouldClose()) {
-            Save();
+            SaveIncremental();
             Close();
         }
 
@@ -206,11 +246,28 @@ void Scene::Run()  {
             accumulator -= FIXED_DELTA_TIME;
         }
 
+        Managers::HotReloadManager::Update(GKC_GET_RENDERER(m_window));
+        Managers::AssetLoader::Pump(GKC_GET_RENDERER(m_window));
+        Managers::AssetBudget::Update();
+        animation_system->Update(static_cast<float>(delta_time));
+
+        auto& listener = camera_systemPtr->GetActiveCamera().Read<ECS::CameraComponent>();
+        const Render::Vec2 viewCenter = { listener.m_location.x + static_cast<float>(m_window->GetWidth()) * 0.5f,
+            listener.m_location.y + static_cast<float>(m_window->GetHeight()) * 0.5f };
+        audio_systemPtr->SetListener(viewCenter);
+        if (m_worldStreamer != nullptr)
+            m_worldStreamer->Update(viewCenter);
+        audio_system->Update(static_cast<float>(delta_time));
+
         // Drawer Functions
         m_window->Draw(GKC_GET_RENDERER(m_window));
+        if (m_tilemap != nullptr) {
+            auto& camera = camera_systemPtr->GetActiveCamera().Read<ECS::CameraComponent>();
+            m_tilemap->Render(GKC_GET_RENDERER(m_window), camera.m_location,
+                m_window->GetWidth(), m_window->GetHeight());
+        }
         Render::Drawer::DrawEntities(m_ecsManager->GetEntityList(), GKC_GET_RENDERER(m_window),
             *camera_systemPtr);
-        m_managerWrapper->m_animationManager->UpdateAll(delta_time);
 
         if (Debug::Console::GetIsActive()) {
             Debug::Console::CallConsole();
@@ -221,8 +278,54 @@ void Scene::Run()  {
 }
 
 void Scene::Save() {
+    // Queued saves or a compaction finishing after this save would replace it
+    SceneSaver::Flush();
+    SceneJournal::WaitForCompaction();
+    if (m_worldStreamer != nullptr) {
+        m_worldStreamer->CollectChanges();
+        m_worldStreamer->SaveOverlay();
+    }
     FileWriter::WriteScene(m_appPath / path(m_sceneInfo.scene_name_ + ".gkscene")
-        , *this, m_registry);
+        , *this, m_registry, m_compression);
+    SceneJournal::Discard(GetScenePath());
+    m_registry->ClearChanges();
+    m_sceneInfo.snapshot_saved_ = true;
+}
+
+void Scene::SaveIncremental() {
+    // The streamed entities are saved with their world, it's only written when they changed
+    if (m_worldStreamer != nullptr) {
+        m_worldStreamer->CollectChanges();
+        m_worldStreamer->SaveOverlay();
+    }
+
+    // A failed background save lost its changes, only a full save brings them back
+    const bool full = !m_sceneInfo.snapshot_saved_ || SceneSaver::ConsumeFailure();
+    if (!full && !m_registry->HasChanges())
+        return;
+
+    SceneSaver::SaveAsync(SceneSaver::Capture(GetScenePath(), m_sceneInfo.scene_name_,
+        GetSavedEntities(), m_registry, full, m_compression));
+    m_sceneInfo.snapshot_saved_ = true;
+}
+
+const ECS::Entity_List& Scene::GetSavedEntities() {
+    const auto& entities = m_ecsManager->GetEntityList();
+    if (m_worldStreamer == nullptr || !m_worldStreamer->IsOpen())
+        return entities;
+
+    // Reused between saves, only its buckets stay allocated
+    m_savedEntities.clear();
+    m_savedEntities.reserve(entities.size());
+    for (const auto& [id, entity] : entities) {
+        if (!m_worldStreamer->IsStreamed(id))
+            m_savedEntities.emplace(id, entity);
+    }
+    return m_savedEntities;
+}
+
+path Scene::GetScenePath() const {
+    return m_appPath / GKC_SCENE_PATH / path(m_sceneInfo.scene_name_ + ".gkscene");
 }
 
 void Scene::OnEvent(Events::GKC_Event& event) {
@@ -274,7 +377,27 @@ void Scene::CreateCamera(const string& name) {
     m_ecsHelper->CreateCameraEntity(name);
     m_ecsHelper->ModifyEntity(name, cameraComponent);
 }
+bool Scene::LoadTilemap(const string& name) {
+    try {
+        m_tilemap = Render::Tilemap::Load(m_appPath / GKC_TILEMAP_PATH / name);
+    } catch (const Debug::ReadingException& e) {
+        GKC_ENGINE_ERROR("Failed to load tilemap '{0}': {1}", name, e.what());
+        return false;
+    }
+    return true;
+}
+
+bool Scene::StreamWorld(const string& name, float loadRadius) {
+    if (m_worldStreamer == nullptr)
+        m_worldStreamer = make_unique<Managers::WorldStreamer>(*m_ecsManager, *m_registry);
+
+    m_worldStreamer->SetRadius(loadRadius, loadRadius * 1.5f);
+    return m_worldStreamer->Open(m_appPath / GKC_SCENE_PATH / name);
+}
+
 void Scene::Close() {
+    // The process exits right after, queued saves have to be on the disk
+    SceneSaver::Stop();
     Free();
     m_isRunning = false;
     exit(0);
@@ -25,7 +25,11 @@ void AnimationHelper::SetAnimationToEntity(EntityID id, const string& animationN
     
     if(entity->Has<ECS::AnimationComponent>()) {
         auto& animationComp = entity->Get<ECS::AnimationComponent>();
-        animationComp.m_id = animationID;
+        if (animationComp.m_id != animationID) {
+            // Playback starts again with the new animation
+            animationComp = ECS::AnimationComponent(animationID, animationComp.m_isLooping,
+                animationComp.m_speed);
+        }
     } else {
         m_ecsManager.AddComponentToEntity<ECS::AnimationComponent>(id, animationID);
     }   
@@ -1,7 +1,10 @@
 #include <core/managers/gkc_animation_man.h>
 #include <render/gkc_animation.h>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_asset_index.h>
 #include <core/gkc_logger.h>
+#include <core/managers/gkc_asset_loader.h>
+#include <core/managers/gkc_asset_budget.h>
 
 using namespace Galaktic::Core;
 using namespace Galaktic::Core::Managers;
@@ -9,43 +12,42 @@ using namespace Galaktic::Render;
 
 Galaktic::Render::Animation_List Managers::AnimationManager::m_animationList;
 vector<path> Managers::AnimationManager::m_animationPathList;
-Galaktic::Render::AnimationID_List Managers::AnimationManager::m_IDToNameList;
+int Managers::AnimationManager::m_maxSheetSize = 0;
 
 AnimationManager::AnimationManager(const string& folderPath) {
-    auto files = Filesystem::GetFilenamesInFolder(folderPath);
-    for (auto& file : files) {
-        if (Render::CheckAnimationExtension(file))
-            AddAnimationPath(file);
-    }
+    for (auto& file : Filesystem::AssetIndex::GetFiles(folderPath, Filesystem::Asset_Type::Animation))
+        AddAnimationPath(file);
 }
 
 void AnimationManager::AddAnimation(const string& filePath, SDL_Renderer* renderer) {
-    AnimationID id = m_animationList.size() + 1;
-    auto info = make_shared<Render::AnimationInfo>(id, make_shared<Render::Animation>(filePath, renderer));
+    auto info = make_shared<Render::AnimationInfo>(0, make_shared<Render::Animation>(filePath, renderer));
     
-    if (!info->animation_->IsValid() || info->id_ == 0) {
+    if (!info->animation_->IsValid()) {
         GKC_ENGINE_ERROR("Failed to load animation at path: {0}", filePath);
         return;
     }
+    info->path_ = filePath;
+    info->bytes_ = info->animation_->GetMemorySize();
     
-    auto [it, inserted] = m_animationList.emplace(Filesystem::GetFilename(filePath), std::move(info));
-    m_IDToNameList.emplace(id, Filesystem::GetFilename(filePath));
+    info->id_ = m_animationList.Insert(Filesystem::GetFilename(filePath), info);
+    if (info->id_ == 0) {
+        GKC_ENGINE_ERROR("Failed to load animation at path: {0}", filePath);
+        return;
+    }
     m_animationPathList.emplace_back(filePath);
     
     GKC_ENGINE_INFO("'{}' animation added and loaded successfully!", filePath);
 }
 
 void AnimationManager::AddAnimationPath(const string& filePath) {
-    AnimationID id = m_animationList.size() + 1;
-    auto info = make_shared<Render::AnimationInfo>(id, nullptr);
+    auto info = make_shared<Render::AnimationInfo>(0, nullptr);
+    info->path_ = filePath;
     
-    if (info == nullptr || info->id_ == 0) {
+    info->id_ = m_animationList.Insert(Filesystem::GetFilename(filePath), info);
+    if (info->id_ == 0) {
         GKC_ENGINE_ERROR("Failed to add animation at path: {0}", filePath);
         return;
     }
-    
-    auto [it, inserted] = m_animationList.emplace(Filesystem::GetFilename(filePath), std::move(info));
-    m_IDToNameList.emplace(id, Filesystem::GetFilename(filePath));
     m_animationPathList.emplace_back(filePath);
     
     GKC_ENGINE_INFO("'{}' animation added successfully!", filePath);
@@ -54,10 +56,9 @@ void AnimationManager::AddAnimationPath(const string& filePath) {
 
 void AnimationManager::LoadAnimation(const string& filePath, SDL_Renderer* renderer) {
     string animationName = Filesystem::GetFilename(filePath);
-    auto it = m_animationList.find(animationName);
+    auto* info = m_animationList.Find(animationName);
     
-    if (it != m_animationList.end()) {
-        AnimationID id = it->second->id_;
+    if (info != nullptr) {
         auto animation = make_shared<Render::Animation>(filePath, renderer);
         if (animation == nullptr) {
             GKC_ENGINE_ERROR("Failed to load animation at path: {0}", filePath);
@@ -69,7 +70,8 @@ void AnimationManager::LoadAnimation(const string& filePath, SDL_Renderer* rende
             }
         }
         
-        it->second->animation_ = std::move(animation);
+        (*info)->bytes_ = animation->GetMemorySize();
+        (*info)->animation_ = std::move(animation);
         GKC_ENGINE_INFO("'{}' animation loaded successfully", animationName);
     } else {
         AddAnimation(filePath, renderer);
@@ -83,42 +85,102 @@ void AnimationManager::LoadAllAnimations(SDL_Renderer* renderer) {
     PrintList();
 }
 
+void AnimationManager::LoadAllAnimationsAsync(SDL_Renderer* renderer) {
+    m_maxSheetSize = Render::Animation::GetMaxSheetSize(renderer);
+    for (auto& path : m_animationPathList) {
+        auto* info = m_animationList.Find(Filesystem::GetFilename(path));
+        if (info != nullptr) {
+            if ((*info)->animation_ != nullptr || (*info)->requested_)
+                continue;
+            (*info)->requested_ = true;
+        }
+        AssetLoader::QueueAnimation(path, m_maxSheetSize);
+    }
+}
+
+void AnimationManager::FinishAnimation(const path& filePath, Render::BakedAnimation* baked,
+    SDL_Renderer* renderer) {
+    string animationName = Filesystem::GetFilename(filePath);
+    if (auto* info = m_animationList.Find(animationName))
+        (*info)->requested_ = false;
+
+    if (baked == nullptr) {
+        GKC_ENGINE_ERROR("Failed to load animation at path: {0}", filePath.string());
+        return;
+    }
+
+    auto animation = make_shared<Render::Animation>(*baked, renderer);
+    if (!animation->IsValid()) {
+        GKC_ENGINE_ERROR("Failed to load animation at path: {0}", filePath.string());
+        return;
+    }
+
+    auto* info = m_animationList.Find(animationName);
+    if (info == nullptr) {
+        AddAnimationPath(filePath.string());
+        info = m_animationList.Find(animationName);
+        if (info == nullptr)
+            return;
+    }
+    (*info)->bytes_ = animation->GetMemorySize();
+    (*info)->animation_ = std::move(animation);
+    GKC_ENGINE_INFO("'{}' animation loaded successfully", animationName);
+}
+
+void AnimationManager::ReloadAnimation(const path& filePath, SDL_Renderer* renderer) {
+    string animationName = Filesystem::GetFilename(filePath);
+    auto* info = m_animationList.Find(animationName);
+    if (info == nullptr) {
+        AddAnimationPath(filePath.string());
+        info = m_animationList.Find(animationName);
+        if (info == nullptr)
+            return;
+    }
+
+    GKC_ENGINE_INFO("Reloading animation '{}'", animationName);
+    if (AssetLoader::IsRunning() && m_maxSheetSize > 0) {
+        (*info)->requested_ = true;
+        AssetLoader::QueueAnimation(filePath, m_maxSheetSize);
+    } else {
+        LoadAnimation(filePath.string(), renderer);
+    }
+}
+
 void AnimationManager::DeleteAnimation(const string& name) {
-    auto animation = m_animationList.find(name);
-    if (animation != m_animationList.end()) {
-        m_IDToNameList.erase(animation->second->id_);
-        m_animationList.erase(animation);
+    if (m_animationList.Erase(name)) {
         GKC_ENGINE_INFO("Erased {0}", name);
     }
 }
 
 shared_ptr<Animation> AnimationManager::GetAnimation(const string& name) {
-    auto animation = m_animationList.find(name);
-    if (animation != m_animationList.end()) {
-        if (animation->second != nullptr && animation->second->animation_ != nullptr) {
-            return animation->second->animation_;
-        }
-        GKC_ENGINE_WARNING("Animation key exists but hasn't been loaded yet!");
+    AnimationID id = m_animationList.FindID(name);
+    if (id == 0) {
+        GKC_ENGINE_WARNING("Animation to retrieve doesn't exist!");
         return nullptr;
     }
-    GKC_ENGINE_WARNING("Animation to retrieve doesn't exist!");
-    return nullptr;
+    return GetAnimation(id);
 }
 
 shared_ptr<Animation> AnimationManager::GetAnimation(AnimationID id) {
-    auto nameToFind = m_IDToNameList.find(id);
-    if (nameToFind != m_IDToNameList.end()) {
-        return GetAnimation(nameToFind->second);
+    auto* animation = m_animationList.Get(id);
+    if (animation == nullptr) {
+        GKC_ENGINE_WARNING("Animation to retrieve doesn't exist");
+        return nullptr;
     }
-    GKC_ENGINE_WARNING("Animation to retrieve doesn't exist");
+    if (*animation != nullptr) {
+        Touch(**animation);
+        if ((*animation)->animation_ != nullptr)
+            return (*animation)->animation_;
+    }
+    GKC_ENGINE_WARNING("Animation key exists but hasn't been loaded yet!");
     return nullptr;
 }
 
 shared_ptr<AnimationInfo> AnimationManager::GetAnimationInfo(const string& name) {
-    auto it = m_animationList.find(name);
-    if (it != m_animationList.end()) {
-        if (it->second != nullptr) {
-            return it->second;
+    auto* info = m_animationList.Find(name);
+    if (info != nullptr) {
+        if (*info != nullptr) {
+            return *info;
         }
         GKC_ENGINE_WARNING("Animation Information is NULL!");
         return nullptr;
@@ -127,26 +189,64 @@ shared_ptr<AnimationInfo> AnimationManager::GetAnimationInfo(const string& name)
     return nullptr;
 }
 
-void AnimationManager::UpdateAll(float deltaTime) {
-    for (auto& [name, info] : m_animationList) {
-        if (info && info->animation_) {
-            info->animation_->Update(deltaTime);
-        }
+shared_ptr<Animation> AnimationManager::FindAnimation(AnimationID id) {
+    auto* animation = m_animationList.Get(id);
+    if (animation == nullptr || *animation == nullptr)
+        return nullptr;
+    Touch(**animation);
+    return (*animation)->animation_;
+}
+
+AssetHandle<Animation> AnimationManager::AcquireAnimation(AnimationID id) {
+    return AssetHandle<Animation>(id, FindAnimation(id));
+}
+
+void AnimationManager::Evict(size_t budget) {
+    size_t total = 0;
+    vector<EvictionCandidate> candidates;
+    m_animationList.ForEach([&](const string& name, auto& info) {
+        if (info->animation_ == nullptr)
+            return;
+        total += info->bytes_;
+        if (info->animation_.use_count() > 1)
+            return;
+        candidates.emplace_back(name, info->lastUsedFrame_, info->bytes_);
+    });
+
+    auto evicted = AssetBudget::SelectEvictions(candidates, total, budget);
+    for (auto& name : evicted) {
+        auto& info = *m_animationList.Find(name);
+        info->animation_ = nullptr;
+        info->bytes_ = 0;
+        info->requested_ = false;
+    }
+
+    if (!evicted.empty())
+        GKC_ENGINE_INFO("Evicted {0} animations to fit the {1} bytes budget", evicted.size(), budget);
+}
+
+void AnimationManager::Touch(AnimationInfo& info) {
+    info.lastUsedFrame_ = AssetBudget::GetFrame();
+    // Evicted animations are reloaded in the background
+    if (info.animation_ == nullptr && !info.requested_ && !info.path_.empty()
+        && m_maxSheetSize > 0 && AssetLoader::IsRunning()) {
+        info.requested_ = true;
+        AssetLoader::QueueAnimation(info.path_, m_maxSheetSize);
     }
 }
 
 void AnimationManager::PrintList() {
-    for (auto& pair : m_animationList) {
-        const void* animationAddress = TakeAddressOfAnimation(pair.second.get());
+    m_animationList.ForEach([](const string& name, auto& info) {
+        const void* animationAddress = TakeAddressOfAnimation(info.get());
         
         if (animationAddress == nullptr) {
             GKC_ENGINE_INFO("Key: {0} | {1} Address: {2}", 
-                pair.first, pair.second->id_, "nullptr (needs to be loaded)");
+                name, info->id_, "nullptr (needs to be loaded)");
         } else {
             GKC_ENGINE_INFO("Key: {0} | {1} Address: {2}", 
-                pair.first, pair.second->id_, animationAddress);
+                name, info->id_, animationAddress);
         }
-    }
+    });
 }
 
 const void* AnimationManager::TakeAddressOfAnimation(const Render::AnimationInfo* animInfo) {
@@ -0,0 +1,64 @@
+#include <core/managers/gkc_asset_budget.h>
+#include "core/gkc_logger.h"
+#include "core/managers/gkc_texture_man.h"
+#include "core/managers/gkc_animation_man.h"
+#include "core/managers/gkc_audio_man.h"
+
+using namespace Galaktic::Core;
+using namespace Galaktic::Core::Managers;
+
+array<size_t, static_cast<size_t>(Asset_Class::Count)> AssetBudget::m_budgets{};
+Uint64 AssetBudget::m_frame = 1;
+
+void AssetBudget::SetBudget(Asset_Class type, size_t bytes) {
+    GKC_ASSERT(type != Asset_Class::Count, "Invalid asset class!");
+    m_budgets[static_cast<size_t>(type)] = bytes;
+}
+
+size_t AssetBudget::GetBudget(Asset_Class type) {
+    GKC_ASSERT(type != Asset_Class::Count, "Invalid asset class!");
+    return m_budgets[static_cast<size_t>(type)];
+}
+
+void AssetBudget::Update() {
+    ++m_frame;
+    if (m_frame % GKC_ASSET_COLLECT_INTERVAL == 0) {
+        Collect();
+    }
+}
+
+void AssetBudget::Collect() {
+    if (size_t budget = GetBudget(Asset_Class::Texture); budget > 0) {
+        TextureManager::Evict(budget);
+    }
+    if (size_t budget = GetBudget(Asset_Class::Animation); budget > 0) {
+        AnimationManager::Evict(budget);
+    }
+    if (size_t budget = GetBudget(Asset_Class::Audio); budget > 0) {
+        AudioManager::Evict(budget);
+    }
+}
+
+vector<string> AssetBudget::SelectEvictions(vector<EvictionCandidate>& candidates, size_t totalBytes,
+    size_t budget) {
+    vector<string> evicted;
+    if (totalBytes <= budget)
+        return evicted;
+
+    std::sort(candidates.begin(), candidates.end(), [](const EvictionCandidate& a, const EvictionCandidate& b) {
+        return a.lastUsedFrame_ < b.lastUsedFrame_;
+    });
+
+    // Update() runs before the frame draws, the previous frame's assets are the working set
+    for (auto& candidate : candidates) {
+        if (totalBytes <= budget || candidate.lastUsedFrame_ + 1 >= m_frame)
+            break;
+        totalBytes -= std::min(totalBytes, candidate.bytes_);
+        evicted.push_back(candidate.name_);
+    }
+
+    if (totalBytes > budget) {
+        GKC_ENGINE_WARNING("Assets in use don't fit in the budget ({0} bytes over)", totalBytes - budget);
+    }
+    return evicted;
+}
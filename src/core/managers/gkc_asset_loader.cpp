@@ -0,0 +1,206 @@
+#include <core/managers/gkc_asset_loader.h>
+#include "core/gkc_logger.h"
+#include "core/managers/gkc_texture_man.h"
+#include "core/managers/gkc_animation_man.h"
+#include "render/gkc_animation.h"
+#include "render/gkc_atlas.h"
+#include "render/gkc_texture.h"
+
+using namespace Galaktic::Core;
+using namespace Galaktic::Core::Managers;
+
+vector<std::thread> AssetLoader::m_workers;
+std::deque<AssetLoader::LoadRequest> AssetLoader::m_requests;
+std::deque<AssetLoader::LoadResult> AssetLoader::m_results;
+std::mutex AssetLoader::m_requestMutex;
+std::mutex AssetLoader::m_resultMutex;
+std::condition_variable AssetLoader::m_condition;
+std::atomic<size_t> AssetLoader::m_pending = 0;
+bool AssetLoader::m_stop = false;
+
+void AssetLoader::Start(size_t threadCount) {
+    if (IsRunning())
+        return;
+
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    {
+        std::lock_guard lock(m_requestMutex);
+        m_stop = false;
+    }
+
+    m_workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&AssetLoader::WorkerLoop);
+    }
+    GKC_ENGINE_INFO("Asset loader started with {0} worker/s", threadCount);
+}
+
+void AssetLoader::Stop() {
+    if (!IsRunning())
+        return;
+
+    {
+        std::lock_guard lock(m_requestMutex);
+        m_stop = true;
+        m_requests.clear();
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+
+    std::lock_guard lock(m_resultMutex);
+    for (auto& result : m_results) {
+        Discard(result);
+    }
+    m_results.clear();
+    m_pending = 0;
+    GKC_ENGINE_INFO("Asset loader stopped");
+}
+
+void AssetLoader::QueueTexture(const path& path) {
+    Queue({Asset_Type::Texture, path, 0});
+}
+
+void AssetLoader::QueueAnimation(const path& path, int maxSheetSize) {
+    Queue({Asset_Type::Animation, path, maxSheetSize});
+}
+
+void AssetLoader::QueueAtlas(const vector<path>& files, const path& cacheFolder) {
+    GKC_ASSERT(IsRunning(), "Asset loader has to be started before queueing assets!");
+    auto batch = make_shared<AtlasBatch>();
+    batch->cacheFolder_ = cacheFolder;
+    batch->images_.reserve(files.size());
+    for (auto& file : files)
+        batch->images_.push_back({file, nullptr});
+
+    // An empty atlas still needs a request to be packed and finished
+    const size_t count = std::max<size_t>(files.size(), 1);
+    batch->remaining_ = count;
+    {
+        std::lock_guard lock(m_requestMutex);
+        for (size_t i = 0; i < count; ++i)
+            m_requests.push_back({Asset_Type::TextureAtlas, cacheFolder, 0, batch, i});
+    }
+    ++m_pending;
+    m_condition.notify_all();
+}
+
+void AssetLoader::Queue(LoadRequest request) {
+    GKC_ASSERT(IsRunning(), "Asset loader has to be started before queueing assets!");
+    {
+        std::lock_guard lock(m_requestMutex);
+        m_requests.push_back(std::move(request));
+    }
+    ++m_pending;
+    m_condition.notify_one();
+}
+
+void AssetLoader::Pump(SDL_Renderer* renderer, double budgetMs) {
+    const Uint64 start = SDL_GetTicksNS();
+    const auto budget = static_cast<Uint64>(budgetMs * 1000000.0);
+
+    while (true) {
+        LoadResult result;
+        {
+            std::lock_guard lock(m_resultMutex);
+            if (m_results.empty())
+                return;
+            result = std::move(m_results.front());
+            m_results.pop_front();
+        }
+
+        Finish(result, renderer);
+        --m_pending;
+
+        if (SDL_GetTicksNS() - start >= budget)
+            return;
+    }
+}
+
+void AssetLoader::WorkerLoop() {
+    while (true) {
+        LoadRequest request;
+        {
+            std::unique_lock lock(m_requestMutex);
+            m_condition.wait(lock, [] { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+                return;
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        LoadResult result = Process(request);
+        // Decodes of an atlas that didn't pack it have nothing to upload
+        if (result.type_ == Asset_Type::TextureAtlas && result.atlas_ == nullptr)
+            continue;
+
+        std::lock_guard lock(m_resultMutex);
+        m_results.push_back(std::move(result));
+    }
+}
+
+AssetLoader::LoadResult AssetLoader::Process(const LoadRequest& request) {
+    LoadResult result;
+    result.type_ = request.type_;
+    result.path_ = request.path_;
+
+    switch (request.type_) {
+        case Asset_Type::Texture:
+            result.surface_ = Render::LoadSurface(request.path_);
+            break;
+        case Asset_Type::Animation:
+            result.animation_ = Render::Animation::Bake(request.path_, request.maxSheetSize_);
+            break;
+        case Asset_Type::TextureAtlas: {
+            AtlasBatch& batch = *request.batch_;
+            if (request.index_ < batch.images_.size()) {
+                auto& image = batch.images_[request.index_];
+                image.surface_ = Render::LoadSurface(image.path_);
+            }
+            // The decrement publishes the surface, the last worker sees every image
+            if (--batch.remaining_ == 0)
+                result.atlas_ = Render::TextureAtlas::Pack(batch.images_, batch.cacheFolder_);
+            break;
+        }
+    }
+    return result;
+}
+
+void AssetLoader::Finish(LoadResult& result, SDL_Renderer* renderer) {
+    switch (result.type_) {
+        case Asset_Type::Texture:
+            TextureManager::FinishTexture(result.path_, result.surface_, renderer);
+            break;
+        case Asset_Type::Animation:
+            AnimationManager::FinishAnimation(result.path_, result.animation_.get(), renderer);
+            break;
+        case Asset_Type::TextureAtlas:
+            TextureManager::FinishAtlas(result.atlas_.get(), renderer);
+            break;
+    }
+    Discard(result);
+}
+
+AssetLoader::AtlasBatch::~AtlasBatch() {
+    // Left over if the loader stopped before the atlas was packed
+    for (auto& image : images_) {
+        if (image.surface_ != nullptr)
+            SDL_DestroySurface(image.surface_);
+    }
+}
+
+void AssetLoader::Discard(LoadResult& result) {
+    if (result.surface_ != nullptr) {
+        SDL_DestroySurface(result.surface_);
+        result.surface_ = nullptr;
+    }
+    result.animation_.reset();
+    result.atlas_.reset();
+}
@@ -1,166 +1,495 @@
 #include <audio/gkc_audio.h>
 #include <core/managers/gkc_audio_man.h>
+#include <core/managers/gkc_asset_budget.h>
 #include "core/gkc_logger.h"
 #include "filesys/gkc_filesys.h"
+#include "filesys/gkc_asset_index.h"
 
 using namespace Galaktic;
 using namespace Galaktic::Core;
 
 Galaktic::Audio::Audio_List Managers::AudioManager::m_audioFiles;
-std::multimap<AudioID, MIX_Track*> Managers::AudioManager::m_activeTracks;
+vector<Managers::AudioManager::Voice> Managers::AudioManager::m_voices;
+vector<Uint32> Managers::AudioManager::m_freeVoices;
+unordered_map<AudioID, Managers::AudioManager::SoundVoices> Managers::AudioManager::m_soundVoices;
+vector<Galaktic::Audio::VoiceID> Managers::AudioManager::m_finishedVoices;
+unordered_set<Galaktic::Audio::VoiceID> Managers::AudioManager::m_stolenVoices;
+std::mutex Managers::AudioManager::m_finishedMutex;
 SDL_AudioSpec Managers::AudioManager::m_audioSpec{};
 SDL_AudioDeviceID Managers::AudioManager::m_deviceID;
+bool Managers::AudioManager::m_offline = false;
 MIX_Mixer* Managers::AudioManager::m_mixer = nullptr;
 
-Managers::AudioManager::AudioManager(const string &folder) {
+Managers::AudioManager::AudioManager(const string &folder, Audio::Audio_Output output, Uint32 voiceCount) {
     m_audioSpec.channels = 2;
     m_audioSpec.freq = 48000;
     m_audioSpec.format = SDL_AUDIO_S16;
 
-    m_deviceID = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &m_audioSpec);
-    SDL_PauseAudioDevice(m_deviceID);
+    if (output == Audio::Audio_Output::Offline) {
+        // Nothing pulls from this mixer, the output is rendered on demand with Generate()
+        m_deviceID = 0;
+        m_mixer = MIX_CreateMixer(&m_audioSpec);
+    } else {
+        m_deviceID = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &m_audioSpec);
+        SDL_PauseAudioDevice(m_deviceID);
+
+        if (m_deviceID == 0) {
+            GKC_ENGINE_FATAL("failed to open audio device!");
+        }
 
-    if (m_deviceID == 0) {
-        GKC_ENGINE_FATAL("failed to open audio device!");
+        m_mixer = MIX_CreateMixerDevice(m_deviceID, &m_audioSpec);
     }
 
-    m_mixer = MIX_CreateMixerDevice(m_deviceID, &m_audioSpec);
     if (m_mixer == nullptr) {
         GKC_ENGINE_FATAL("audio mixer is NULL!");
     }
+    m_offline = output == Audio::Audio_Output::Offline;
+
+    voiceCount = std::clamp<Uint32>(voiceCount, 1, 0xFFFF);
+    m_voices.resize(voiceCount);
+    for (Uint32 i = 0; i < voiceCount; ++i) {
+        m_voices[i].track_ = MIX_CreateTrack(m_mixer);
+        if (m_voices[i].track_ == nullptr) {
+            GKC_ENGINE_FATAL("failed to create audio track!");
+        }
+        // Popped from the back, voice 0 is used first
+        m_freeVoices.push_back(voiceCount - 1 - i);
+    }
+
+    if (AssetBudget::GetBudget(Asset_Class::Audio) == 0)
+        AssetBudget::SetBudget(Asset_Class::Audio, Audio::GKC_AUDIO_PCM_BUDGET);
+
+    if (folder.empty())
+        return;
+
+    for (auto& file : Filesystem::AssetIndex::GetFiles(folder, Filesystem::Asset_Type::Audio))
+        AddAudioFile(file);
+}
+
+bool Managers::AudioManager::Generate(void* buffer, size_t bytes) {
+    if (!m_offline) {
+        GKC_ENGINE_ERROR("Audio can only be generated by an offline mixer");
+        return false;
+    }
+    if (MIX_Generate(m_mixer, buffer, static_cast<int>(bytes)) <= 0) {
+        GKC_ENGINE_ERROR("Failed to generate audio: {}", SDL_GetError());
+        return false;
+    }
+    // Tracks that ended while mixing reported it from this thread
+    CollectFinishedVoices();
+    return true;
+}
 
+bool Managers::AudioManager::RenderToWAV(const path& file, double seconds) {
+    const size_t frameSize = static_cast<size_t>(m_audioSpec.channels) * SDL_AUDIO_BYTESIZE(m_audioSpec.format);
+    const auto frames = static_cast<size_t>(std::max(0.0, seconds) * m_audioSpec.freq);
+    vector<Uint8> pcm(frames * frameSize);
 
-    auto files = Filesystem::GetFilenamesInFolder(folder);
-    for (auto& file : files) {
-        if (Audio::CheckAudioExtension(file))
-            AddAudioFile(file);
+    // Generated in blocks, the same way a device would pull it
+    constexpr size_t BLOCK_FRAMES = 1024;
+    for (size_t frame = 0; frame < frames; frame += BLOCK_FRAMES) {
+        size_t count = std::min(BLOCK_FRAMES, frames - frame);
+        if (!Generate(pcm.data() + frame * frameSize, count * frameSize))
+            return false;
     }
+    return Audio::WriteWAV(file, m_audioSpec, pcm);
 }
 
 void Managers::AudioManager::AddAudioFile(const string& path) {
-    AudioID id = m_audioFiles.size() + 1;
-    auto info = make_shared<Audio::AudioInfo>(id, make_shared<Audio::AudioFile>(path, m_mixer));
+    InsertAudioFile(path, Audio::Audio_Mode::Auto);
+}
+
+void Managers::AudioManager::AddMusicFile(const string& path) {
+    InsertAudioFile(path, Audio::Audio_Mode::Streamed);
+}
+
+void Managers::AudioManager::InsertAudioFile(const string& path, Audio::Audio_Mode mode) {
+    auto info = make_shared<Audio::AudioInfo>(0, make_shared<Audio::AudioFile>(path, m_mixer, mode));
 
-    if(!info->audioFile_->IsValid() || info->id_ == 0) {
+    if(!info->audioFile_->IsValid()) {
         GKC_ENGINE_ERROR("Audio file is invalid!: {}", path);
         return;
     }
+    info->path_ = path;
+    info->bytes_ = info->audioFile_->GetMemorySize();
+    info->mode_ = info->audioFile_->IsStreamed() ? Audio::Audio_Mode::Streamed : Audio::Audio_Mode::Predecoded;
 
-    auto [it, inserted] = m_audioFiles.emplace(Filesystem::GetFilename(path),
-        std::move(info));
+    info->id_ = m_audioFiles.Insert(Filesystem::GetFilename(path), info);
+    if (info->id_ == 0) {
+        GKC_ENGINE_ERROR("Audio file is invalid!: {}", path);
+        return;
+    }
 
     #ifdef GKC_PRINT_TEXTURE_ADDED
-        GKC_ENGINE_INFO("[{0} | ID: {1}] at address {2}", path, id,
-            CastToVoidPtr(it->second->audioFile_));
+        GKC_ENGINE_INFO("[{0} | ID: {1}] at address {2}", path, info->id_,
+            CastToVoidPtr(info->audioFile_));
     #endif
 }
 
 void Managers::AudioManager::RemoveAudioFile(const string &name) {
-    auto audioFile = m_audioFiles.find(name);
-    if (audioFile != m_audioFiles.end()) {
+    if (m_audioFiles.FindID(name) != 0) {
         StopAllTracksFromSound(name);
-        m_audioFiles.erase(audioFile);
+        m_audioFiles.Erase(name);
         GKC_ENGINE_INFO("Erased audio file {0}", name);
     }
 }
 
-void Managers::AudioManager::PlayAudioFile(const string& name, int loops) {
-    auto it = m_audioFiles.find(name);
-    if (it != m_audioFiles.end()) {
-        auto audioFile = it->second->audioFile_->GetAudioSample();
-        auto id = it->second->id_;
-
-        MIX_Track* track = MIX_CreateTrack(m_mixer);
-        MIX_SetTrackAudio(track, audioFile);
-        MIX_SetTrackLoops(track, loops);
-        MIX_PlayTrack(track, 0);
-
-        m_activeTracks.emplace(id, track);
+void Managers::AudioManager::PlayAudioFile(const string& name, int loops, int priority) {
+    auto* info = m_audioFiles.Find(name);
+    if (info != nullptr) {
+        StartVoice(**info, loops, priority, 1.f, 0.f);
     }
 }
 
 void Managers::AudioManager::PlayMusicFile(const string &name) {
     GKC_ENGINE_INFO("Playing {}", name);
-    auto it = m_audioFiles.find(name);
-    if (it != m_audioFiles.end()) {
-        auto audioFile = it->second->audioFile_->GetAudioSample();
-        auto id = it->second->id_;
-
-        MIX_Track* track = MIX_CreateTrack(m_mixer);
-        MIX_SetTrackAudio(track, audioFile);
-
-        MIX_PlayTrack(track, 0);
-        MIX_SetTrackLoops(track, -1);
-
-        m_activeTracks.emplace(id, track);
+    auto* info = m_audioFiles.Find(name);
+    if (info != nullptr) {
+        StartVoice(**info, -1, Audio::GKC_AUDIO_PRIORITY_MUSIC, 1.f, 0.f);
     } else {
         GKC_ENGINE_ERROR("file doesn't exist!");
     }
 }
 
 void Managers::AudioManager::StopSound(const string &name, Sint64 fadeOutMs) {
-    auto it = m_audioFiles.find(name);
-    if (it != m_audioFiles.end()) {
-        auto id = it->second->id_;
-
-        auto trackIt = m_activeTracks.find(id);
-        if (trackIt != m_activeTracks.end()) {
-            MIX_Track* track = trackIt->second;
-            if (track != nullptr) {
-                MIX_StopTrack(track, fadeOutMs);
-                // CRITICAL FIX: Destroy the track to free memory
-                MIX_DestroyTrack(track);
-            }
-            m_activeTracks.erase(trackIt);
-        }
+    AudioID id = m_audioFiles.FindID(name);
+    auto sound = m_soundVoices.find(id);
+    if (sound != m_soundVoices.end() && sound->second.head_ != NO_VOICE) {
+        StopVoiceAt(sound->second.head_, fadeOutMs);
     }
 }
 
 void Managers::AudioManager::StopAllTracksFromSound(const string &name, Sint64 fadeOutMs) {
-    auto it = m_audioFiles.find(name);
-    if (it != m_audioFiles.end()) {
-        auto id = it->second->id_;
-
-        auto range = m_activeTracks.equal_range(id);
-        for (auto iter = range.first; iter != range.second; ) {
-            MIX_Track* track = iter->second;
-            if (track != nullptr) {
-                MIX_StopTrack(track, fadeOutMs);
-                // CRITICAL FIX: Destroy the track to free memory
-                MIX_DestroyTrack(track);
-            }
-            iter = m_activeTracks.erase(iter);
-        }
+    AudioID id = m_audioFiles.FindID(name);
+    auto sound = m_soundVoices.find(id);
+    if (sound != m_soundVoices.end()) {
+        while (sound->second.head_ != NO_VOICE)
+            StopVoiceAt(sound->second.head_, fadeOutMs);
     }
 }
 
 void Managers::AudioManager::StopAllSounds(Sint64 fadeOutMs) {
-    MIX_StopAllTracks(m_mixer, fadeOutMs);
-    // CRITICAL FIX: Destroy all tracks and clear the map
-    for (auto& [id, track] : m_activeTracks) {
-        if (track != nullptr) {
-            MIX_DestroyTrack(track);
+    for (Uint32 i = 0; i < m_voices.size(); ++i) {
+        if (m_voices[i].linked_)
+            StopVoiceAt(i, fadeOutMs);
+    }
+}
+
+bool Managers::AudioManager::IsPlaying(AudioID id) {
+    CollectFinishedVoices();
+    auto sound = m_soundVoices.find(id);
+    return sound != m_soundVoices.end() && sound->second.count_ > 0;
+}
+
+Audio::VoiceID Managers::AudioManager::PlayVoice(AudioID id, int loops, int priority, float gain, float pan) {
+    auto* info = m_audioFiles.Get(id);
+    if (info == nullptr)
+        return Audio::GKC_INVALID_VOICE;
+    return StartVoice(**info, loops, priority, gain, pan, true);
+}
+
+bool Managers::AudioManager::IsVoicePlaying(Audio::VoiceID voice) {
+    CollectFinishedVoices();
+    return FindVoice(voice) != NO_VOICE;
+}
+
+bool Managers::AudioManager::ConsumeStolenVoice(Audio::VoiceID voice) {
+    return m_stolenVoices.erase(voice) > 0;
+}
+
+void Managers::AudioManager::StopVoice(Audio::VoiceID voice, Sint64 fadeOutMs) {
+    Uint32 index = FindVoice(voice);
+    if (index != NO_VOICE)
+        StopVoiceAt(index, fadeOutMs);
+    else
+        m_stolenVoices.erase(voice);
+}
+
+void Managers::AudioManager::SetVoiceParameters(const vector<Audio::VoiceParameters>& parameters) {
+    if (parameters.empty())
+        return;
+
+    // One lock for the whole batch instead of one per call
+    MIX_LockMixer(m_mixer);
+    for (auto& parameter : parameters) {
+        Uint32 index = FindVoice(parameter.voice_);
+        if (index != NO_VOICE)
+            ApplyVoiceParameters(m_voices[index], parameter.gain_, parameter.pan_);
+    }
+    MIX_UnlockMixer(m_mixer);
+}
+
+Audio::VoiceID Managers::AudioManager::StartVoice(Audio::AudioInfo& info, int loops, int priority,
+    float gain, float pan, bool tracked) {
+    auto file = Touch(info);
+    if (file == nullptr)
+        return Audio::GKC_INVALID_VOICE;
+
+    Uint32 index = AcquireVoice(priority, !tracked);
+    if (index == NO_VOICE)
+        return Audio::GKC_INVALID_VOICE;
+
+    Voice& voice = m_voices[index];
+    voice.audioID_ = info.id_;
+    voice.priority_ = priority;
+    voice.startTick_ = SDL_GetTicks();
+    voice.playing_ = true;
+    voice.linked_ = true;
+    voice.tracked_ = tracked;
+
+    // Appended so StopSound keeps stopping the first track played
+    auto& sound = m_soundVoices[info.id_];
+    voice.prev_ = sound.tail_;
+    voice.next_ = NO_VOICE;
+    if (sound.tail_ != NO_VOICE)
+        m_voices[sound.tail_].next_ = index;
+    else
+        sound.head_ = index;
+    sound.tail_ = index;
+    ++sound.count_;
+
+    Audio::VoiceID voiceID = MakeVoiceID(index);
+    MIX_SetTrackStoppedCallback(voice.track_, OnTrackStopped,
+        reinterpret_cast<void*>(static_cast<uintptr_t>(voiceID)));
+    MIX_SetTrackAudio(voice.track_, file->GetAudioSample());
+    MIX_SetTrackLoops(voice.track_, loops);
+    ApplyVoiceParameters(voice, gain, pan);
+    MIX_PlayTrack(voice.track_, 0);
+    return voiceID;
+}
+
+Audio::VoiceID Managers::AudioManager::MakeVoiceID(Uint32 index) {
+    return (m_voices[index].generation_ & 0xFFFF) << 16 | (index + 1);
+}
+
+Uint32 Managers::AudioManager::FindVoice(Audio::VoiceID voice) {
+    Uint32 index = (voice & 0xFFFF) - 1;
+    if (voice == Audio::GKC_INVALID_VOICE || index >= m_voices.size())
+        return NO_VOICE;
+    // The voice could've been recycled and played again since the handle was made
+    if (!m_voices[index].playing_ || MakeVoiceID(index) != voice)
+        return NO_VOICE;
+    return index;
+}
+
+void Managers::AudioManager::ApplyVoiceParameters(const Voice& voice, float gain, float pan) {
+    MIX_SetTrackGain(voice.track_, gain);
+    if (pan == 0.f) {
+        MIX_SetTrackStereo(voice.track_, nullptr);
+        return;
+    }
+
+    // Balance law, the center keeps both channels at full volume
+    MIX_StereoGains gains{ std::min(1.f, 1.f - pan), std::min(1.f, 1.f + pan) };
+    MIX_SetTrackStereo(voice.track_, &gains);
+}
+
+void Managers::AudioManager::StopVoiceAt(Uint32 index, Sint64 fadeOutMs) {
+    Voice& voice = m_voices[index];
+    if (!voice.playing_)
+        return;
+
+    if (fadeOutMs <= 0) {
+        MIX_StopTrack(voice.track_, 0);
+        ReleaseVoice(index);
+        return;
+    }
+
+    // Keeps playing until the fade ends, the stopped callback recycles it
+    UnlinkVoice(index);
+    MIX_StopTrack(voice.track_, MIX_TrackMSToFrames(voice.track_, fadeOutMs));
+}
+
+Uint32 Managers::AudioManager::AcquireVoice(int priority, bool stealEqual) {
+    CollectFinishedVoices();
+    if (!m_freeVoices.empty()) {
+        Uint32 index = m_freeVoices.back();
+        m_freeVoices.pop_back();
+        return index;
+    }
+
+    // Fading out voices go first, then the lowest priority, then the oldest
+    Uint32 victim = NO_VOICE;
+    for (Uint32 i = 0; i < m_voices.size(); ++i) {
+        const Voice& voice = m_voices[i];
+        if (voice.linked_ && (voice.priority_ > priority || (voice.priority_ == priority && !stealEqual)))
+            continue;
+        if (victim == NO_VOICE) {
+            victim = i;
+            continue;
+        }
+
+        const Voice& current = m_voices[victim];
+        if (voice.linked_ != current.linked_) {
+            if (!voice.linked_)
+                victim = i;
+        } else if (voice.priority_ != current.priority_) {
+            if (voice.priority_ < current.priority_)
+                victim = i;
+        } else if (voice.startTick_ < current.startTick_) {
+            victim = i;
         }
     }
-    m_activeTracks.clear();
+
+    if (victim == NO_VOICE)
+        return NO_VOICE;
+
+    // The owner of the handle tells it apart from a voice that finished
+    if (m_voices[victim].linked_ && m_voices[victim].tracked_)
+        m_stolenVoices.insert(MakeVoiceID(victim));
+    MIX_StopTrack(m_voices[victim].track_, 0);
+    ReleaseVoice(victim);
+    m_freeVoices.pop_back();
+    return victim;
+}
+
+void Managers::AudioManager::ReleaseVoice(Uint32 index) {
+    Voice& voice = m_voices[index];
+    if (!voice.playing_)
+        return;
+
+    UnlinkVoice(index);
+    auto sound = m_soundVoices.find(voice.audioID_);
+    if (sound != m_soundVoices.end() && sound->second.count_ > 0)
+        --sound->second.count_;
+
+    // The track would keep the MIX_Audio alive after it's evicted
+    MIX_SetTrackAudio(voice.track_, nullptr);
+    voice.audioID_ = 0;
+    voice.playing_ = false;
+    voice.tracked_ = false;
+    ++voice.generation_;
+    m_freeVoices.push_back(index);
+}
+
+void Managers::AudioManager::UnlinkVoice(Uint32 index) {
+    Voice& voice = m_voices[index];
+    if (!voice.linked_)
+        return;
+
+    auto& sound = m_soundVoices[voice.audioID_];
+    if (voice.prev_ != NO_VOICE)
+        m_voices[voice.prev_].next_ = voice.next_;
+    else
+        sound.head_ = voice.next_;
+    if (voice.next_ != NO_VOICE)
+        m_voices[voice.next_].prev_ = voice.prev_;
+    else
+        sound.tail_ = voice.prev_;
+
+    voice.prev_ = NO_VOICE;
+    voice.next_ = NO_VOICE;
+    voice.linked_ = false;
+}
+
+void Managers::AudioManager::CollectFinishedVoices() {
+    vector<Audio::VoiceID> finished;
+    {
+        std::lock_guard lock(m_finishedMutex);
+        if (m_finishedVoices.empty())
+            return;
+        finished.swap(m_finishedVoices);
+    }
+
+    for (Audio::VoiceID voice : finished) {
+        // The voice could've been stopped and played again since the callback
+        Uint32 index = FindVoice(voice);
+        if (index != NO_VOICE)
+            ReleaseVoice(index);
+    }
+
+    // Hands the buffer back so the callback doesn't allocate next time
+    finished.clear();
+    std::lock_guard lock(m_finishedMutex);
+    if (m_finishedVoices.empty())
+        m_finishedVoices.swap(finished);
+}
+
+void SDLCALL Managers::AudioManager::OnTrackStopped(void* userdata, MIX_Track*) {
+    // Called from the mixer thread, the voice is recycled by the main thread
+    std::lock_guard lock(m_finishedMutex);
+    m_finishedVoices.push_back(static_cast<Uint32>(reinterpret_cast<uintptr_t>(userdata)));
 }
 
 shared_ptr<Audio::AudioFile> Managers::AudioManager::GetAudioFile(const string &name) {
-    auto audioFile = m_audioFiles.find(name);
-    if (audioFile != m_audioFiles.end()) {
-        return audioFile->second->audioFile_;
+    auto* info = m_audioFiles.Find(name);
+    if (info != nullptr) {
+        return Touch(**info);
     }
     GKC_ENGINE_WARNING("Audio file to retrieve doesn't exist");
     return nullptr;
 }
 
-void Managers::AudioManager::PrintList() {
-    for (auto& pair : m_audioFiles) {
-        GKC_ENGINE_INFO("Key: {0} | {1} &{2}", pair.first, pair.second->id_,
-            CastToVoidPtr(pair.second->audioFile_.operator*()));
+shared_ptr<Audio::AudioFile> Managers::AudioManager::GetAudioFile(AudioID id) {
+    auto* info = m_audioFiles.Get(id);
+    if (info != nullptr) {
+        return Touch(**info);
+    }
+    GKC_ENGINE_WARNING("Audio file to retrieve doesn't exist");
+    return nullptr;
+}
+
+shared_ptr<Audio::AudioInfo> Managers::AudioManager::GetAudioInfo(const string& name) {
+    auto* info = m_audioFiles.Find(name);
+    if (info != nullptr) {
+        return *info;
+    }
+    GKC_ENGINE_WARNING("Audio Information to retrieve doesn't exist");
+    return nullptr;
+}
+
+Managers::AssetHandle<Audio::AudioFile> Managers::AudioManager::AcquireAudio(const string& name) {
+    auto* info = m_audioFiles.Find(name);
+    if (info == nullptr)
+        return {};
+    return AssetHandle<Audio::AudioFile>((*info)->id_, Touch(**info));
+}
+
+void Managers::AudioManager::Evict(size_t budget) {
+    size_t total = 0;
+    vector<EvictionCandidate> candidates;
+    m_audioFiles.ForEach([&](const string& name, auto& info) {
+        if (info->audioFile_ == nullptr)
+            return;
+        total += info->bytes_;
+
+        // Tracks keep playing the MIX_Audio, never pull it from under them
+        if (info->audioFile_.use_count() > 1 || IsPlaying(info->id_))
+            return;
+        candidates.emplace_back(name, info->lastUsedFrame_, info->bytes_);
+    });
+
+    auto evicted = AssetBudget::SelectEvictions(candidates, total, budget);
+    for (auto& name : evicted) {
+        auto& info = *m_audioFiles.Find(name);
+        info->audioFile_ = nullptr;
+        info->bytes_ = 0;
     }
+
+    if (!evicted.empty())
+        GKC_ENGINE_INFO("Evicted {0} audio files to fit the {1} bytes budget", evicted.size(), budget);
 }
 
-void Managers::AudioManager::RegisterTrack(AudioID id, MIX_Track *track) {
-    m_activeTracks.emplace(id, track);
+shared_ptr<Audio::AudioFile> Managers::AudioManager::Touch(Audio::AudioInfo& info) {
+    info.lastUsedFrame_ = AssetBudget::GetFrame();
+    // Audio is small enough to be decoded again right away
+    if (info.audioFile_ == nullptr && !info.path_.empty()) {
+        auto audioFile = make_shared<Audio::AudioFile>(info.path_, m_mixer, info.mode_);
+        if (!audioFile->IsValid()) {
+            GKC_ENGINE_ERROR("Failed to reload audio file: {}", info.path_.string());
+            return nullptr;
+        }
+        info.bytes_ = audioFile->GetMemorySize();
+        info.audioFile_ = std::move(audioFile);
+    }
+    return info.audioFile_;
 }
+
+void Managers::AudioManager::PrintList() {
+    m_audioFiles.ForEach([](const string& name, auto& info) {
+        GKC_ENGINE_INFO("Key: {0} | {1} &{2} ({3})", name, info->id_,
+            static_cast<const void*>(info->audioFile_.get()),
+            info->mode_ == Audio::Audio_Mode::Streamed ? "streamed" : "predecoded");
+    });
+}
+
@@ -0,0 +1,65 @@
+#include <core/managers/gkc_hot_reload.h>
+#include "core/gkc_logger.h"
+#include "core/managers/gkc_animation_man.h"
+#include "core/managers/gkc_script_man.h"
+#include "core/managers/gkc_texture_man.h"
+#include "filesys/gkc_file_watcher.h"
+#include "render/gkc_animation.h"
+#include "render/gkc_texture.h"
+#include "script/gkc_script.h"
+
+using namespace Galaktic;
+using namespace Galaktic::Core::Managers;
+
+unique_ptr<Filesystem::FileWatcher> HotReloadManager::m_watcher;
+path HotReloadManager::m_projectPath;
+vector<path> HotReloadManager::m_changed;
+
+void HotReloadManager::Start(const path& projectPath) {
+    m_projectPath = projectPath;
+    m_watcher = make_unique<Filesystem::FileWatcher>();
+
+    bool watching = false;
+    for (auto& folder : { GKC_TEXTURE_PATH, GKC_ANIMATION_PATH, GKC_SCRIPT_PATH / "local" }) {
+        watching |= m_watcher->Watch(projectPath / folder);
+    }
+
+    if (!watching) {
+        GKC_ENGINE_WARNING("No project folder could be watched, hot reload is disabled");
+        m_watcher.reset();
+        return;
+    }
+    GKC_ENGINE_INFO("Hot reload enabled for '{0}'", projectPath.string());
+}
+
+void HotReloadManager::Stop() {
+    m_watcher.reset();
+    m_changed.clear();
+}
+
+void HotReloadManager::Update(SDL_Renderer* renderer) {
+    if (m_watcher == nullptr)
+        return;
+
+    m_changed.clear();
+    m_watcher->Poll(m_changed);
+    for (auto& file : m_changed) {
+        Reload(file, renderer);
+    }
+}
+
+void HotReloadManager::Reload(const path& file, SDL_Renderer* renderer) {
+    // GIF files are both textures and animations, the folder decides
+    if (IsInside(file, m_projectPath / GKC_TEXTURE_PATH) && Render::CheckTextureExtension(file)) {
+        TextureManager::ReloadTexture(file, renderer);
+    } else if (IsInside(file, m_projectPath / GKC_ANIMATION_PATH) && Render::CheckAnimationExtension(file)) {
+        AnimationManager::ReloadAnimation(file, renderer);
+    } else if (IsInside(file, m_projectPath / GKC_SCRIPT_PATH) && Script::CheckScriptExtension(file)) {
+        ScriptManager::ReloadScript(file);
+    }
+}
+
+bool HotReloadManager::IsInside(const path& file, const path& folder) {
+    auto relative = file.lexically_normal().lexically_relative(folder.lexically_normal()).generic_string();
+    return !relative.empty() && !relative.starts_with("..");
+}
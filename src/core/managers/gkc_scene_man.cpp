@@ -1,5 +1,6 @@
 #include <core/managers/gkc_scene_man.h>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_archive.h>
 #include "core/gkc_logger.h"
 #include "core/gkc_scene.h"
 #include "filesys/gkc_reader.h"
@@ -30,7 +31,7 @@ void Managers::SceneManager::LoadSpecificScene(const string &name) const {
 }
 
 void Managers::SceneManager::LoadSpecificSceneFromFile(const path &filepath) {
-    if (!Filesystem::CheckFile(filepath)) {
+    if (!Filesystem::AssetExists(filepath)) {
         GKC_ENGINE_ERROR("Scene not found in the specified filepath!");
         return;
     }
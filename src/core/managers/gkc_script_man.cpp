@@ -1,6 +1,8 @@
 #include <core/managers/gkc_script_man.h>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_asset_index.h>
 #include <core/gkc_logger.h>
+#include <core/gkc_exception.h>
 #include <script/gkc_script.h>
 
 using namespace Galaktic;
@@ -8,66 +10,72 @@ using namespace Galaktic::Core;
 using namespace Galaktic::Core::Managers;
 
 Script::Script_List ScriptManager::m_scriptList;
-unordered_map<ScriptID, string> ScriptManager::m_IDToNameList;
 lua_State* ScriptManager::m_luaState = nullptr;
 
 ScriptManager::ScriptManager(const string& folder, lua_State* luaState) {
     m_luaState = luaState;
-    auto files = Filesystem::GetFilenamesInFolder(folder + "/local");
-    for (auto& file : files) {
-        if (Script::CheckScriptExtension(file))
-            AddScriptFromFile(file);
-    }
+    for (auto& file : Filesystem::AssetIndex::GetFiles(folder + "/local", Filesystem::Asset_Type::Script))
+        AddScriptFromFile(file);
 
     //ExecuteGalakticModule();
 }
 
 void ScriptManager::AddInlineScript(const string& scriptName, const string& script) {
     using namespace Script;
-    ScriptID id = m_scriptList.size() + 1;
-    auto scriptInfo = ScriptInfo(id, make_shared<Script::GKC_Script>(scriptName, script, m_luaState), ScriptType::InlineScript);
+    auto scriptInfo = ScriptInfo(0, make_shared<Script::GKC_Script>(scriptName, script, m_luaState), ScriptType::InlineScript);
 
-    m_scriptList.emplace(scriptName, scriptInfo);
-    m_IDToNameList.emplace(id, scriptName);
+    ScriptID id = m_scriptList.Insert(scriptName, std::move(scriptInfo));
+    if (auto* info = m_scriptList.Get(id))
+        info->scriptID_ = id;
     GKC_ENGINE_INFO("Added inline script '{0}' (ID: {1})", scriptName, id );
 }
 
 void ScriptManager::AddScriptFromFile(const string& scriptPath) {
     using namespace Script;
-    ScriptID id = m_scriptList.size() + 1;
-    auto scriptInfo = ScriptInfo(id, make_shared<Script::GKC_Script>(scriptPath, m_luaState), ScriptType::FileScript);
+    auto scriptInfo = ScriptInfo(0, make_shared<Script::GKC_Script>(scriptPath, m_luaState), ScriptType::FileScript);
     string scriptName = Filesystem::GetFilename(scriptPath);
 
-    m_scriptList.emplace(scriptName, scriptInfo);
-    m_IDToNameList.emplace(id, scriptName);
+    ScriptID id = m_scriptList.Insert(scriptName, std::move(scriptInfo));
+    if (auto* info = m_scriptList.Get(id))
+        info->scriptID_ = id;
     GKC_ENGINE_INFO("Added file script '{0}' (ID: {1})", scriptName, id );
 }
 
+void ScriptManager::ReloadScript(const path& scriptPath) {
+    string scriptName = Filesystem::GetFilename(scriptPath);
+    try {
+        auto* info = m_scriptList.Find(scriptName);
+        if (info == nullptr) {
+            AddScriptFromFile(scriptPath.string());
+            return;
+        }
+
+        info->script_ = make_shared<Script::GKC_Script>(scriptPath, m_luaState);
+        GKC_ENGINE_INFO("Reloaded script '{0}' (ID: {1})", scriptName, info->scriptID_);
+    } catch (const Debug::ScriptException& e) {
+        GKC_ENGINE_ERROR("Failed to reload script '{0}': {1}", scriptName, e.what());
+    }
+}
+
 void ScriptManager::DeleteScriptFromList(const string& scriptName) {
-    auto it = m_scriptList.find(scriptName);
-    if (it != m_scriptList.end()) {
-        m_IDToNameList.erase(it->second.scriptID_);
-        m_scriptList.erase(scriptName);
+    if (m_scriptList.Erase(scriptName)) {
         GKC_ENGINE_INFO("Deleted script '{}'", scriptName);
     }
 }
 
 shared_ptr<Script::GKC_Script> ScriptManager::GetScriptFromName(const string& scriptName) {
-    auto it = m_scriptList.find(scriptName);
-    if(it != m_scriptList.end()) {
-        return it->second.script_;
+    auto* info = m_scriptList.Find(scriptName);
+    if(info != nullptr) {
+        return info->script_;
     }
     GKC_ENGINE_WARNING("Script to retrieve not found!");
     return nullptr;
 }
 
 shared_ptr<Script::GKC_Script> ScriptManager::GetScriptFromID(ScriptID id) {
-    auto it = m_IDToNameList.find(id);
-    if (it != m_IDToNameList.end()) {
-        auto scriptNameIt = m_scriptList.find(it->second);
-        if (scriptNameIt != m_scriptList.end()){
-            return scriptNameIt->second.script_;
-        }
+    auto* info = m_scriptList.Get(id);
+    if (info != nullptr) {
+        return info->script_;
     }
     GKC_ENGINE_WARNING("Script to retrieve not found!");
     return nullptr;
@@ -83,9 +91,9 @@ void ScriptManager::RunScript(const string &scriptName) {
 }
 
 void ScriptManager::ExecuteGalakticModule() {
-    auto galakticFile = m_scriptList.find("Galaktic.lua");
-    auto gkcConstantsFile = m_scriptList.find("GlobalConstants.lua");
+    auto* galakticFile = m_scriptList.Find("Galaktic.lua");
+    auto* gkcConstantsFile = m_scriptList.Find("GlobalConstants.lua");
 
-    galakticFile->second.script_->RunScript();
-    gkcConstantsFile->second.script_->RunScript();
+    galakticFile->script_->RunScript();
+    gkcConstantsFile->script_->RunScript();
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include <core/managers/gkc_texture_man.h>
 #include "core/gkc_logger.h"
 #include "filesys/gkc_filesys.h"
+#include "filesys/gkc_asset_index.h"
 #include "render/gkc_texture.h"
+#include "render/gkc_atlas.h"
+#include "core/managers/gkc_asset_loader.h"
+#include "core/managers/gkc_asset_budget.h"
 #include "ecs/gkc_entity.h"
 #include "core/managers/gkc_texture_man.h"
 
@@ -9,45 +13,48 @@ using namespace Galaktic::Core;
 using namespace Galaktic;
 
 Galaktic::Render::Texture_List Managers::TextureManager::m_textureList;
-Galaktic::Render::TextureID_List Managers::TextureManager::m_IDToNameList;
 vector<path> Managers::TextureManager::m_texturePathList;
 SDL_Texture* Managers::TextureManager::m_missingTexture = nullptr;
+Galaktic::Render::TextureAtlas Managers::TextureManager::m_atlas;
+path Managers::TextureManager::m_cacheFolder;
+bool Managers::TextureManager::m_useAtlas = true;
 
-Managers::TextureManager::TextureManager(const string &path) {
-    auto files = Filesystem::GetFilenamesInFolder(path);
-    for (auto& file : files) {
-        if (Render::CheckTextureExtension(file))
-            AddTexturePath(file);
-    }
+Managers::TextureManager::TextureManager(const string &path, const std::filesystem::path& cacheFolder) {
+    m_cacheFolder = cacheFolder;
+    for (auto& file : Filesystem::AssetIndex::GetFiles(path, Filesystem::Asset_Type::Texture))
+        AddTexturePath(file);
 }
 
 void Managers::TextureManager::AddTexture(const string& path, SDL_Renderer* renderer) {
-    TextureID id = m_textureList.size() + 1;
-    auto info = make_shared<Render::TextureInfo>(id, make_shared<Render::Texture>(path, renderer));
-    if(!info->texture_->IsValid() || info->id_ == 0) {
+    auto info = make_shared<Render::TextureInfo>(0, make_shared<Render::Texture>(path, renderer));
+    if(!info->texture_->IsValid()) {
         GKC_ENGINE_ERROR("Failed to load texture at path: {0}", path);
         return;
     }
+    info->path_ = path;
+    info->bytes_ = info->texture_->GetMemorySize();
     
     string textureName = Filesystem::GetFilename(path);
-    auto [it, inserted] = m_textureList.emplace(textureName, std::move(info));
-    m_IDToNameList.emplace(id, textureName);
+    info->id_ = m_textureList.Insert(textureName, info);
+    if (info->id_ == 0) {
+        GKC_ENGINE_ERROR("Failed to load texture at path: {0}", path);
+        return;
+    }
     m_texturePathList.emplace_back(path);
 
     GKC_ENGINE_INFO("'{}' texture added and loaded sucessfully!", path);
 }
 
 void Managers::TextureManager::AddTexturePath(const string& path) {
-    TextureID id = m_textureList.size() + 1;
-    auto info = make_shared<Render::TextureInfo>(id, nullptr);
-    if(info == nullptr || info->id_ == 0) {
+    auto info = make_shared<Render::TextureInfo>(0, nullptr);
+    info->path_ = path;
+
+    string textureName = Filesystem::GetFilename(path);
+    info->id_ = m_textureList.Insert(textureName, info);
+    if(info->id_ == 0) {
         GKC_ENGINE_ERROR("Failed to add texture at path: {0}", path);
         return;
     }
-
-    string textureName = Filesystem::GetFilename(path);
-    auto [it, inserted] = m_textureList.emplace(textureName, std::move(info));
-    m_IDToNameList.emplace(id, textureName);
     m_texturePathList.emplace_back(path);
 
     GKC_ENGINE_INFO("'{}' texture added sucessfully!", path);
@@ -56,16 +63,16 @@ void Managers::TextureManager::AddTexturePath(const string& path) {
 
 void Managers::TextureManager::LoadTexture(const string& path, SDL_Renderer* renderer) {
     string textureName = Filesystem::GetFilename(path);
-    auto it = m_textureList.find(textureName);
-    if (it != m_textureList.end()) {
-        TextureID id = it->second->id_;
+    auto* info = m_textureList.Find(textureName);
+    if (info != nullptr) {
         auto texture = make_shared<Render::Texture>(path, renderer);
         if(texture == nullptr) {
             GKC_ENGINE_ERROR("Failed to load texture at path: {0}", path);
             return;
         }
 
-        it->second->texture_ = std::move(texture);
+        (*info)->bytes_ = texture->GetMemorySize();
+        (*info)->texture_ = std::move(texture);
         GKC_ENGINE_INFO("'{}' texture loaded successfully", textureName);
     } else {
         AddTexture(path, renderer);
@@ -73,18 +80,148 @@ void Managers::TextureManager::LoadTexture(const string& path, SDL_Renderer* ren
 }
 
 void Managers::TextureManager::LoadAllTextures(SDL_Renderer* renderer) {
+    if (m_useAtlas) {
+        BuildAtlas(renderer);
+        AssignAtlasTextures();
+    }
+
     for(auto& path : m_texturePathList) {
+        auto* info = m_textureList.Find(Filesystem::GetFilename(path));
+        if (info != nullptr && (*info)->texture_ != nullptr && (*info)->texture_->IsAtlased())
+            continue;
         LoadTexture(path.string(), renderer);
     }
     PrintList();
 }
 
+void Managers::TextureManager::LoadAllTexturesAsync(SDL_Renderer* renderer) {
+    if (m_useAtlas) {
+        // A cached atlas only has to load a few pages, everything else is baked in the background
+        if (m_cacheFolder.empty() || !m_atlas.LoadCache(m_texturePathList, renderer, m_cacheFolder)) {
+            AssetLoader::QueueAtlas(m_texturePathList, m_cacheFolder);
+            m_textureList.ForEach([](const string&, auto& info) { info->requested_ = true; });
+            return;
+        }
+        AssignAtlasTextures();
+    }
+    QueueMissingTextures();
+}
+
+void Managers::TextureManager::FinishTexture(const path& path, SDL_Surface* surface, SDL_Renderer* renderer) {
+    string textureName = Filesystem::GetFilename(path);
+    if (auto* info = m_textureList.Find(textureName))
+        (*info)->requested_ = false;
+
+    if (surface == nullptr) {
+        GKC_ENGINE_ERROR("Failed to load texture at path: {0}", path.string());
+        return;
+    }
+
+    auto texture = make_shared<Render::Texture>(surface, renderer);
+    if (!texture->IsValid()) {
+        GKC_ENGINE_ERROR("Failed to load texture at path: {0}", path.string());
+        return;
+    }
+
+    auto* info = m_textureList.Find(textureName);
+    if (info == nullptr) {
+        AddTexturePath(path.string());
+        info = m_textureList.Find(textureName);
+        if (info == nullptr)
+            return;
+    }
+    (*info)->bytes_ = texture->GetMemorySize();
+    (*info)->texture_ = std::move(texture);
+    GKC_ENGINE_INFO("'{}' texture loaded successfully", textureName);
+}
+
+void Managers::TextureManager::FinishAtlas(Render::BakedAtlas* baked, SDL_Renderer* renderer) {
+    m_textureList.ForEach([](const string&, auto& info) { info->requested_ = false; });
+
+    if (baked == nullptr || !m_atlas.Upload(*baked, renderer)) {
+        GKC_ENGINE_WARNING("Texture atlas couldn't be built, textures will be loaded individually");
+    } else {
+        AssignAtlasTextures();
+    }
+    QueueMissingTextures();
+}
+
+void Managers::TextureManager::ReloadTexture(const path& path, SDL_Renderer* renderer) {
+    string textureName = Filesystem::GetFilename(path);
+    auto* info = m_textureList.Find(textureName);
+    if (info == nullptr) {
+        AddTexturePath(path.string());
+        info = m_textureList.Find(textureName);
+        if (info == nullptr)
+            return;
+    }
+
+    GKC_ENGINE_INFO("Reloading texture '{}'", textureName);
+    if (AssetLoader::IsRunning()) {
+        (*info)->requested_ = true;
+        AssetLoader::QueueTexture(path);
+    } else {
+        LoadTexture(path.string(), renderer);
+    }
+}
+
+void Managers::TextureManager::AssignAtlasTextures() {
+    for (auto& path : m_texturePathList) {
+        string textureName = Filesystem::GetFilename(path);
+        auto* info = m_textureList.Find(textureName);
+        const Render::AtlasRegion* region = m_atlas.GetRegion(textureName);
+        if (info != nullptr && region != nullptr) {
+            (*info)->texture_ = make_shared<Render::Texture>(m_atlas.GetPage(region->page_), *region);
+            (*info)->bytes_ = 0;
+        }
+    }
+}
+
+void Managers::TextureManager::QueueMissingTextures() {
+    for (auto& path : m_texturePathList) {
+        auto* info = m_textureList.Find(Filesystem::GetFilename(path));
+        if (info == nullptr) {
+            AssetLoader::QueueTexture(path);
+        } else if ((*info)->texture_ == nullptr && !(*info)->requested_) {
+            (*info)->requested_ = true;
+            AssetLoader::QueueTexture(path);
+        }
+    }
+}
+
+bool Managers::TextureManager::BuildAtlas(SDL_Renderer* renderer) {
+    // Textures can still point to the old pages
+    m_textureList.ForEach([](const string&, auto& info) {
+        if (info->texture_ != nullptr && info->texture_->IsAtlased())
+            info->texture_ = nullptr;
+    });
+
+    if (!m_atlas.Build(m_texturePathList, renderer, m_cacheFolder)) {
+        GKC_ENGINE_WARNING("Texture atlas couldn't be built, textures will be loaded individually");
+        return false;
+    }
+    return true;
+}
+
+void Managers::TextureManager::DestroyAtlas() {
+    m_textureList.ForEach([](const string&, auto& info) {
+        if (info->texture_ != nullptr && info->texture_->IsAtlased())
+            info->texture_ = nullptr;
+    });
+    m_atlas.Clear();
+}
+
+const Galaktic::Render::AtlasRegion* Managers::TextureManager::GetAtlasRegion(TextureID id) {
+    auto texture = GetTextureByID(id);
+    if (texture == nullptr || !texture->IsAtlased())
+        return nullptr;
+    return &texture->GetAtlasRegion();
+}
+
 void Managers::TextureManager::DeleteTexture(const string& name) {
-    auto texture = m_textureList.find(name);
-    if (texture != m_textureList.end()) {
-        // The shared_ptr will be destroyed, which will call Texture destructor
-        // and destroy the SDL_Texture
-        m_textureList.erase(texture);
+    // The shared_ptr will be destroyed, which will call Texture destructor
+    // and destroy the SDL_Texture, the ID is invalidated so it won't point to another texture
+    if (m_textureList.Erase(name)) {
         GKC_ENGINE_INFO("Deleted texture: {0}", name);
     }
 }
@@ -98,32 +235,71 @@ void Managers::TextureManager::DestroyMissingTexture() {
 }
 
 shared_ptr<Render::Texture> Managers::TextureManager::GetTextureByName(const string &name) {
-    auto texture = m_textureList.find(name);
-    if (texture != m_textureList.end()) {
-        if(texture->second != nullptr) {
-            return texture->second->texture_;
-        }
-        GKC_ENGINE_WARNING("Texture key exist but hasn't been loaded yet!");
+    TextureID id = m_textureList.FindID(name);
+    if (id == 0) {
+        GKC_ENGINE_WARNING("Texture to retrieve doesn't exist!");
         return nullptr;
     }
-    GKC_ENGINE_WARNING("Texture to retrieve doesn't exist!");
-    return nullptr;
+    return GetTextureByID(id);
 }
 
 shared_ptr<Render::Texture> Managers::TextureManager::GetTextureByID(TextureID id) {
-    auto nameToFind = m_IDToNameList.find(id);
-    if (nameToFind != m_IDToNameList.end()) {
-        return GetTextureByName(nameToFind->second);
+    auto* texture = m_textureList.Get(id);
+    if (texture == nullptr) {
+        GKC_ENGINE_WARNING("Texture to retrieve doesn't exist");
+        return nullptr;
     }
-    GKC_ENGINE_WARNING("Texture to retrieve doesn't exist");
-    return nullptr;
+    if (*texture == nullptr) {
+        GKC_ENGINE_WARNING("Texture key exist but hasn't been loaded yet!");
+        return nullptr;
+    }
+
+    auto& info = **texture;
+    info.lastUsedFrame_ = AssetBudget::GetFrame();
+    // Evicted textures are reloaded in the background, the missing texture is drawn meanwhile
+    if (info.texture_ == nullptr && !info.requested_ && !info.path_.empty()
+        && AssetLoader::IsRunning()) {
+        info.requested_ = true;
+        AssetLoader::QueueTexture(info.path_);
+    }
+    return info.texture_;
+}
+
+Managers::AssetHandle<Render::Texture> Managers::TextureManager::AcquireTexture(TextureID id) {
+    return AssetHandle<Render::Texture>(id, GetTextureByID(id));
+}
+
+void Managers::TextureManager::Evict(size_t budget) {
+    size_t total = 0;
+    vector<EvictionCandidate> candidates;
+    m_textureList.ForEach([&](const string& name, auto& info) {
+        if (info->texture_ == nullptr)
+            return;
+        total += info->bytes_;
+
+        // Atlas pages are shared, and anything still referenced outside the list stays alive
+        if (info->texture_->IsAtlased() || info->texture_.use_count() > 1)
+            return;
+        candidates.emplace_back(name, info->lastUsedFrame_, info->bytes_);
+    });
+
+    auto evicted = AssetBudget::SelectEvictions(candidates, total, budget);
+    for (auto& name : evicted) {
+        auto& info = *m_textureList.Find(name);
+        info->texture_ = nullptr;
+        info->bytes_ = 0;
+        info->requested_ = false;
+    }
+
+    if (!evicted.empty())
+        GKC_ENGINE_INFO("Evicted {0} textures to fit the {1} bytes budget", evicted.size(), budget);
 }
 
 shared_ptr<Render::TextureInfo> Managers::TextureManager::GetTextureInfo(const string &textureName) {
-    auto it = m_textureList.find(textureName);
-    if(it != m_textureList.end()) {
-        if(it->second != nullptr) {
-            return it->second;
+    auto* info = m_textureList.Find(textureName);
+    if(info != nullptr) {
+        if(*info != nullptr) {
+            return *info;
         }
         GKC_ENGINE_WARNING("Texture Information is NULL!");
         return nullptr;
@@ -134,15 +310,15 @@ shared_ptr<Render::TextureInfo> Managers::TextureManager::GetTextureInfo(const s
 
 void Managers::TextureManager::PrintList() {
     /// So many nullptrs that can cause trouble dude
-    for (auto& pair : m_textureList) {
-        const void* textureAddress = TakeAdressOfTexture(pair.second.get());
+    m_textureList.ForEach([](const string& name, auto& info) {
+        const void* textureAddress = TakeAdressOfTexture(info.get());
 
         if(textureAddress == nullptr) {
-            GKC_ENGINE_INFO("Key: {0} | {1} Address: {2}", pair.first, pair.second->id_, "nullptr (needs to be loaded)");
+            GKC_ENGINE_INFO("Key: {0} | {1} Address: {2}", name, info->id_, "nullptr (needs to be loaded)");
         } else {
-            GKC_ENGINE_INFO("Key: {0} | {1} Address: {2}", pair.first, pair.second->id_, textureAddress);
+            GKC_ENGINE_INFO("Key: {0} | {1} Address: {2}", name, info->id_, textureAddress);
         }
-    }
+    });
 }
 
 const void* Managers::TextureManager::TakeAdressOfTexture(const Render::TextureInfo* textureInfo) {
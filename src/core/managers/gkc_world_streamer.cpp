@@ -0,0 +1,462 @@
+#include <core/managers/gkc_world_streamer.h>
+#include "core/gkc_logger.h"
+#include "core/managers/gkc_ecs_man.h"
+#include "filesys/gkc_byte_buffer.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_reader.h"
+#include "filesys/gkc_writer.h"
+#include <ecs/gkc_registry.h>
+
+using namespace Galaktic;
+using namespace Galaktic::Core::Managers;
+using namespace Galaktic::Filesystem;
+
+WorldStreamer::WorldStreamer(ECS_Manager& manager, ECS::Registry& registry)
+    : m_manager(manager), m_registry(registry), m_overlay(make_unique<ECS::Registry>()) {}
+
+WorldStreamer::~WorldStreamer() {
+    Close();
+}
+
+bool WorldStreamer::Open(const path& world) {
+    Close();
+
+    m_data = FindArchivedFile(world, m_size);
+    if (m_data == nullptr && m_file.Open(world)) {
+        m_data = m_file.GetData();
+        m_size = m_file.GetSize();
+    }
+    if (m_data == nullptr) {
+        GKC_ENGINE_ERROR("Failed to open the world '{0}'", world.string());
+        return false;
+    }
+
+    if (m_size < sizeof(WorldHeader)) {
+        GKC_ENGINE_ERROR("'{0}' is not a world", world.string());
+        Close();
+        return false;
+    }
+    std::memcpy(&m_header, m_data, sizeof(WorldHeader));
+    if (std::memcmp(m_header.magic_, GKC_WORLD_MAGIC, sizeof(GKC_WORLD_MAGIC)) != 0
+        || m_header.version_ != GKC_VERSION_WORLD || !(m_header.cellSize_ > 0.f)
+        || m_header.cellsOffset_ > m_size
+        || m_header.cellCount_ > (m_size - m_header.cellsOffset_) / sizeof(WorldCell)) {
+        GKC_ENGINE_ERROR("'{0}' is not a world or it's corrupted", world.string());
+        Close();
+        return false;
+    }
+
+    // Registered here on the main thread, the worker never writes to the registry
+    ECS::ComponentRegistry::RegisterEngineComponents();
+
+    m_cells.resize(m_header.cellCount_);
+    m_cellIndex.reserve(m_header.cellCount_);
+    vector<size_t> persistent;
+    for (size_t i = 0; i < m_cells.size(); ++i) {
+        WorldCell& entry = m_cells[i].entry_;
+        std::memcpy(&entry, m_data + m_header.cellsOffset_ + i * sizeof(WorldCell), sizeof(WorldCell));
+        if (entry.offset_ > m_size || entry.size_ > m_size - entry.offset_
+            || entry.offset_ % GKC_SCENE_ALIGNMENT != 0) {
+            GKC_ENGINE_ERROR("Cell ({0}, {1}) of '{2}' is out of the file", entry.x_, entry.y_, world.string());
+            Close();
+            return false;
+        }
+
+        if (entry.flags_ & WORLD_CELL_PERSISTENT)
+            persistent.push_back(i);
+        else
+            m_cellIndex.emplace(GetWorldCellKey(entry.x_, entry.y_), i);
+    }
+
+    // The persistent cells already need the entities kept by the overlay
+    m_overlayPath = world;
+    m_overlayPath += GKC_WORLD_OVERLAY_EXTENSION;
+    LoadOverlay();
+
+    // Entities created from now on can't take the ID of a cell that isn't loaded yet
+    m_manager.ReserveEntityIDs(m_header.maxEntityID_);
+    for (size_t index : persistent) {
+        CellResult result = LoadCell(index);
+        AddCell(result);
+    }
+
+    m_stop = false;
+    m_worker = std::thread(&WorldStreamer::WorkerLoop, this);
+    GKC_ENGINE_INFO("Streaming '{0}', {1} cells of {2} px", world.string(), m_header.cellCount_, m_header.cellSize_);
+    return true;
+}
+
+void WorldStreamer::Close() {
+    if (m_worker.joinable()) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        m_worker.join();
+    }
+    m_requests.clear();
+    m_results.clear();
+
+    for (Cell& cell : m_cells) {
+        if (cell.state_ == Cell_State::Loaded)
+            UnloadCell(cell);
+    }
+    m_cells.clear();
+    m_cellIndex.clear();
+    m_active.clear();
+    m_streamed.clear();
+    m_overlay->GetComponentPools().clear();
+    m_overlayIDs.clear();
+    m_destroyed.clear();
+    m_overlayPath.clear();
+    m_overlayChanged = false;
+    m_loadedCount = 0;
+    m_header = {};
+    m_file.Close();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+void WorldStreamer::SetRadius(float loadRadius, float unloadRadius) {
+    GKC_ASSERT(loadRadius > 0.f, "The load radius must be greater than 0");
+    m_loadRadius = loadRadius;
+    m_unloadRadius = std::max(loadRadius, unloadRadius);
+}
+
+void WorldStreamer::Update(Render::Vec2 center, double budgetMs) {
+    if (!IsOpen())
+        return;
+
+    // Far cells go first, the entities that left them can be handed to the cells that stay
+    for (size_t i = 0; i < m_active.size();) {
+        Cell& cell = m_cells[m_active[i]];
+        if (GetDistance(cell.entry_, center) <= m_unloadRadius) {
+            ++i;
+            continue;
+        }
+
+        if (cell.state_ == Cell_State::Loaded) {
+            UnloadCell(cell);
+        } else if (cell.state_ == Cell_State::Loading) {
+            // Cells the worker already took are dropped when they come back
+            std::lock_guard lock(m_mutex);
+            auto request = std::find(m_requests.begin(), m_requests.end(), m_active[i]);
+            if (request == m_requests.end()) {
+                ++i;
+                continue;
+            }
+            m_requests.erase(request);
+            cell.state_ = Cell_State::Unloaded;
+        }
+        m_active[i] = m_active.back();
+        m_active.pop_back();
+    }
+
+    // Cells inside the load radius, nearest first
+    const float cellSize = m_header.cellSize_;
+    vector<std::pair<float, size_t>> queued;
+    for (Sint32 y = GetWorldCell(center.y - m_loadRadius, cellSize);
+         y <= GetWorldCell(center.y + m_loadRadius, cellSize); ++y) {
+        for (Sint32 x = GetWorldCell(center.x - m_loadRadius, cellSize);
+             x <= GetWorldCell(center.x + m_loadRadius, cellSize); ++x) {
+            auto it = m_cellIndex.find(GetWorldCellKey(x, y));
+            if (it == m_cellIndex.end() || m_cells[it->second].state_ != Cell_State::Unloaded)
+                continue;
+            const float distance = GetDistance(m_cells[it->second].entry_, center);
+            if (distance <= m_loadRadius)
+                queued.emplace_back(distance, it->second);
+        }
+    }
+    if (!queued.empty()) {
+        std::sort(queued.begin(), queued.end());
+        {
+            std::lock_guard lock(m_mutex);
+            for (const auto& [distance, index] : queued) {
+                m_cells[index].state_ = Cell_State::Loading;
+                m_active.push_back(index);
+                m_requests.push_back(index);
+            }
+        }
+        m_condition.notify_one();
+    }
+
+    const Uint64 start = SDL_GetTicksNS();
+    const auto budget = static_cast<Uint64>(budgetMs * 1000000.0);
+    while (true) {
+        CellResult result;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_results.empty())
+                return;
+            result = std::move(m_results.front());
+            m_results.pop_front();
+        }
+
+        Cell& cell = m_cells[result.index_];
+        if (GetDistance(cell.entry_, center) > m_unloadRadius) {
+            cell.state_ = Cell_State::Unloaded;
+            m_active.erase(std::find(m_active.begin(), m_active.end(), result.index_));
+            continue;
+        }
+        AddCell(result);
+
+        if (SDL_GetTicksNS() - start >= budget)
+            return;
+    }
+}
+
+Cell_State WorldStreamer::GetCellState(Sint32 x, Sint32 y) const {
+    auto it = m_cellIndex.find(GetWorldCellKey(x, y));
+    return it != m_cellIndex.end() ? m_cells[it->second].state_ : Cell_State::Unloaded;
+}
+
+void WorldStreamer::WorkerLoop() {
+    while (true) {
+        size_t index = 0;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+                return;
+            index = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        CellResult result = LoadCell(index);
+        std::lock_guard lock(m_mutex);
+        m_results.push_back(std::move(result));
+    }
+}
+
+WorldStreamer::CellResult WorldStreamer::LoadCell(size_t index) const {
+    const WorldCell& entry = m_cells[index].entry_;
+    CellResult result;
+    result.index_ = index;
+    result.registry_ = make_unique<ECS::Registry>();
+
+    ECS_Manager manager(result.registry_.get());
+    string sceneName;
+    // Open() registered the engine components, the worker only reads the registry
+    result.loaded_ = FileReader::LoadScene(m_data + entry.offset_, static_cast<size_t>(entry.size_), manager,
+        result.registry_.get(), sceneName, false);
+    result.entities_.reserve(manager.GetEntityList().size());
+    for (const auto& [id, entity] : manager.GetEntityList())
+        result.entities_.push_back(id);
+    return result;
+}
+
+void WorldStreamer::AddCell(CellResult& result) {
+    Cell& cell = m_cells[result.index_];
+    if (!result.loaded_) {
+        GKC_ENGINE_ERROR("Cell ({0}, {1}) of the world is corrupted, it's skipped", cell.entry_.x_, cell.entry_.y_);
+        cell.state_ = Cell_State::Corrupted;
+        return;
+    }
+
+    // Entities still loaded (they left this cell before it was unloaded) keep their state,
+    // destroyed entities stay destroyed and the overlay has the last state of the changed ones
+    const auto& entities = m_manager.GetEntityList();
+    auto& pools = m_registry.GetComponentPools();
+    for (auto& [type, pool] : result.registry_->GetComponentPools()) {
+        auto& target = pools[type];
+        target.reserve(target.size() + pool.size());
+        for (auto& [id, component] : pool) {
+            if (!entities.contains(id) && !m_destroyed.contains(id) && !m_overlayIDs.contains(id))
+                target[id] = std::move(component);
+        }
+    }
+    // Loaded IDs that were never streamed belong to the scene, both can't be loaded at once
+    size_t collisions = 0;
+    EntityID firstCollision = 0;
+    for (EntityID id : result.entities_) {
+        if (entities.contains(id)) {
+            if (!m_streamed.contains(id) && collisions++ == 0)
+                firstCollision = id;
+            continue;
+        }
+        if (m_destroyed.contains(id))
+            continue;
+        if (m_overlayIDs.contains(id)) {
+            for (auto& [type, pool] : m_overlay->GetComponentPools()) {
+                if (auto it = pool.find(id); it != pool.end())
+                    pools[type][id] = it->second;
+            }
+        }
+        m_manager.AddStreamedEntity(id);
+        m_streamed.insert(id);
+        cell.entities_.push_back(id);
+    }
+    if (collisions > 0) {
+        GKC_ENGINE_ERROR("{0} entities of cell ({1}, {2}) weren't loaded, the scene has entities with "
+            "their IDs (e.g. {3}), world entities can't share IDs with the scene they're streamed into",
+            collisions, cell.entry_.x_, cell.entry_.y_, firstCollision);
+    }
+
+    cell.state_ = Cell_State::Loaded;
+    ++m_loadedCount;
+}
+
+void WorldStreamer::UnloadCell(Cell& cell) {
+    const auto& entities = m_manager.GetEntityList();
+    for (EntityID id : cell.entities_) {
+        if (!entities.contains(id)) {
+            KeepDestroyedEntity(id);
+            m_streamed.erase(id);
+            continue;
+        }
+        if (Cell* owner = FindLoadedCell(id); owner != nullptr && owner != &cell) {
+            owner->entities_.push_back(id);
+            continue;
+        }
+        if (HasChanges(id))
+            KeepEntity(id);
+        m_manager.UnloadEntity(id);
+        m_streamed.erase(id);
+    }
+
+    cell.entities_.clear();
+    cell.state_ = Cell_State::Unloaded;
+    --m_loadedCount;
+}
+
+void WorldStreamer::CollectChanges() {
+    if (!IsOpen())
+        return;
+
+    const auto& entities = m_manager.GetEntityList();
+    for (const auto& [type, changes] : m_registry.GetComponentChanges()) {
+        for (const auto* ids : { &changes.changed_, &changes.removed_ }) {
+            for (EntityID id : *ids) {
+                if (m_streamed.contains(id) && entities.contains(id))
+                    KeepEntity(id);
+            }
+        }
+    }
+    for (EntityID id : m_registry.GetDestroyedEntities()) {
+        if (m_streamed.contains(id))
+            KeepDestroyedEntity(id);
+    }
+}
+
+bool WorldStreamer::SaveOverlay() {
+    if (!m_overlayChanged || m_overlayPath.empty())
+        return true;
+
+    ByteBuffer buffer(m_destroyed.size() * sizeof(EntityID) + m_overlayIDs.size() * 64 + 256);
+    const size_t headerOffset = buffer.Reserve<WorldOverlayHeader>();
+    vector<EntityID> destroyed(m_destroyed.begin(), m_destroyed.end());
+    std::sort(destroyed.begin(), destroyed.end());
+    buffer.Append(destroyed.data(), destroyed.size() * sizeof(EntityID));
+
+    buffer.Align(GKC_SCENE_ALIGNMENT);
+    WorldOverlayHeader header{};
+    std::memcpy(header.magic_, GKC_WORLD_OVERLAY_MAGIC, sizeof(GKC_WORLD_OVERLAY_MAGIC));
+    header.version_ = GKC_VERSION_WORLD_OVERLAY;
+    header.destroyedCount_ = static_cast<Uint32>(destroyed.size());
+    header.sceneOffset_ = buffer.GetSize();
+
+    ECS::Entity_List changed;
+    changed.reserve(m_overlayIDs.size());
+    for (EntityID id : m_overlayIDs)
+        changed.emplace(id, ECS::Entity(id, m_overlay.get()));
+    FileWriter::SerializeScene(buffer, m_overlayPath.filename().string(), changed, m_overlay.get());
+    header.sceneSize_ = buffer.GetSize() - header.sceneOffset_;
+    buffer.Patch(headerOffset, header);
+
+    if (!WriteFileAtomic(m_overlayPath, buffer.GetData(), buffer.GetSize())) {
+        GKC_ENGINE_ERROR("Failed to write the overlay '{0}'", m_overlayPath.string());
+        return false;
+    }
+    m_overlayChanged = false;
+    return true;
+}
+
+void WorldStreamer::LoadOverlay() {
+    MappedFile file;
+    if (!CheckFile(m_overlayPath) || !file.Open(m_overlayPath))
+        return;
+
+    const Uint8* data = file.GetData();
+    const size_t size = file.GetSize();
+    WorldOverlayHeader header{};
+    if (size >= sizeof(header))
+        std::memcpy(&header, data, sizeof(header));
+    if (size < sizeof(header) || std::memcmp(header.magic_, GKC_WORLD_OVERLAY_MAGIC, sizeof(GKC_WORLD_OVERLAY_MAGIC)) != 0
+        || header.version_ != GKC_VERSION_WORLD_OVERLAY
+        || header.destroyedCount_ > (size - sizeof(header)) / sizeof(EntityID)
+        || header.sceneOffset_ > size || header.sceneSize_ > size - header.sceneOffset_) {
+        GKC_ENGINE_ERROR("'{0}' is not a world overlay or it's corrupted, the world is streamed as saved",
+            m_overlayPath.string());
+        return;
+    }
+
+    const auto* destroyed = reinterpret_cast<const EntityID*>(data + sizeof(header));
+    m_destroyed.insert(destroyed, destroyed + header.destroyedCount_);
+
+    ECS_Manager manager(m_overlay.get());
+    string sceneName;
+    if (!FileReader::LoadScene(data + header.sceneOffset_, static_cast<size_t>(header.sceneSize_), manager,
+        m_overlay.get(), sceneName, false)) {
+        GKC_ENGINE_ERROR("The changed entities of '{0}' are corrupted, they're streamed as saved",
+            m_overlayPath.string());
+        m_overlay->GetComponentPools().clear();
+        return;
+    }
+    for (const auto& [id, entity] : manager.GetEntityList())
+        m_overlayIDs.insert(id);
+    GKC_ENGINE_INFO("Loaded the overlay of the world, {0} changed and {1} destroyed entities",
+        m_overlayIDs.size(), m_destroyed.size());
+}
+
+void WorldStreamer::KeepEntity(EntityID id) {
+    // Components removed since it was last kept are dropped with the old state
+    auto& overlay = m_overlay->GetComponentPools();
+    for (auto& [type, pool] : overlay)
+        pool.erase(id);
+    for (auto& [type, pool] : m_registry.GetComponentPools()) {
+        if (auto it = pool.find(id); it != pool.end())
+            overlay[type][id] = it->second;
+    }
+    m_overlayIDs.insert(id);
+    m_overlayChanged = true;
+}
+
+void WorldStreamer::KeepDestroyedEntity(EntityID id) {
+    if (!m_destroyed.insert(id).second)
+        return;
+    for (auto& [type, pool] : m_overlay->GetComponentPools())
+        pool.erase(id);
+    m_overlayIDs.erase(id);
+    m_overlayChanged = true;
+}
+
+bool WorldStreamer::HasChanges(EntityID id) const {
+    for (const auto& [type, changes] : m_registry.GetComponentChanges()) {
+        if (changes.changed_.contains(id) || changes.removed_.contains(id))
+            return true;
+    }
+    return false;
+}
+
+WorldStreamer::Cell* WorldStreamer::FindLoadedCell(EntityID id) {
+    if (!m_registry.Has<ECS::TransformComponent>(id))
+        return nullptr;
+
+    const auto& transform = m_registry.Read<ECS::TransformComponent>(id);
+    const Render::Vec2 center = transform.m_location + transform.m_size * 0.5f;
+    auto it = m_cellIndex.find(GetWorldCellKey(GetWorldCell(center.x, m_header.cellSize_),
+        GetWorldCell(center.y, m_header.cellSize_)));
+    if (it == m_cellIndex.end() || m_cells[it->second].state_ != Cell_State::Loaded)
+        return nullptr;
+    return &m_cells[it->second];
+}
+
+float WorldStreamer::GetDistance(const WorldCell& cell, Render::Vec2 point) const {
+    const float size = m_header.cellSize_;
+    const float left = static_cast<float>(cell.x_) * size;
+    const float top = static_cast<float>(cell.y_) * size;
+    const float dx = std::max({ left - point.x, 0.f, point.x - (left + size) });
+    const float dy = std::max({ top - point.y, 0.f, point.y - (top + size) });
+    return std::sqrt(dx * dx + dy * dy);
+}
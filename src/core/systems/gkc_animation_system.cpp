@@ -0,0 +1,106 @@
+#include <core/systems/gkc_animation_system.h>
+#include "core/managers/gkc_animation_man.h"
+#include "render/gkc_animation.h"
+#include "ecs/gkc_registry.h"
+#include "ecs/gkc_components.h"
+
+using namespace Galaktic::Core;
+
+void Systems::AnimationSystem::Update(float dt) {
+    Gather();
+
+    const size_t count = m_components.size();
+    float* elapsed = m_elapsed.data();
+    const float* speeds = m_speeds.data();
+    for (size_t i = 0; i < count; ++i) {
+        elapsed[i] += dt * speeds[i];
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (elapsed[i] >= m_delays[i]) {
+            Advance(i);
+        } else {
+            m_components[i]->m_elapsed = elapsed[i];
+        }
+    }
+
+    // Don't keep the animations alive between updates, they could be evicted
+    m_animationCache.clear();
+}
+
+void Systems::AnimationSystem::Gather() {
+    m_components.clear();
+    m_animations.clear();
+    m_elapsed.clear();
+    m_speeds.clear();
+    m_delays.clear();
+    m_animationCache.clear();
+
+    auto* pool = m_registry.GetPool<ECS::AnimationComponent>();
+    if (pool == nullptr)
+        return;
+
+    for (auto& [id, component] : *pool) {
+        auto& animationComp = std::any_cast<ECS::AnimationComponent&>(component);
+        if (!animationComp.m_isPlaying)
+            continue;
+
+        if (m_registry.Has<ECS::VisibilityComponent>(id)
+            && !m_registry.Read<ECS::VisibilityComponent>(id).m_visible) {
+            continue;
+        }
+
+        auto cached = m_animationCache.find(animationComp.m_id);
+        if (cached == m_animationCache.end()) {
+            cached = m_animationCache.emplace(animationComp.m_id,
+                Managers::AnimationManager::FindAnimation(animationComp.m_id)).first;
+        }
+
+        const Render::Animation* animation = cached->second.get();
+        if (animation == nullptr || !animation->IsValid())
+            continue;
+
+        if (animationComp.m_frame >= static_cast<Uint32>(animation->GetFrameCount())) {
+            animationComp.m_frame = 0;
+        }
+
+        // Advanced on the worker threads, the change is recorded here
+        m_registry.MarkChanged<ECS::AnimationComponent>(id);
+        m_components.push_back(&animationComp);
+        m_animations.push_back(animation);
+        m_elapsed.push_back(animationComp.m_elapsed);
+        m_speeds.push_back(animationComp.m_speed);
+        m_delays.push_back(animation->GetFrame(static_cast<int>(animationComp.m_frame))->delay_);
+    }
+}
+
+void Systems::AnimationSystem::Advance(size_t index) {
+    auto& animationComp = *m_components[index];
+    const Render::Animation* animation = m_animations[index];
+    const auto frameCount = static_cast<Uint32>(animation->GetFrameCount());
+    float elapsed = m_elapsed[index];
+
+    // A long frame time can skip several frames, but never more than a full loop
+    Uint32 step = 0;
+    for (; step < frameCount && animationComp.m_isPlaying; ++step) {
+        float delay = animation->GetFrame(static_cast<int>(animationComp.m_frame))->delay_;
+        if (elapsed < delay)
+            break;
+
+        elapsed -= delay;
+        if (animationComp.m_frame + 1 < frameCount) {
+            animationComp.m_frame++;
+        } else if (animationComp.m_isLooping) {
+            animationComp.m_frame = 0;
+        } else {
+            animationComp.m_isPlaying = false;
+            elapsed = 0.f;
+        }
+    }
+
+    // Too far behind (huge delta time or zero delays), drop the remaining time
+    if (step == frameCount) {
+        elapsed = 0.f;
+    }
+    animationComp.m_elapsed = elapsed;
+}
@@ -0,0 +1,124 @@
+#include <core/systems/gkc_audio_system.h>
+#include "core/managers/gkc_audio_man.h"
+#include "ecs/gkc_registry.h"
+#include "ecs/gkc_components.h"
+
+using namespace Galaktic::Core;
+using Galaktic::Core::Managers::AudioManager;
+
+Systems::AudioSystem::~AudioSystem() {
+    for (auto& [id, state] : m_emitters)
+        AudioManager::StopVoice(state.voice_);
+}
+
+void Systems::AudioSystem::Update(float dt) {
+    ++m_frame;
+    m_pending.clear();
+    m_parameters.clear();
+
+    auto* pool = m_registry.GetPool<ECS::AudioEmitterComponent>();
+    if (pool != nullptr) {
+        for (auto& [id, component] : *pool) {
+            auto& emitter = std::any_cast<ECS::AudioEmitterComponent&>(component);
+
+            auto state = m_emitters.find(id);
+            if (state != m_emitters.end() && !AudioManager::IsVoicePlaying(state->second.voice_)) {
+                // One shots that ended or were stolen are done, looping emitters take a voice
+                // again once one is free
+                AudioManager::ConsumeStolenVoice(state->second.voice_);
+                if (!emitter.m_isLooping)
+                    FinishOneShot(id, emitter);
+                m_emitters.erase(state);
+                state = m_emitters.end();
+            }
+
+            if (!emitter.m_isPlaying || emitter.m_id == 0 || !m_registry.Has<ECS::TransformComponent>(id))
+                continue;
+
+            auto& transform = m_registry.Read<ECS::TransformComponent>(id);
+            Render::Vec2 offset = transform.m_location + transform.m_size * 0.5f - m_listener;
+            float gain = 0.f;
+            float pan = 0.f;
+            if (!Attenuate(emitter, offset, gain, pan)) {
+                // Its voice isn't stamped and fades out below
+                if (!emitter.m_isLooping)
+                    FinishOneShot(id, emitter);
+                continue;
+            }
+
+            if (state == m_emitters.end()) {
+                m_pending.emplace_back(id, &emitter, gain, pan);
+                continue;
+            }
+
+            auto& current = state->second;
+            current.frame_ = m_frame;
+            if (std::abs(gain - current.gain_) > GKC_AUDIO_PARAMETER_EPSILON
+                || std::abs(pan - current.pan_) > GKC_AUDIO_PARAMETER_EPSILON) {
+                current.gain_ = gain;
+                current.pan_ = pan;
+                m_parameters.emplace_back(current.voice_, gain, pan);
+            }
+        }
+    }
+
+    // Culled, stopped or removed emitters weren't stamped this update
+    for (auto it = m_emitters.begin(); it != m_emitters.end(); ) {
+        if (it->second.frame_ != m_frame) {
+            AudioManager::StopVoice(it->second.voice_, GKC_AUDIO_EMITTER_FADE_MS);
+            it = m_emitters.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    AudioManager::SetVoiceParameters(m_parameters);
+    StartPending();
+}
+
+void Systems::AudioSystem::StartPending() {
+    // The most important and loudest emitters take the free voices first
+    std::sort(m_pending.begin(), m_pending.end(), [](const PendingEmitter& a, const PendingEmitter& b) {
+        if (a.emitter_->m_priority != b.emitter_->m_priority)
+            return a.emitter_->m_priority > b.emitter_->m_priority;
+        return a.gain_ > b.gain_;
+    });
+
+    for (auto& pending : m_pending) {
+        const auto& emitter = *pending.emitter_;
+        Audio::VoiceID voice = AudioManager::PlayVoice(emitter.m_id, emitter.m_isLooping ? -1 : 0,
+            emitter.m_priority, pending.gain_, pending.pan_);
+
+        // Every voice plays something as important, the rest has an equal or lower priority
+        if (voice == Audio::GKC_INVALID_VOICE)
+            break;
+        m_emitters.emplace(pending.id_, EmitterState{ voice, pending.gain_, pending.pan_, m_frame });
+    }
+}
+
+void Systems::AudioSystem::FinishOneShot(EntityID id, ECS::AudioEmitterComponent& emitter) {
+    emitter.m_isPlaying = false;
+    m_registry.MarkChanged<ECS::AudioEmitterComponent>(id);
+}
+
+bool Systems::AudioSystem::Attenuate(const ECS::AudioEmitterComponent& emitter, const Render::Vec2& offset,
+    float& gain, float& pan) {
+    const float maxDistance = emitter.m_maxDistance;
+    const float distanceSquared = offset.x * offset.x + offset.y * offset.y;
+    if (maxDistance <= 0.f || distanceSquared >= maxDistance * maxDistance)
+        return false;
+
+    const float distance = std::sqrt(distanceSquared);
+    const float minDistance = std::min(emitter.m_minDistance, maxDistance);
+    float falloff = 1.f;
+    if (distance > minDistance && maxDistance > minDistance)
+        falloff = 1.f - (distance - minDistance) / (maxDistance - minDistance);
+
+    // Squared falloff sounds closer to how loudness is perceived than a linear one
+    gain = emitter.m_volume * falloff * falloff;
+    if (gain <= GKC_AUDIO_MIN_GAIN)
+        return false;
+
+    pan = std::clamp(offset.x / maxDistance, -1.f, 1.f);
+    return true;
+}
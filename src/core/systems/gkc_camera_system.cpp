@@ -21,11 +21,12 @@ void Systems::CameraSystem::Update(const ECS::Entity_List& list, float dt,
             continue;
         }
 
-        auto& cameraComp = m_activeCamera.Get<ECS::CameraComponent>();
-
-        if (entity.Has<ECS::TransformComponent>() && cameraComp.m_entityToFollowID == id
-            && cameraComp.m_isActive) {
-            auto& transform = entity.Get<ECS::TransformComponent>();
+        // Get() marks the camera as changed, it's only taken to follow the entity
+        if (const auto& followed = m_activeCamera.Read<ECS::CameraComponent>();
+            entity.Has<ECS::TransformComponent>() && followed.m_entityToFollowID == id
+            && followed.m_isActive) {
+            auto& cameraComp = m_activeCamera.Get<ECS::CameraComponent>();
+            auto& transform = entity.Read<ECS::TransformComponent>();
             Render::Vec2 desiredLocation;
             desiredLocation.x = transform.m_location.x - static_cast<float>(width)  * 0.5f;
             desiredLocation.y = transform.m_location.y - static_cast<float>(height) * 0.5f;
@@ -47,7 +48,7 @@ void Systems::CameraSystem::FindPrimaryCamera(const ECS::Entity_List& list) {
         auto& entity = pair.second;
 
         if (entity.Has<ECS::CameraComponent>()) {
-            auto& cameraComp = entity.Get<ECS::CameraComponent>();
+            auto& cameraComp = entity.Read<ECS::CameraComponent>();
             if (cameraComp.m_isActive) {
                 m_activeCamera = entity;
                 break;
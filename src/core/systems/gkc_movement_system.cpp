@@ -16,22 +16,25 @@ void MovementSystem::Update(const Entity_List& list, float dt) {
             || !entity.second.Has<PlayerTag>())
             continue;
 
-        auto& transform = entity.second.Get<TransformComponent>();
-        auto& player = entity.second.Get<SpeedComponent>();
+        const auto& player = entity.second.Read<SpeedComponent>();
         // Movement Updates
         if (player.m_maxSpeed * dt == player.m_maxSpeed) {
             continue;
         }
 
         // Modify this to use the Player.lua file
+        Render::Vec2 move{};
         if (m_keySystem.IsKeyDown(Key::W))
-            transform.m_location.y -= player.m_maxSpeed * dt;
+            move.y -= player.m_maxSpeed * dt;
         if (m_keySystem.IsKeyDown(Key::S))
-            transform.m_location.y += player.m_maxSpeed * dt;
+            move.y += player.m_maxSpeed * dt;
         if (m_keySystem.IsKeyDown(Key::A))
-            transform.m_location.x -= player.m_maxSpeed * dt;
+            move.x -= player.m_maxSpeed * dt;
         if (m_keySystem.IsKeyDown(Key::D))
-            transform.m_location.x += player.m_maxSpeed   * dt;
+            move.x += player.m_maxSpeed * dt;
+        // Get() marks the transform as changed, it's only taken when the player moves
+        if (move.x != 0.f || move.y != 0.f)
+            entity.second.Get<TransformComponent>().m_location += move;
         if(m_keySystem.IsKeyDown(Key::Space))
             ApplyJump(entity.second);
     }
@@ -39,7 +42,7 @@ void MovementSystem::Update(const Entity_List& list, float dt) {
 
 void MovementSystem::ApplyJump(ECS::Entity &entity) {
     if (entity.Has<ECS::PlayerTag>() && entity.Has<ECS::JumpComponent>() && entity.Has<ECS::RigidBody>()) {
-        auto& jump_comp = entity.Get<ECS::JumpComponent>();
+        const auto& jump_comp = entity.Read<ECS::JumpComponent>();
         entity.Get<ECS::RigidBody>().m_force.y += jump_comp.m_jumpHeight;
     }
 }
\ No newline at end of file
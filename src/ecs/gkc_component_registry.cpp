@@ -2,4 +2,35 @@
 
 namespace Galaktic::ECS {
     unordered_map<type_index, ComponentTypeInfo> ComponentRegistry::m_compTypes;
+    std::shared_mutex ComponentRegistry::m_mutex;
+    std::atomic<bool> ComponentRegistry::m_engineRegistered = false;
+
+    void ComponentRegistry::RegisterEngineComponents() {
+        // Called by every scene load, from the saver and streamer threads as well
+        if (m_engineRegistered.load())
+            return;
+
+        RegisterComponent<TransformComponent>(InvalidEntity);
+        RegisterComponent<HealthComponent>(InvalidEntity);
+        RegisterComponent<JumpComponent>(InvalidEntity);
+        RegisterComponent<RigidBody>(InvalidEntity);
+        RegisterComponent<CollisionComponent>(InvalidEntity);
+        RegisterComponent<SpeedComponent>(InvalidEntity);
+        RegisterComponent<ColorComponent>(InvalidEntity);
+        RegisterComponent<NameComponent>(InvalidEntity);
+        RegisterComponent<LightComponent>(InvalidEntity);
+        RegisterComponent<CameraComponent>(InvalidEntity);
+        RegisterComponent<TextureComponent>(InvalidEntity);
+        RegisterComponent<ScriptComponent>(InvalidEntity);
+        RegisterComponent<AnimationComponent>(InvalidEntity);
+        RegisterComponent<VisibilityComponent>(InvalidEntity);
+        RegisterComponent<AudioEmitterComponent>(InvalidEntity);
+        RegisterComponent<PhysicsObjectTag>(InvalidEntity, true);
+        RegisterComponent<StaticObjectTag>(InvalidEntity, true);
+        RegisterComponent<LightTag>(InvalidEntity, true);
+        RegisterComponent<PlayerTag>(InvalidEntity, true);
+        RegisterComponent<EnemyTag>(InvalidEntity, true);
+        RegisterComponent<CameraTag>(InvalidEntity, true);
+        m_engineRegistered = true;
+    }
 }
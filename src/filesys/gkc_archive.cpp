@@ -0,0 +1,465 @@
+#include <filesys/gkc_archive.h>
+#include "core/gkc_hash.h"
+#include "core/gkc_logger.h"
+#include "core/gkc_exception.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_writer.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace Galaktic;
+using namespace Galaktic::Filesystem;
+
+namespace {
+    constexpr char ARCHIVE_MAGIC[4] = { 'G', 'K', 'P', 'K' };
+
+    struct MountedArchive {
+        Archive archive_;
+        path mountPoint_;
+    };
+
+    // Mounted once at startup and read only afterwards, the asset loader threads read it too
+    vector<unique_ptr<MountedArchive>> s_mountedArchives;
+
+    /**
+     * @return true if the range is inside the file, written so offset + bytes can't wrap
+     */
+    bool IsRangeValid(Uint64 offset, Uint64 bytes, size_t size) {
+        return offset <= size && bytes <= size - offset;
+    }
+
+    /**
+     * @brief Converts a path into the name used inside an archive mounted at mountPoint
+     * @return false if the path isn't inside the mount point
+     */
+    bool MakeArchiveName(const path& file, const path& mountPoint, string& name) {
+        path relative = file.lexically_normal().lexically_relative(mountPoint.lexically_normal());
+        if (relative.empty())
+            return false;
+
+        name = relative.generic_string();
+        return name != "." && !name.starts_with("..");
+    }
+
+    void WritePadding(ofstream& file, Uint64 alignment) {
+        static constexpr char zeros[GKC_ARCHIVE_ALIGNMENT] = {};
+        auto position = static_cast<Uint64>(file.tellp());
+        Uint64 padding = (alignment - position % alignment) % alignment;
+        file.write(zeros, static_cast<std::streamsize>(padding));
+    }
+}
+
+// Mapped File
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const path& file) {
+    Close();
+
+    #ifdef _WIN32
+        HANDLE handle = CreateFileW(file.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+            CloseHandle(handle);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(handle);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(handle);
+            return false;
+        }
+
+        m_file = handle;
+        m_mapping = mapping;
+        m_data = static_cast<const Uint8*>(data);
+        m_size = static_cast<size_t>(size.QuadPart);
+    #else
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        close(fd);
+        if (data == MAP_FAILED)
+            return false;
+
+        m_data = static_cast<const Uint8*>(data);
+        m_size = static_cast<size_t>(info.st_size);
+    #endif
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data == nullptr)
+        return;
+
+    #ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+        m_mapping = nullptr;
+        m_file = nullptr;
+    #else
+        munmap(const_cast<Uint8*>(m_data), m_size);
+    #endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// Archive
+
+bool Archive::Open(const path& file) {
+    Close();
+    if (!m_file.Open(file)) {
+        GKC_ENGINE_ERROR("Failed to map archive: {0}", file.string());
+        return false;
+    }
+
+    const size_t size = m_file.GetSize();
+    ArchiveHeader header{};
+    if (size < sizeof(header)) {
+        GKC_ENGINE_ERROR("'{0}' is not an archive", file.string());
+        Close();
+        return false;
+    }
+    std::memcpy(&header, m_file.GetData(), sizeof(header));
+
+    if (std::memcmp(header.magic_, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+        GKC_ENGINE_ERROR("'{0}' is not an archive", file.string());
+        Close();
+        return false;
+    }
+    if (header.version_ != GKC_VERSION_ARCHIVE) {
+        GKC_ENGINE_ERROR("'{0}' archive version {1} is not supported (expected {2})", file.string(),
+            header.version_, GKC_VERSION_ARCHIVE);
+        Close();
+        return false;
+    }
+
+    const Uint64 tocSize = static_cast<Uint64>(header.entryCount_) * sizeof(ArchiveEntry);
+    if (header.tocOffset_ % alignof(ArchiveEntry) != 0 || !IsRangeValid(header.tocOffset_, tocSize, size)
+        || header.namesOffset_ > size) {
+        GKC_ENGINE_ERROR("'{0}' archive is corrupted", file.string());
+        Close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const ArchiveEntry*>(m_file.GetData() + header.tocOffset_);
+    m_names = reinterpret_cast<const char*>(m_file.GetData() + header.namesOffset_);
+    m_entryCount = header.entryCount_;
+
+    for (size_t i = 0; i < m_entryCount; ++i) {
+        const ArchiveEntry& entry = m_entries[i];
+        if (!IsRangeValid(entry.offset_, entry.size_, size)
+            || !IsRangeValid(entry.nameOffset_, entry.nameLength_, size - header.namesOffset_)) {
+            GKC_ENGINE_ERROR("'{0}' archive is corrupted", file.string());
+            Close();
+            return false;
+        }
+    }
+
+    m_path = file;
+    GKC_ENGINE_INFO("Opened archive '{0}' with {1} files", file.string(), m_entryCount);
+    return true;
+}
+
+void Archive::Close() {
+    m_file.Close();
+    m_entries = nullptr;
+    m_names = nullptr;
+    m_entryCount = 0;
+    m_path.clear();
+}
+
+const ArchiveEntry* Archive::Find(std::string_view name) const {
+    if (m_entries == nullptr)
+        return nullptr;
+
+    const Uint64 hash = Core::HashFNV1a(name);
+    const ArchiveEntry* end = m_entries + m_entryCount;
+    const ArchiveEntry* it = std::lower_bound(m_entries, end, hash,
+        [](const ArchiveEntry& entry, Uint64 value) { return entry.hash_ < value; });
+
+    // Colliding hashes are stored next to each other
+    for (; it != end && it->hash_ == hash; ++it) {
+        if (GetName(*it) == name)
+            return it;
+    }
+    return nullptr;
+}
+
+const Uint8* Archive::GetData(const ArchiveEntry& entry) const {
+    return m_file.GetData() + entry.offset_;
+}
+
+std::string_view Archive::GetName(const ArchiveEntry& entry) const {
+    return { m_names + entry.nameOffset_, entry.nameLength_ };
+}
+
+bool Archive::Pack(const path& root, const vector<path>& folders, const path& output) {
+    using Filesystem::FileWriter;
+
+    ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        GKC_ENGINE_ERROR("Failed to create archive: {0}", output.string());
+        return false;
+    }
+
+    ArchiveHeader header{};
+    std::memcpy(header.magic_, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version_ = GKC_VERSION_ARCHIVE;
+    FileWriter::Write(file, header);
+
+    vector<ArchiveEntry> entries;
+    string names;
+    vector<char> buffer;
+    for (auto& folder : folders) {
+        for (auto& filename : GetFilenamesInFolder(root / folder)) {
+            path filePath = filename;
+            if (filePath.extension() == GKC_ARCHIVE_EXTENSION)
+                continue;
+
+            string name;
+            if (!MakeArchiveName(filePath, root, name))
+                continue;
+
+            ifstream input(filePath, std::ios::binary | std::ios::ate);
+            if (!input.is_open()) {
+                GKC_ENGINE_WARNING("Skipping '{0}', it couldn't be opened", filePath.string());
+                continue;
+            }
+            auto size = static_cast<size_t>(input.tellg());
+            buffer.resize(size);
+            input.seekg(0);
+            input.read(buffer.data(), static_cast<std::streamsize>(size));
+
+            WritePadding(file, GKC_ARCHIVE_ALIGNMENT);
+            ArchiveEntry entry{};
+            entry.hash_ = Core::HashFNV1a(name);
+            entry.offset_ = static_cast<Uint64>(file.tellp());
+            entry.size_ = size;
+            entry.rawSize_ = size;
+            entry.nameOffset_ = static_cast<Uint32>(names.size());
+            entry.nameLength_ = static_cast<Uint32>(name.size());
+            entry.flags_ = ARCHIVE_FLAG_NONE;
+            file.write(buffer.data(), static_cast<std::streamsize>(size));
+
+            names += name;
+            entries.push_back(entry);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [&names](const ArchiveEntry& a, const ArchiveEntry& b) {
+        if (a.hash_ != b.hash_)
+            return a.hash_ < b.hash_;
+        return names.compare(a.nameOffset_, a.nameLength_, names, b.nameOffset_, b.nameLength_) < 0;
+    });
+
+    WritePadding(file, GKC_ARCHIVE_ALIGNMENT);
+    header.tocOffset_ = static_cast<Uint64>(file.tellp());
+    header.entryCount_ = static_cast<Uint32>(entries.size());
+    file.write(reinterpret_cast<const char*>(entries.data()),
+        static_cast<std::streamsize>(entries.size() * sizeof(ArchiveEntry)));
+
+    header.namesOffset_ = static_cast<Uint64>(file.tellp());
+    file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    file.seekp(0);
+    FileWriter::Write(file, header);
+    if (!file.good()) {
+        GKC_ENGINE_ERROR("Failed to write archive: {0}", output.string());
+        return false;
+    }
+
+    GKC_ENGINE_INFO("Packed {0} files into '{1}'", entries.size(), output.string());
+    return true;
+}
+
+// Mounting
+
+bool Filesystem::MountArchive(const path& archivePath, const path& mountPoint) {
+    auto mounted = make_unique<MountedArchive>();
+    if (!mounted->archive_.Open(archivePath))
+        return false;
+
+    mounted->mountPoint_ = mountPoint;
+    s_mountedArchives.push_back(std::move(mounted));
+    GKC_ENGINE_INFO("Mounted '{0}' at '{1}'", archivePath.string(), mountPoint.string());
+    return true;
+}
+
+void Filesystem::MountArchivesInFolder(const path& folder) {
+    if (!CheckDirectory(folder))
+        return;
+
+    for (const auto& entry : std::filesystem::directory_iterator(folder)) {
+        if (entry.is_regular_file() && entry.path().extension() == GKC_ARCHIVE_EXTENSION)
+            MountArchive(entry.path(), folder);
+    }
+}
+
+void Filesystem::UnmountArchives() {
+    s_mountedArchives.clear();
+}
+
+const Uint8* Filesystem::FindArchivedFile(const path& file, size_t& size) {
+    string name;
+    for (auto& mounted : s_mountedArchives) {
+        if (!MakeArchiveName(file, mounted->mountPoint_, name))
+            continue;
+
+        const ArchiveEntry* entry = mounted->archive_.Find(name);
+        if (entry == nullptr)
+            continue;
+
+        if (entry->flags_ & ARCHIVE_FLAG_COMPRESSED) {
+            GKC_ENGINE_ERROR("'{0}' is compressed, compressed archive entries aren't supported", name);
+            return nullptr;
+        }
+        size = entry->size_;
+        return mounted->archive_.GetData(*entry);
+    }
+    return nullptr;
+}
+
+const Archive* Filesystem::FindFileArchive(const path& file) {
+    string name;
+    for (auto& mounted : s_mountedArchives) {
+        if (MakeArchiveName(file, mounted->mountPoint_, name) && mounted->archive_.Find(name) != nullptr)
+            return &mounted->archive_;
+    }
+    return nullptr;
+}
+
+vector<string> Filesystem::GetArchivedFilesInFolder(const path& folder) {
+    vector<string> files;
+    string prefix;
+    for (auto& mounted : s_mountedArchives) {
+        if (!MakeArchiveName(folder, mounted->mountPoint_, prefix))
+            continue;
+        prefix += '/';
+
+        const Archive& archive = mounted->archive_;
+        for (size_t i = 0; i < archive.GetEntryCount(); ++i) {
+            std::string_view name = archive.GetName(archive.GetEntry(i));
+            if (name.starts_with(prefix))
+                files.push_back((mounted->mountPoint_ / path(name)).string());
+        }
+    }
+    return files;
+}
+
+bool Filesystem::AssetExists(const path& file) {
+    size_t size = 0;
+    return FindArchivedFile(file, size) != nullptr || CheckFile(file);
+}
+
+SDL_IOStream* Filesystem::OpenAssetIO(const path& file) {
+    size_t size = 0;
+    if (const Uint8* data = FindArchivedFile(file, size); data != nullptr) {
+        return SDL_IOFromConstMem(data, size);
+    }
+
+    SDL_IOStream* io = SDL_IOFromFile(file.string().c_str(), "rb");
+    if (io == nullptr) {
+        GKC_ENGINE_ERROR("Failed to open '{0}': {1}", file.string(), SDL_GetError());
+    }
+    return io;
+}
+
+const Uint8* Filesystem::ReadAsset(const path& file, vector<Uint8>& storage, size_t& size) {
+    if (const Uint8* data = FindArchivedFile(file, size); data != nullptr) {
+        return data;
+    }
+
+    ifstream input(file, std::ios::binary | std::ios::ate);
+    if (!input.is_open()) {
+        GKC_ENGINE_ERROR("Failed to open '{0}'", file.string());
+        return nullptr;
+    }
+    size = static_cast<size_t>(input.tellg());
+    storage.resize(size);
+    input.seekg(0);
+    input.read(reinterpret_cast<char*>(storage.data()), static_cast<std::streamsize>(size));
+    if (!input.good()) {
+        GKC_ENGINE_ERROR("Failed to read '{0}'", file.string());
+        return nullptr;
+    }
+    return storage.data();
+}
+
+// Streams
+
+void MemoryStreamBuf::SetData(const Uint8* data, size_t size) {
+    // std::streambuf only takes mutable pointers, the data is never written
+    char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+    setg(begin, begin, begin + size);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(off_type offset, std::ios_base::seekdir dir,
+    std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+        base = gptr() - eback();
+    else if (dir == std::ios_base::end)
+        base = egptr() - eback();
+
+    const off_type target = base + offset;
+    if (target < 0 || target > egptr() - eback())
+        return pos_type(off_type(-1));
+
+    setg(eback(), eback() + target, egptr());
+    return pos_type(target);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type position, std::ios_base::openmode which) {
+    return seekoff(off_type(position), std::ios_base::beg, which);
+}
+
+AssetStream::AssetStream(const path& file) : std::istream(nullptr) {
+    size_t size = 0;
+    if (const Uint8* data = FindArchivedFile(file, size); data != nullptr) {
+        m_memory.SetData(data, size);
+        rdbuf(&m_memory);
+        m_isOpen = true;
+    } else if (m_file.open(file, std::ios::in | std::ios::binary) != nullptr) {
+        rdbuf(&m_file);
+        m_isOpen = true;
+    } else {
+        setstate(std::ios::failbit);
+    }
+}
@@ -0,0 +1,253 @@
+#include <filesys/gkc_asset_index.h>
+#include "core/gkc_logger.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_byte_buffer.h"
+#include "filesys/gkc_filesys.h"
+
+using namespace Galaktic;
+using namespace Galaktic::Filesystem;
+
+path AssetIndex::m_projectPath;
+path AssetIndex::m_indexFile;
+map<string, AssetIndex::IndexedFolder> AssetIndex::m_folders;
+Sint64 AssetIndex::m_time = 0;
+std::mutex AssetIndex::m_mutex;
+
+namespace {
+    constexpr char ASSET_INDEX_MAGIC[4] = { 'G', 'K', 'A', 'I' };
+
+    struct IndexHeader {
+        char magic_[4];
+        Uint32 version_;
+        Uint32 folderCount_;
+        Uint32 reserved_;
+        Sint64 time_;           // When the folders were listed
+    };
+
+    constexpr std::string_view TEXTURE_EXTENSIONS[] = { ".png", ".jpg", ".jpeg", ".webp", ".bmp", ".gif" };
+    constexpr std::string_view ANIMATION_EXTENSIONS[] = { ".gif", ".apng" };
+    constexpr std::string_view AUDIO_EXTENSIONS[] = { ".wav", ".mp3", ".mp2", ".aiff", ".aac", ".ogg" };
+    constexpr std::string_view SCRIPT_EXTENSIONS[] = { ".lua" };
+    constexpr std::string_view TILEMAP_EXTENSIONS[] = { ".gktilemap" };
+
+    std::span<const std::string_view> GetExtensions(Asset_Type type) {
+        switch (type) {
+            case Asset_Type::Texture: return TEXTURE_EXTENSIONS;
+            case Asset_Type::Animation: return ANIMATION_EXTENSIONS;
+            case Asset_Type::Audio: return AUDIO_EXTENSIONS;
+            case Asset_Type::Script: return SCRIPT_EXTENSIONS;
+            case Asset_Type::Tilemap: return TILEMAP_EXTENSIONS;
+        }
+        return {};
+    }
+
+    /**
+     * @brief Reads a list of strings written by \c WriteStrings()
+     */
+    bool ReadStrings(ByteReader& reader, vector<string>& strings) {
+        Uint32 count = 0;
+        // Every string takes at least its length, a bigger count is corrupted
+        if (!reader.Read(count) || count > reader.GetRemaining() / sizeof(Uint32))
+            return false;
+        strings.resize(count);
+        for (string& str : strings) {
+            if (!reader.ReadString(str))
+                return false;
+        }
+        return true;
+    }
+
+    void WriteStrings(ByteBuffer& buffer, const vector<string>& strings) {
+        buffer.Write(static_cast<Uint32>(strings.size()));
+        for (const string& str : strings)
+            buffer.WriteString(str);
+    }
+}
+
+bool Filesystem::IsAssetExtension(const path& file, Asset_Type type) {
+    const string extension = file.extension().string();
+    for (std::string_view valid : GetExtensions(type)) {
+        if (extension == valid)
+            return true;
+    }
+    return false;
+}
+
+void AssetIndex::Open(const path& projectPath, const path& indexFile) {
+    std::lock_guard lock(m_mutex);
+    m_projectPath = projectPath.lexically_normal();
+    m_indexFile = indexFile;
+    m_folders.clear();
+    m_time = 0;
+    if (!Load()) {
+        m_folders.clear();
+        m_time = 0;
+        GKC_ENGINE_INFO("No asset index for '{0}', the asset folders are scanned", projectPath.string());
+    }
+
+    if (Update())
+        Save();
+    GKC_ENGINE_INFO("Indexed {0} asset folders of '{1}'", m_folders.size(), projectPath.string());
+}
+
+void AssetIndex::Close() {
+    std::lock_guard lock(m_mutex);
+    m_projectPath.clear();
+    m_indexFile.clear();
+    m_folders.clear();
+    m_time = 0;
+}
+
+bool AssetIndex::Refresh() {
+    std::lock_guard lock(m_mutex);
+    if (!IsOpen() || !Update())
+        return false;
+    Save();
+    return true;
+}
+
+vector<string> AssetIndex::GetFiles(const path& folder, Asset_Type type) {
+    vector<string> files;
+    std::unique_lock lock(m_mutex);
+    const string relative = IsOpen()
+        ? folder.lexically_normal().lexically_relative(m_projectPath).generic_string() : string();
+    auto first = relative.empty() ? m_folders.end() : m_folders.find(relative);
+    if (first == m_folders.end()) {
+        lock.unlock();
+        for (auto& file : GetFilenamesInFolder(folder)) {
+            if (IsAssetExtension(file, type))
+                files.push_back(std::move(file));
+        }
+        return files;
+    }
+
+    // Files inside mounted archives come first, loose copies of them are skipped
+    for (auto& file : GetArchivedFilesInFolder(folder)) {
+        if (IsAssetExtension(file, type))
+            files.push_back(std::move(file));
+    }
+    unordered_set<string> archived;
+    for (auto& file : files)
+        archived.insert(path(file).lexically_normal().generic_string());
+
+    // Subfolders start with the name of the folder, so do siblings like "textures-old"
+    const string prefix = relative + "/";
+    for (auto it = first; it != m_folders.end() && it->first.starts_with(relative); ++it) {
+        if (it->first != relative && !it->first.starts_with(prefix))
+            continue;
+
+        path subfolder = folder;
+        if (it->first != relative)
+            subfolder /= path(it->first.substr(prefix.size()));
+        for (const string& name : it->second.files_) {
+            path file = subfolder / name;
+            if (IsAssetExtension(file, type) && !archived.contains(file.lexically_normal().generic_string()))
+                files.push_back(file.string());
+        }
+    }
+    return files;
+}
+
+bool AssetIndex::Update() {
+    for (auto& [name, folder] : m_folders)
+        folder.isVisited_ = false;
+
+    // Taken before listing, what changes while listing is newer and listed again next time
+    const auto time = static_cast<Sint64>(
+        std::filesystem::file_time_type::clock::now().time_since_epoch().count());
+    bool changed = false;
+    for (const path& folder : GKC_ASSET_INDEX_FOLDERS)
+        changed |= RefreshFolder(folder.generic_string());
+    if (changed)
+        m_time = time;
+
+    // Folders that weren't reached were removed, or the folder above them was
+    changed |= std::erase_if(m_folders, [](const auto& entry) { return !entry.second.isVisited_; }) > 0;
+    return changed;
+}
+
+bool AssetIndex::RefreshFolder(const string& name) {
+    // The time is read before listing, a file added in between is seen by the next refresh
+    std::error_code error;
+    const path folder = m_projectPath / name;
+    const auto time = static_cast<Sint64>(std::filesystem::last_write_time(folder, error).time_since_epoch().count());
+    if (error)
+        return false;
+
+    auto [it, added] = m_folders.try_emplace(name);
+    IndexedFolder& entry = it->second;
+    entry.isVisited_ = true;
+
+    // A folder changed in the same tick it was listed keeps its (rounded) time
+    const auto slack = std::chrono::duration_cast<std::filesystem::file_time_type::duration>(
+        std::chrono::milliseconds(GKC_ASSET_INDEX_TIME_SLACK_MS)).count();
+    bool changed = false;
+    if (added || entry.time_ != time || time >= m_time - slack) {
+        entry.time_ = time;
+        entry.files_.clear();
+        entry.folders_.clear();
+        // The type of the entries comes with the listing, they aren't checked one by one
+        for (auto item = std::filesystem::directory_iterator(folder, error);
+             !error && item != std::filesystem::directory_iterator(); item.increment(error)) {
+            std::error_code typeError;
+            if (item->is_directory(typeError))
+                entry.folders_.push_back(item->path().filename().string());
+            else if (item->is_regular_file(typeError))
+                entry.files_.push_back(item->path().filename().string());
+        }
+        if (error)
+            GKC_ENGINE_WARNING("Failed to list '{0}': {1}", folder.string(), error.message());
+        changed = true;
+    }
+
+    // Map nodes don't move, the entry stays valid while its subfolders are added
+    for (const string& subfolder : entry.folders_)
+        changed |= RefreshFolder(name + "/" + subfolder);
+    return changed;
+}
+
+bool AssetIndex::Load() {
+    MappedFile mapped;
+    if (m_indexFile.empty() || !mapped.Open(m_indexFile))
+        return false;
+
+    ByteReader reader(mapped.GetData(), mapped.GetSize());
+    IndexHeader header{};
+    if (!reader.Read(header) || std::memcmp(header.magic_, ASSET_INDEX_MAGIC, sizeof(ASSET_INDEX_MAGIC)) != 0
+        || header.version_ != GKC_VERSION_ASSET_INDEX) {
+        return false;
+    }
+    m_time = header.time_;
+
+    for (Uint32 i = 0; i < header.folderCount_; ++i) {
+        string name;
+        IndexedFolder folder;
+        if (!reader.ReadString(name) || !reader.Read(folder.time_)
+            || !ReadStrings(reader, folder.files_) || !ReadStrings(reader, folder.folders_)) {
+            return false;
+        }
+        m_folders.insert_or_assign(std::move(name), std::move(folder));
+    }
+    return true;
+}
+
+void AssetIndex::Save() {
+    if (m_indexFile.empty())
+        return;
+
+    ByteBuffer buffer(4096);
+    IndexHeader header{};
+    std::memcpy(header.magic_, ASSET_INDEX_MAGIC, sizeof(ASSET_INDEX_MAGIC));
+    header.version_ = GKC_VERSION_ASSET_INDEX;
+    header.folderCount_ = static_cast<Uint32>(m_folders.size());
+    header.time_ = m_time;
+    buffer.Write(header);
+
+    for (const auto& [name, folder] : m_folders) {
+        buffer.WriteString(name);
+        buffer.Write(folder.time_);
+        WriteStrings(buffer, folder.files_);
+        WriteStrings(buffer, folder.folders_);
+    }
+    WriteFileAtomic(m_indexFile, buffer.GetData(), buffer.GetSize());
+}
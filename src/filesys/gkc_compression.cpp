@@ -0,0 +1,114 @@
+#include <filesys/gkc_compression.h>
+
+// Both are defined by CMake, the defaults only matter for builds that don't use it
+#ifndef GKC_HAS_LZ4
+    #define GKC_HAS_LZ4 0
+#endif
+#ifndef GKC_HAS_ZSTD
+    #define GKC_HAS_ZSTD 0
+#endif
+
+#if GKC_HAS_LZ4
+    #include <lz4.h>
+#endif
+#if GKC_HAS_ZSTD
+    #include <zstd.h>
+#endif
+
+using namespace Galaktic;
+
+bool Filesystem::IsCompressionAvailable(Compression_Type type) {
+    switch (type) {
+        case Compression_Type::None:
+            return true;
+        case Compression_Type::LZ4:
+            return GKC_HAS_LZ4;
+        case Compression_Type::Zstd:
+            return GKC_HAS_ZSTD;
+    }
+    return false;
+}
+
+const char* Filesystem::GetCompressionName(Compression_Type type) {
+    switch (type) {
+        case Compression_Type::None:
+            return "none";
+        case Compression_Type::LZ4:
+            return "LZ4";
+        case Compression_Type::Zstd:
+            return "Zstd";
+    }
+    return "unknown";
+}
+
+size_t Filesystem::CompressBlock(Compression_Type type, const void* data, size_t size, ByteBuffer& output) {
+    if (size == 0 || size > static_cast<size_t>(std::numeric_limits<int>::max()))
+        return 0;
+
+    const size_t start = output.GetSize();
+    size_t stored = 0;
+    switch (type) {
+        case Compression_Type::LZ4: {
+            #if GKC_HAS_LZ4
+                const int bound = LZ4_compressBound(static_cast<int>(size));
+                output.Reserve<Uint8>(static_cast<size_t>(bound));
+                const int result = LZ4_compress_default(static_cast<const char*>(data),
+                    reinterpret_cast<char*>(output.GetData() + start), static_cast<int>(size), bound);
+                stored = result > 0 ? static_cast<size_t>(result) : 0;
+            #endif
+            break;
+        }
+        case Compression_Type::Zstd: {
+            #if GKC_HAS_ZSTD
+                const size_t bound = ZSTD_compressBound(size);
+                output.Reserve<Uint8>(bound);
+                const size_t result = ZSTD_compress(output.GetData() + start, bound, data, size, GKC_ZSTD_LEVEL);
+                stored = ZSTD_isError(result) ? 0 : result;
+            #endif
+            break;
+        }
+        case Compression_Type::None:
+            break;
+    }
+
+    // Incompressible blocks are worse off compressed, the caller stores them raw
+    if (stored == 0 || stored >= size) {
+        output.Truncate(start);
+        return 0;
+    }
+    output.Truncate(start + stored);
+    return stored;
+}
+
+bool Filesystem::DecompressBlock(Compression_Type type, const Uint8* data, size_t size, Uint8* output,
+                                 size_t rawSize) {
+    switch (type) {
+        case Compression_Type::LZ4: {
+            #if GKC_HAS_LZ4
+                if (size > static_cast<size_t>(std::numeric_limits<int>::max())
+                    || rawSize > static_cast<size_t>(std::numeric_limits<int>::max())) {
+                    return false;
+                }
+                const int result = LZ4_decompress_safe(reinterpret_cast<const char*>(data),
+                    reinterpret_cast<char*>(output), static_cast<int>(size), static_cast<int>(rawSize));
+                return result == static_cast<int>(rawSize);
+            #else
+                return false;
+            #endif
+        }
+        case Compression_Type::Zstd: {
+            #if GKC_HAS_ZSTD
+                const size_t result = ZSTD_decompress(output, rawSize, data, size);
+                return !ZSTD_isError(result) && result == rawSize;
+            #else
+                return false;
+            #endif
+        }
+        case Compression_Type::None:
+            if (size != rawSize)
+                return false;
+            std::memcpy(output, data, size);
+            return true;
+    }
+    return false;
+}
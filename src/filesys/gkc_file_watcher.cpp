@@ -0,0 +1,203 @@
+#include <filesys/gkc_file_watcher.h>
+#include "core/gkc_logger.h"
+#include "filesys/gkc_filesys.h"
+
+#ifdef __linux__
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+using namespace Galaktic;
+using namespace Galaktic::Filesystem;
+
+void FileWatcher::Poll(vector<path>& changed) {
+    const Uint64 now = SDL_GetTicks();
+
+    #ifdef __linux__
+        ReadEvents(now);
+        if (!m_lost.empty() && now - m_lastRetry >= GKC_FILE_WATCH_POLL_MS) {
+            RetryLostWatches(now);
+            m_lastRetry = now;
+        }
+    #else
+        if (now - m_lastScan >= GKC_FILE_WATCH_POLL_MS) {
+            Scan(now, true);
+            m_lastScan = now;
+        }
+    #endif
+
+    for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+        if (now - it->second >= GKC_FILE_WATCH_DEBOUNCE_MS) {
+            changed.emplace_back(it->first);
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher() {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        GKC_ENGINE_ERROR("Failed to initialize inotify, files won't be watched");
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool FileWatcher::Watch(const path& folder) {
+    if (m_fd < 0 || !CheckDirectory(folder))
+        return false;
+
+    // inotify isn't recursive, every subfolder needs its own watch
+    bool watched = AddWatch(folder);
+    std::error_code error;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(folder, error)) {
+        if (entry.is_directory())
+            AddWatch(entry.path());
+    }
+    return watched;
+}
+
+bool FileWatcher::AddWatch(const path& folder) {
+    int wd = inotify_add_watch(m_fd, folder.c_str(),
+        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (wd < 0) {
+        GKC_ENGINE_WARNING("Failed to watch '{0}'", folder.string());
+        return false;
+    }
+    m_watches[wd] = folder;
+    return true;
+}
+
+void FileWatcher::ReadEvents(Uint64 now) {
+    if (m_fd < 0)
+        return;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (ssize_t offset = 0; offset < length; ) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            auto watch = m_watches.find(event->wd);
+            if (watch == m_watches.end())
+                continue;
+
+            // IN_DELETE_SELF is followed by IN_IGNORED. A moved folder and its subfolders keep
+            // their watches, they'd report the old paths (the parent reports the new one)
+            if (event->mask & (IN_IGNORED | IN_MOVE_SELF)) {
+                const path folder = watch->second;
+                if (event->mask & IN_MOVE_SELF)
+                    RemoveWatches(folder);
+                else
+                    m_watches.erase(watch);
+                LoseWatch(folder);
+                continue;
+            }
+            if (event->len == 0)
+                continue;
+
+            path file = watch->second / event->name;
+            if (event->mask & IN_ISDIR) {
+                // Files moved inside a new folder don't generate events of their own
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    Watch(file);
+                continue;
+            }
+
+            // IN_CREATE is followed by IN_CLOSE_WRITE once the file is written
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                m_pending[file.string()] = now;
+        }
+    }
+}
+
+void FileWatcher::RemoveWatches(const path& folder) {
+    // A trailing separator would be an empty last element that subfolders don't have
+    const path base = folder.has_filename() ? folder : folder.parent_path();
+    for (auto it = m_watches.begin(); it != m_watches.end(); ) {
+        const path& watched = it->second;
+        if (std::mismatch(base.begin(), base.end(), watched.begin(), watched.end()).first == base.end()) {
+            inotify_rm_watch(m_fd, it->first);
+            it = m_watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void FileWatcher::LoseWatch(const path& folder) {
+    // Subfolders are watched again through the creation events of their parent
+    for (const auto& [wd, watched] : m_watches) {
+        if (watched == folder.parent_path())
+            return;
+    }
+    if (std::find(m_lost.begin(), m_lost.end(), folder) != m_lost.end())
+        return;
+    GKC_ENGINE_WARNING("'{0}' was deleted or moved, it's watched again once it exists", folder.string());
+    m_lost.push_back(folder);
+}
+
+void FileWatcher::RetryLostWatches(Uint64 now) {
+    for (auto it = m_lost.begin(); it != m_lost.end(); ) {
+        if (!CheckDirectory(*it) || !Watch(*it)) {
+            ++it;
+            continue;
+        }
+
+        // Files written while the folder wasn't watched didn't generate events
+        std::error_code error;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(*it, error)) {
+            if (entry.is_regular_file())
+                m_pending[entry.path().string()] = now;
+        }
+        GKC_ENGINE_INFO("Watching '{0}' again", it->string());
+        it = m_lost.erase(it);
+    }
+}
+
+#else
+
+FileWatcher::FileWatcher() = default;
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::Watch(const path& folder) {
+    if (!CheckDirectory(folder))
+        return false;
+
+    m_folders.push_back(folder);
+    // First scan only records the current times
+    Scan(SDL_GetTicks(), false);
+    return true;
+}
+
+void FileWatcher::Scan(Uint64 now, bool notify) {
+    std::error_code error;
+    for (auto& folder : m_folders) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(folder, error)) {
+            if (!entry.is_regular_file())
+                continue;
+
+            auto time = entry.last_write_time(error);
+            auto [it, inserted] = m_times.try_emplace(entry.path().string(), time);
+            if (inserted || it->second != time) {
+                it->second = time;
+                if (notify)
+                    m_pending[it->first] = now;
+            }
+        }
+    }
+}
+
+#endif
@@ -1,8 +1,19 @@
 #include <pch.hpp>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_archive.h>
 #include <core/gkc_logger.h>
 #include "core/gkc_exception.h"
 
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
 using namespace Galaktic;
 using namespace std::filesystem;
 
@@ -40,6 +51,92 @@ void Filesystem::RenameFile(const path& old_name, const path& new_name) {
     }
 }
 
+namespace {
+    #ifdef _WIN32
+        bool WriteAndSync(const path& file, const Uint8* data, size_t size, bool append) {
+            int fd = _wopen(file.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC),
+                _S_IREAD | _S_IWRITE);
+            if (fd < 0)
+                return false;
+
+            bool written = true;
+            while (size > 0 && written) {
+                // _write takes an unsigned int, big buffers are written in chunks
+                auto chunk = static_cast<unsigned int>(std::min<size_t>(size, 1u << 30));
+                int result = _write(fd, data, chunk);
+                written = result > 0;
+                if (written) {
+                    data += result;
+                    size -= static_cast<size_t>(result);
+                }
+            }
+            written = written && _commit(fd) == 0;
+            return _close(fd) == 0 && written;
+        }
+    #else
+        bool WriteAndSync(const path& file, const Uint8* data, size_t size, bool append) {
+            int fd = open(file.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644);
+            if (fd < 0)
+                return false;
+
+            bool written = true;
+            while (size > 0 && written) {
+                ssize_t result = write(fd, data, size);
+                if (result < 0 && errno == EINTR)
+                    continue;
+                written = result > 0;
+                if (written) {
+                    data += result;
+                    size -= static_cast<size_t>(result);
+                }
+            }
+            written = written && fsync(fd) == 0;
+            return close(fd) == 0 && written;
+        }
+
+        void SyncFolder(const path& folder) {
+            // The rename itself is only durable once the folder entry is flushed
+            int fd = open(folder.empty() ? "." : folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd >= 0) {
+                fsync(fd);
+                close(fd);
+            }
+        }
+    #endif
+}
+
+bool Filesystem::WriteFileAtomic(const path& file, const void* data, size_t size) {
+    path tempPath = file;
+    tempPath += ".tmp";
+
+    if (!WriteAndSync(tempPath, static_cast<const Uint8*>(data), size, false)) {
+        GKC_ENGINE_ERROR("Error writing file '{0}'", tempPath.string());
+        RemoveFile(tempPath);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, file, error);
+    if (error) {
+        GKC_ENGINE_ERROR("Error replacing file '{0}': {1}", file.string(), error.message());
+        RemoveFile(tempPath);
+        return false;
+    }
+
+    #ifndef _WIN32
+        SyncFolder(file.parent_path());
+    #endif
+    return true;
+}
+
+bool Filesystem::AppendFileSynced(const path& file, const void* data, size_t size) {
+    if (!WriteAndSync(file, static_cast<const Uint8*>(data), size, true)) {
+        GKC_ENGINE_ERROR("Error appending to file '{0}'", file.string());
+        return false;
+    }
+    return true;
+}
+
 void Filesystem::RemoveFile(const path& filepath) {
     try {
         std::filesystem::remove(filepath.string().c_str());
@@ -87,15 +184,22 @@ void Filesystem::CreateAppDirectoryStructure(const path& project_path) {
 }
 
 vector<string> Filesystem::GetFilenamesInFolder(const path &folder) {
+    // Files inside mounted archives come first, loose copies of them are skipped
+    vector<string> fileNames = GetArchivedFilesInFolder(folder);
     if (!CheckDirectory(folder)) {
-        GKC_ENGINE_INFO("The path '{}' is not a valid directory.", folder.string());
-        return {};
+        if (fileNames.empty())
+            GKC_ENGINE_INFO("The path '{}' is not a valid directory.", folder.string());
+        return fileNames;
     }
 
-    vector<string> fileNames;
+    unordered_set<string> archived;
+    for (auto& file : fileNames)
+        archived.insert(path(file).lexically_normal().generic_string());
+
     try {
         for (const auto& entry : recursive_directory_iterator(folder)) {
-            if (entry.exists() && entry.is_regular_file())
+            if (entry.exists() && entry.is_regular_file()
+                && !archived.contains(entry.path().lexically_normal().generic_string()))
                 fileNames.push_back(entry.path().string());
         }
     } catch (const filesystem_error& e) {
@@ -1,4 +1,9 @@
 #include <filesys/gkc_reader.h>
+#include <filesys/gkc_archive.h>
+#include <filesys/gkc_filesys.h>
+#include <filesys/gkc_scene_format.h>
+#include <filesys/gkc_scene_journal.h>
+#include <filesys/gkc_writer.h>
 #include "core/managers/gkc_ecs_man.h"
 #include <ecs/gkc_registry.h>
 
@@ -6,8 +11,486 @@
 
 using namespace Galaktic;
 
-void Filesystem::FileReader::ReadString(ifstream &file, string &str) {
-    GKC_ENSURE_FILE_OPEN(file, Debug::ReadingException);
+namespace {
+    using namespace Galaktic::Filesystem;
+    using Core::Managers::ECS_Manager;
+
+    bool IsRangeValid(Uint64 offset, Uint64 bytes, size_t size) {
+        return offset <= size && bytes <= size - offset;
+    }
+
+    /**
+     * @brief Maps a scene from the mounted archives or from disk
+     * @return Pointer to the scene data, nullptr if it couldn't be mapped
+     */
+    const Uint8* MapScene(const path& file, MappedFile& mapped, size_t& size) {
+        if (const Uint8* data = FindArchivedFile(file, size); data != nullptr)
+            return data;
+
+        if (!mapped.Open(file))
+            return nullptr;
+        size = mapped.GetSize();
+        return mapped.GetData();
+    }
+
+    /**
+     * @brief Checks that the tables of a column oriented scene are inside the data, the
+     *        checksum of version 5 scenes has to match as well
+     * @param namesSize Filled with the size of the names block
+     */
+    bool ValidateSceneTables(const Uint8* data, size_t size, const SceneHeader& header, size_t& namesSize) {
+        const Uint64 columnsSize = static_cast<Uint64>(header.columnCount_) * GetSceneColumnSize(header.version_);
+        const Uint64 fieldsOffset = header.columnsOffset_ + columnsSize;
+        if (!IsRangeValid(header.columnsOffset_, columnsSize, size)
+            || !IsRangeValid(fieldsOffset, static_cast<Uint64>(header.fieldCount_) * sizeof(SceneField), size)
+            || !IsRangeValid(header.entitiesOffset_, static_cast<Uint64>(header.entityCount_) * sizeof(EntityID), size)
+            || !IsRangeValid(header.namesOffset_, header.nameLength_, size)
+            || header.entitiesOffset_ % alignof(EntityID) != 0 || fieldsOffset % alignof(SceneField) != 0) {
+            return false;
+        }
+        namesSize = size - header.namesOffset_;
+        if (header.version_ < 5)
+            return true;
+
+        // Everything before the columns is covered by the checksum, the names end at the index
+        const Uint64 indexSize = GetSceneIndexEnd(header) - header.indexOffset_;
+        if (header.indexOffset_ < sizeof(SceneHeader) || !IsRangeValid(header.indexOffset_, indexSize, size)
+            || header.indexOffset_ % alignof(SceneIndexEntry) != 0 || header.namesOffset_ > header.indexOffset_
+            || header.nameLength_ > header.indexOffset_ - header.namesOffset_) {
+            return false;
+        }
+        if (GetSceneChecksum(data, header) != header.checksum_) {
+            GKC_ENGINE_ERROR("The tables of the scene don't match their checksum");
+            return false;
+        }
+        namesSize = header.indexOffset_ - header.namesOffset_;
+        return true;
+    }
+
+    /**
+     * @param size Size of the scene
+     * @return Threads used to check and read a scene, small scenes are read by one thread
+     */
+    Uint32 GetSceneThreads(size_t size) {
+        return size < GKC_SCENE_PARALLEL_SIZE ? 1 : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    /**
+     * @brief Runs a list of jobs on several threads, the calling thread runs jobs as well
+     * @param count Number of jobs
+     * @param threads Threads to use at most, with 1 every job runs on the calling thread
+     * @param job Called with the index of the job and the index of the thread running it
+     */
+    template<typename Job>
+    void RunJobs(Uint32 count, Uint32 threads, const Job& job) {
+        threads = std::min(threads, count);
+        if (threads < 2) {
+            for (Uint32 i = 0; i < count; ++i)
+                job(i, 0u);
+            return;
+        }
+
+        // Jobs are taken one at a time, a few big jobs don't end up on the same thread
+        std::atomic<Uint32> next = 0;
+        auto work = [&](Uint32 worker) {
+            for (Uint32 i = next++; i < count; i = next++)
+                job(i, worker);
+        };
+        vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (Uint32 i = 1; i < threads; ++i)
+            workers.emplace_back(work, i);
+        work(0);
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Checks the CRC32C of every column of a version 5 scene, big scenes are split
+     *        between several threads
+     * @return One entry per column, 1 if the column is inside the data and intact
+     */
+    vector<Uint8> VerifyColumns(const Uint8* data, size_t size, const SceneHeader& header) {
+        vector<Uint8> intact(header.columnCount_, 0);
+        RunJobs(header.columnCount_, GetSceneThreads(size), [&](Uint32 index, Uint32) {
+            SceneColumn column{};
+            ReadSceneColumn(data, header, index, column);
+            const bool isCompressed = (column.flags_ & SCENE_COLUMN_COMPRESSED) != 0;
+            const Uint64 idsSize = isCompressed ? 0 : static_cast<Uint64>(column.count_) * sizeof(EntityID);
+            intact[index] = IsRangeValid(column.offset_, idsSize, size)
+                && IsRangeValid(column.offset_ + idsSize, column.dataSize_, size)
+                && Core::HashCRC32C(data + column.offset_, idsSize + column.dataSize_) == column.checksum_;
+        });
+        return intact;
+    }
+
+    /**
+     * @brief Decompresses a block of a compressed column and reads its components
+     * @param scratch Buffer the block is decompressed into
+     */
+    bool ReadBlock(const SceneBlock& block, const Uint8* stored, Compression_Type compression,
+                   const ECS::ComponentTypeInfo& info, unordered_map<EntityID, any>& pool,
+                   std::span<const SceneField> fields, vector<Uint8>& scratch) {
+        const size_t idsSize = static_cast<size_t>(block.count_) * sizeof(EntityID);
+        if (block.rawSize_ > GKC_SCENE_MAX_BLOCK_SIZE || block.rawSize_ < idsSize)
+            return false;
+
+        // Raw blocks are copied as well, the IDs inside the file aren't aligned
+        scratch.resize(block.rawSize_);
+        const bool isRaw = block.storedSize_ == block.rawSize_;
+        if (!DecompressBlock(isRaw ? Compression_Type::None : compression, stored, block.storedSize_,
+                scratch.data(), block.rawSize_)) {
+            return false;
+        }
+
+        const auto* ids = reinterpret_cast<const EntityID*>(scratch.data());
+        return info.m_readColumn(scratch.data() + idsSize, block.rawSize_ - idsSize, ids, block.count_, pool, fields);
+    }
+
+    /**
+     * @brief Reads a compressed column one block at a time, only one decompressed block
+     *        is in memory at once
+     * @param scratch Buffer reused by every block
+     */
+    bool ReadCompressedColumn(const Uint8* data, size_t size, Uint32 count, Compression_Type compression,
+                              const ECS::ComponentTypeInfo& info, unordered_map<EntityID, any>& pool,
+                              std::span<const SceneField> fields, vector<Uint8>& scratch) {
+        ByteReader reader(data, size);
+        Uint32 read = 0;
+        while (reader.GetRemaining() > 0) {
+            SceneBlock block{};
+            if (!reader.Read(block))
+                return false;
+            const Uint8* stored = reader.Skip(block.storedSize_);
+            if (stored == nullptr || block.count_ > count - read
+                || !ReadBlock(block, stored, compression, info, pool, fields, scratch)) {
+                return false;
+            }
+            read += block.count_;
+        }
+        return read == count;
+    }
+
+    /**
+     * @brief Reads the blocks of a damaged compressed column that still match their checksum,
+     *        reading stops where the column was cut
+     * @return Number of components recovered
+     */
+    Uint32 RecoverCompressedColumn(const Uint8* data, size_t size, Uint32 count, Compression_Type compression,
+                                   const ECS::ComponentTypeInfo& info, unordered_map<EntityID, any>& pool,
+                                   std::span<const SceneField> fields, vector<Uint8>& scratch) {
+        ByteReader reader(data, size);
+        Uint32 seen = 0;
+        Uint32 recovered = 0;
+        SceneBlock block{};
+        while (reader.Read(block)) {
+            const Uint8* stored = reader.Skip(block.storedSize_);
+            if (stored == nullptr || block.count_ > count - seen)
+                break;
+            seen += block.count_;
+            if (Core::HashCRC32C(stored, block.storedSize_) == block.checksum_
+                && ReadBlock(block, stored, compression, info, pool, fields, scratch)) {
+                recovered += block.count_;
+            }
+        }
+        return recovered;
+    }
+
+    /**
+     * @struct ColumnLoad
+     * @brief Column of a scene being read, its jobs follow each other in the job list
+     */
+    struct ColumnLoad {
+        const ECS::ComponentTypeInfo* info_;
+        std::string_view name_;
+        std::span<const SceneField> fields_;
+        Uint32 count_;
+        Uint32 firstJob_;
+        Uint32 jobCount_;
+        bool isDamaged_;
+    };
+
+    /**
+     * @struct ColumnJob
+     * @brief Part of a column that a single thread reads into a pool of its own, the pools
+     *        of a column are merged once every job is done
+     */
+    struct ColumnJob {
+        Uint32 column_;             // Index of the ColumnLoad
+        const Uint8* data_;         // Components, blocks in compressed columns
+        size_t size_;
+        const EntityID* ids_;       // nullptr in compressed columns, the IDs are in the blocks
+        Uint32 count_;
+        bool isRecovery_ = false;   // Damaged compressed column, only the intact blocks are read
+        bool read_ = false;
+        Uint32 recovered_ = 0;
+        unordered_map<EntityID, any> pool_;
+    };
+
+    /**
+     * @brief Splits an intact column in jobs, compressed columns are split at their blocks and
+     *        columns of components with the same size every \c GKC_SCENE_BLOCK_SIZE bytes
+     * @return false if the blocks of the column are malformed
+     */
+    bool AddColumnJobs(const Uint8* data, const SceneColumn& column, Uint32 index, vector<ColumnJob>& jobs) {
+        if ((column.flags_ & SCENE_COLUMN_COMPRESSED) != 0) {
+            // Only the block headers are read here, every block is checked again by its job
+            ByteReader reader(data + column.offset_, static_cast<size_t>(column.dataSize_));
+            Uint32 count = 0;
+            SceneBlock block{};
+            while (reader.GetRemaining() > 0) {
+                const Uint8* start = reader.GetCurrent();
+                if (!reader.Read(block) || reader.Skip(block.storedSize_) == nullptr || block.count_ > column.count_ - count)
+                    return false;
+                jobs.push_back({ index, start, sizeof(SceneBlock) + block.storedSize_, nullptr, block.count_ });
+                count += block.count_;
+            }
+            return count == column.count_;
+        }
+
+        const auto* ids = reinterpret_cast<const EntityID*>(data + column.offset_);
+        const Uint8* components = data + column.offset_ + static_cast<Uint64>(column.count_) * sizeof(EntityID);
+        const bool isFixed = (column.flags_ & (SCENE_COLUMN_POD | SCENE_COLUMN_FIELDS)) != 0;
+        if (!isFixed || column.count_ == 0 || column.dataSize_ == 0 || column.dataSize_ % column.count_ != 0) {
+            jobs.push_back({ index, components, static_cast<size_t>(column.dataSize_), ids, column.count_ });
+            return true;
+        }
+
+        const size_t elementSize = static_cast<size_t>(column.dataSize_ / column.count_);
+        const Uint32 rows = static_cast<Uint32>(std::max<size_t>(GKC_SCENE_BLOCK_SIZE / elementSize, 1));
+        for (Uint32 first = 0; first < column.count_; first += rows) {
+            const Uint32 count = std::min(rows, column.count_ - first);
+            jobs.push_back({ index, components + first * elementSize, count * elementSize, ids + first, count });
+        }
+        return true;
+    }
+
+    // Reads the column oriented format, version 2 and newer
+    bool LoadSceneV2(const Uint8* data, size_t size, ECS_Manager& manager, ECS::Registry* registry,
+                     string& sceneName) {
+        using namespace ECS;
+        SceneHeader header{};
+        if (!ReadSceneHeader(data, size, header)) {
+            GKC_ENGINE_ERROR("This scene cannot be read by this function, use a newer version");
+            return false;
+        }
+
+        const auto compression = static_cast<Compression_Type>(header.compression_);
+        if (!IsCompressionAvailable(compression)) {
+            GKC_ENGINE_ERROR("The scene is compressed with {0} (codec {1}) but the engine was built without it",
+                GetCompressionName(compression), header.compression_);
+            return false;
+        }
+
+        size_t namesSize = 0;
+        if (!ValidateSceneTables(data, size, header, namesSize))
+            return false;
+
+        const char* names = reinterpret_cast<const char*>(data + header.namesOffset_);
+        sceneName.assign(names, header.nameLength_);
+
+        // Columns that don't match their checksum are dropped (or what's left of them is recovered)
+        const bool hasChecksums = header.version_ >= 5;
+        const vector<Uint8> intact = hasChecksums ? VerifyColumns(data, size, header) : vector<Uint8>();
+
+        const auto* fieldTable = reinterpret_cast<const SceneField*>(data + header.columnsOffset_
+            + header.columnCount_ * GetSceneColumnSize(header.version_));
+
+        // The tables are read first, every column is split in jobs that read into pools of their own
+        vector<ColumnLoad> loads;
+        vector<ColumnJob> jobs;
+        loads.reserve(header.columnCount_);
+        Uint32 firstField = 0;
+        for (Uint32 i = 0; i < header.columnCount_; ++i) {
+            SceneColumn column{};
+            ReadSceneColumn(data, header, i, column);
+            if (column.fieldCount_ > header.fieldCount_ - firstField)
+                return false;
+            std::span<const SceneField> fields(fieldTable + firstField, column.fieldCount_);
+            firstField += column.fieldCount_;
+
+            const bool isCompressed = (column.flags_ & SCENE_COLUMN_COMPRESSED) != 0;
+            const bool isDamaged = hasChecksums && intact[i] == 0;
+            const Uint64 idsSize = isCompressed ? 0 : static_cast<Uint64>(column.count_) * sizeof(EntityID);
+            if (!IsRangeValid(column.nameOffset_, column.nameLength_, namesSize)
+                || column.offset_ % alignof(EntityID) != 0) {
+                return false;
+            }
+            if (!isDamaged && (!IsRangeValid(column.offset_, idsSize, size)
+                || !IsRangeValid(column.offset_ + idsSize, column.dataSize_, size))) {
+                return false;
+            }
+
+            std::string_view name(names + column.nameOffset_, column.nameLength_);
+            const ComponentTypeInfo* info = ComponentRegistry::FindByName(name);
+            if (info == nullptr) {
+                GKC_ENGINE_WARNING("Unknown component '{0}', {1} components were skipped", name, column.count_);
+                continue;
+            }
+
+            if (!info->CanReadColumn(column.flags_, column.elementSize_)) {
+                GKC_ENGINE_WARNING("'{0}' changed since the scene was saved, {1} components were skipped",
+                    name, column.count_);
+                continue;
+            }
+
+            const auto index = static_cast<Uint32>(loads.size());
+            const auto firstJob = static_cast<Uint32>(jobs.size());
+            if (isDamaged) {
+                // What's left of a compressed column is read block by block by a single job
+                if (isCompressed && column.offset_ < size) {
+                    const size_t available = static_cast<size_t>(std::min<Uint64>(column.dataSize_, size - column.offset_));
+                    jobs.push_back({ index, data + column.offset_, available, nullptr, column.count_, true });
+                }
+            } else if (!AddColumnJobs(data, column, index, jobs)) {
+                GKC_ENGINE_ERROR("Column of '{0}' is malformed", name);
+                return false;
+            }
+            loads.push_back({ info, name, fields, column.count_, firstJob,
+                static_cast<Uint32>(jobs.size()) - firstJob, isDamaged });
+        }
+
+        // Every job decodes on its own, the scratch buffers are kept per thread
+        const Uint32 threads = GetSceneThreads(size);
+        vector<vector<Uint8>> scratch(std::min<size_t>(threads, std::max<size_t>(jobs.size(), 1)));
+        RunJobs(static_cast<Uint32>(jobs.size()), threads, [&](Uint32 index, Uint32 worker) {
+            ColumnJob& job = jobs[index];
+            const ColumnLoad& load = loads[job.column_];
+            job.pool_.reserve(job.count_);
+            if (job.isRecovery_) {
+                job.recovered_ = RecoverCompressedColumn(job.data_, job.size_, job.count_, compression, *load.info_,
+                    job.pool_, load.fields_, scratch[worker]);
+                job.read_ = true;
+            } else if (job.ids_ == nullptr) {
+                job.read_ = ReadCompressedColumn(job.data_, job.size_, job.count_, compression, *load.info_,
+                    job.pool_, load.fields_, scratch[worker]);
+            } else {
+                job.read_ = load.info_->m_readColumn(job.data_, job.size_, job.ids_, job.count_, job.pool_,
+                    load.fields_);
+            }
+        });
+
+        for (const ColumnLoad& load : loads) {
+            for (Uint32 j = load.firstJob_; j < load.firstJob_ + load.jobCount_; ++j) {
+                if (!jobs[j].read_) {
+                    GKC_ENGINE_ERROR("Column of '{0}' is malformed", load.name_);
+                    return false;
+                }
+            }
+        }
+
+        // The pools of a column are merged into its first one, the nodes are moved, not copied
+        RunJobs(static_cast<Uint32>(loads.size()), threads, [&](Uint32 index, Uint32) {
+            const ColumnLoad& load = loads[index];
+            if (load.jobCount_ < 2)
+                return;
+            auto& merged = jobs[load.firstJob_].pool_;
+            merged.reserve(load.count_);
+            for (Uint32 j = load.firstJob_ + 1; j < load.firstJob_ + load.jobCount_; ++j)
+                merged.merge(jobs[j].pool_);
+        });
+
+        // Fix-up on this thread: the entities, the pools of the registry and the names
+        const auto* entityIDs = reinterpret_cast<const EntityID*>(data + header.entitiesOffset_);
+        manager.ReserveEntities(header.entityCount_);
+        for (Uint32 i = 0; i < header.entityCount_; ++i) {
+            Entity entity(entityIDs[i], registry);
+            manager.AddEmptyEntity(entityIDs[i], entity);
+        }
+
+        auto& pools = registry->GetComponentPools();
+        Uint32 damaged = 0;
+        for (const ColumnLoad& load : loads) {
+            if (load.isDamaged_) {
+                const Uint32 recovered = load.jobCount_ > 0 ? jobs[load.firstJob_].recovered_ : 0;
+                GKC_ENGINE_ERROR("Column of '{0}' is damaged, {1} of {2} components were recovered",
+                    load.name_, recovered, load.count_);
+                ++damaged;
+            }
+            if (load.jobCount_ == 0)
+                continue;
+
+            auto& column = jobs[load.firstJob_].pool_;
+            auto& pool = pools[load.info_->m_type];
+            if (pool.empty()) {
+                pool.swap(column);
+                continue;
+            }
+            pool.reserve(pool.size() + column.size());
+            for (auto& [id, component] : column)
+                pool.insert_or_assign(id, std::move(component));
+        }
+
+        for (Uint32 i = 0; i < header.entityCount_; ++i)
+            manager.IndexEntityName(entityIDs[i]);
+
+        if (damaged > 0) {
+            GKC_ENGINE_WARNING("{0} of {1} columns of '{2}' were damaged, save the scene again to drop what was lost",
+                damaged, header.columnCount_, sceneName);
+        }
+        return true;
+    }
+
+    bool LoadSceneV1(const Uint8* data, size_t size, ECS_Manager& manager, ECS::Registry* registry,
+                     string& sceneName) {
+        using namespace ECS;
+        ByteReader reader(data, size);
+
+        size_t sceneSize = 0;
+        unsigned int version = 0;
+        if (!reader.Read(sceneSize) || !reader.Read(version) || version != 1
+            || !reader.ReadString(sceneName)) {
+            return false;
+        }
+
+        string footer;
+        while (reader.GetRemaining() > 0) {
+            ByteReader probe = reader;
+            if (probe.ReadString(footer) && footer == GKC_SCENE_FOOTER_V1)
+                break;
+
+            size_t entitySize = 0;
+            if (!reader.Read(entitySize))
+                return false;
+            const Uint8* record = reader.Skip(entitySize);
+            if (record == nullptr)
+                return false;
+
+            ByteReader entityReader(record, entitySize);
+            unsigned int entityVersion = 0;
+            EntityID id = 0;
+            if (!entityReader.Read(entityVersion) || !entityReader.Read(id))
+                return false;
+
+            Entity entity(id, registry); entity.SetID(id);
+            manager.AddEmptyEntity(id, entity);
+
+            // v1 didn't store the component types (nor the tags), the components are read in the
+            // order they are registered, which only matches the session that wrote the scene
+            registry->ForEachRegisteredComponent([&](const ComponentTypeInfo& info) {
+                if (info.m_isTag || entityReader.GetRemaining() == 0)
+                    return;
+
+                // v1 was written when AnimationComponent only had the ID, the playback state is new
+                if (info.m_type == typeid(AnimationComponent)) {
+                    AnimationID animation = 0;
+                    if (entityReader.Read(animation))
+                        manager.AddRawComponentToEntity(id, info.m_type, any(AnimationComponent(animation)));
+                    return;
+                }
+
+                any component;
+                if (info.m_deserialize(component, entityReader))
+                    manager.AddRawComponentToEntity(id, info.m_type, std::move(component));
+            });
+            manager.IndexEntityName(id);
+        }
+        return true;
+    }
+}
+
+void Filesystem::FileReader::ReadString(std::istream &file, string &str) {
+    GKC_ENSURE_STREAM_GOOD(file, Debug::ReadingException);
     using namespace ECS;
 
     size_t len = 0;
@@ -18,102 +501,264 @@ void Filesystem::FileReader::ReadString(ifstream &file, string &str) {
     file.read(str.data(), len);
 }
 
-// @todo Add a function to convert old save files into new formats
+bool Filesystem::FileReader::LoadScene(const Uint8* data, size_t size, Core::Managers::ECS_Manager& manager,
+    ECS::Registry* registry, string& sceneName, bool registerTypes) {
+    if (data == nullptr)
+        return false;
+
+    if (size >= GKC_SCENE_HEADER_SIZE_V2 && std::memcmp(data, GKC_SCENE_MAGIC, sizeof(GKC_SCENE_MAGIC)) == 0) {
+        if (registerTypes)
+            ECS::ComponentRegistry::RegisterEngineComponents();
+        return LoadSceneV2(data, size, manager, registry, sceneName);
+    }
 
-void Filesystem::FileReader::ReadEntity(ifstream &file, Core::Managers::ECS_Manager& manager,
-    ECS::Registry* registry) {
-    GKC_ENSURE_FILE_OPEN(file, Debug::ReadingException);
+    GKC_ENGINE_WARNING("Reading a scene in the old format, save it (or use ConvertScene) to upgrade it");
+    return LoadSceneV1(data, size, manager, registry, sceneName);
+}
+
+bool Filesystem::FileReader::LoadSceneEntity(const Uint8* data, size_t size, EntityID id,
+    Core::Managers::ECS_Manager& manager, ECS::Registry* registry) {
     using namespace ECS;
+    SceneHeader header{};
+    if (!ReadSceneHeader(data, size, header) || header.version_ < 5) {
+        GKC_ENGINE_ERROR("Only scenes saved since version 5 have an entity index, convert the scene first");
+        return false;
+    }
 
-    size_t entitySize = 0;
-    unsigned int entityVersion = 0;
-    EntityID id = 0;
+    const auto compression = static_cast<Compression_Type>(header.compression_);
+    size_t namesSize = 0;
+    if (!IsCompressionAvailable(compression) || !ValidateSceneTables(data, size, header, namesSize))
+        return false;
 
-    file.read(GKC_READ_BINARY(entitySize), sizeof(entitySize));
-    Read(file, entityVersion);
-    Read(file, id);
+    // The IDs are sorted, so are the entities of the index
+    const auto* entityIDs = reinterpret_cast<const EntityID*>(data + header.entitiesOffset_);
+    const auto* found = std::lower_bound(entityIDs, entityIDs + header.entityCount_, id);
+    if (found == entityIDs + header.entityCount_ || *found != id)
+        return false;
 
-    Entity entity(id, registry); entity.SetID(id);
-    manager.AddEmptyEntity(id, entity);
-    registry->ForEachRegisteredComponent([&](const ComponentTypeInfo& info) {
-        if (info.m_isTag) {
-            manager.AddTagByType(id, info.m_type);
-            return;
+    const auto* firstEntry = reinterpret_cast<const Uint32*>(data + header.indexOffset_);
+    const auto* entries = reinterpret_cast<const SceneIndexEntry*>(firstEntry + header.entityCount_ + 1);
+    const size_t entity = found - entityIDs;
+    const Uint32 first = firstEntry[entity];
+    const Uint32 last = firstEntry[entity + 1];
+    if (first > last || last > header.indexCount_)
+        return false;
+
+    if (!manager.GetEntityList().contains(id)) {
+        Entity newEntity(id, registry);
+        manager.AddEmptyEntity(id, newEntity);
+    }
+
+    ComponentRegistry::RegisterEngineComponents();
+    auto& pools = registry->GetComponentPools();
+    const char* names = reinterpret_cast<const char*>(data + header.namesOffset_);
+    const auto* fieldTable = reinterpret_cast<const SceneField*>(data + header.columnsOffset_
+        + header.columnCount_ * GetSceneColumnSize(header.version_));
+    vector<Uint8> scratch;
+    SceneColumn column{};
+    Uint32 columnIndex = 0;
+    Uint32 firstField = 0;
+    for (Uint32 i = first; i < last; ++i) {
+        const SceneIndexEntry& entry = entries[i];
+        if (entry.column_ >= header.columnCount_ || entry.column_ < columnIndex)
+            return false;
+
+        // The entries are in column order, the fields of the columns in between are skipped
+        for (; columnIndex < entry.column_; ++columnIndex) {
+            ReadSceneColumn(data, header, columnIndex, column);
+            firstField += column.fieldCount_;
+        }
+        ReadSceneColumn(data, header, entry.column_, column);
+        if (firstField > header.fieldCount_ || column.fieldCount_ > header.fieldCount_ - firstField
+            || !IsRangeValid(column.nameOffset_, column.nameLength_, namesSize)) {
+            return false;
         }
+        std::span<const SceneField> fields(fieldTable + firstField, column.fieldCount_);
 
-        any component;
-        info.m_deserialize(component, file);
-        manager.AddRawComponentToEntity(id, info.m_type, std::move(component));
-    });
+        std::string_view name(names + column.nameOffset_, column.nameLength_);
+        const ComponentTypeInfo* info = ComponentRegistry::FindByName(name);
+        if (info == nullptr || !info->CanReadColumn(column.flags_, column.elementSize_)) {
+            GKC_ENGINE_WARNING("'{0}' of entity {1} can't be read by this version, it was skipped", name, id);
+            continue;
+        }
 
-    #if GKC_DEBUG
-        GKC_ENGINE_INFO("Read entity (ID: {0}): successfully", id);
-    #endif
+        auto& pool = pools[info->m_type];
+        bool read = false;
+        if ((column.flags_ & SCENE_COLUMN_COMPRESSED) != 0) {
+            // The whole block is read, only the entity is kept
+            const Uint64 blockOffset = column.offset_ + entry.offset_;
+            SceneBlock block{};
+            if (!IsRangeValid(blockOffset, sizeof(SceneBlock), size))
+                return false;
+            std::memcpy(&block, data + blockOffset, sizeof(SceneBlock));
+            const Uint8* stored = data + blockOffset + sizeof(SceneBlock);
+            if (!IsRangeValid(blockOffset + sizeof(SceneBlock), block.storedSize_, size)
+                || Core::HashCRC32C(stored, block.storedSize_) != block.checksum_) {
+                GKC_ENGINE_ERROR("The block of '{0}' of entity {1} is damaged", name, id);
+                return false;
+            }
+
+            unordered_map<EntityID, any> blockPool;
+            read = ReadBlock(block, stored, compression, *info, blockPool, fields, scratch);
+            auto component = blockPool.find(id);
+            read = read && component != blockPool.end();
+            if (read)
+                pool[id] = std::move(component->second);
+        } else {
+            // Components of POD and field columns all have the same size, the others are read
+            // until they end
+            const Uint64 idsSize = static_cast<Uint64>(column.count_) * sizeof(EntityID);
+            const Uint64 dataStart = column.offset_ + idsSize;
+            const Uint64 componentOffset = column.offset_ + entry.offset_;
+            const bool isTag = (column.flags_ & SCENE_COLUMN_TAG) != 0;
+            const bool isFixed = (column.flags_ & (SCENE_COLUMN_POD | SCENE_COLUMN_FIELDS)) != 0;
+            if (isTag) {
+                read = info->m_readColumn(nullptr, 0, &id, 1, pool, fields);
+            } else if (column.count_ > 0 && componentOffset >= dataStart
+                       && IsRangeValid(dataStart, column.dataSize_, size)
+                       && componentOffset - dataStart <= column.dataSize_) {
+                const Uint64 remaining = column.dataSize_ - (componentOffset - dataStart);
+                const Uint64 bytes = isFixed ? column.dataSize_ / column.count_ : remaining;
+                read = bytes <= remaining
+                    && info->m_readColumn(data + componentOffset, static_cast<size_t>(bytes), &id, 1, pool, fields);
+            }
+        }
+
+        if (!read) {
+            GKC_ENGINE_ERROR("'{0}' of entity {1} is malformed", name, id);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Filesystem::FileReader::VerifyScene(const path& file) {
+    MappedFile mapped;
+    size_t size = 0;
+    const Uint8* data = MapScene(file, mapped, size);
+    if (data == nullptr) {
+        GKC_ENGINE_ERROR("Failed to open '{}'", file.string());
+        return false;
+    }
+
+    SceneHeader header{};
+    size_t namesSize = 0;
+    if (!ReadSceneHeader(data, size, header) || !ValidateSceneTables(data, size, header, namesSize)) {
+        GKC_ENGINE_ERROR("'{}' is not a valid scene or its tables are corrupted", file.string());
+        return false;
+    }
+    if (header.version_ < 5) {
+        GKC_ENGINE_WARNING("'{}' was saved without checksums, only its tables were checked", file.string());
+        return true;
+    }
+
+    const vector<Uint8> intact = VerifyColumns(data, size, header);
+    const char* names = reinterpret_cast<const char*>(data + header.namesOffset_);
+    Uint32 damaged = 0;
+    for (Uint32 i = 0; i < header.columnCount_; ++i) {
+        if (intact[i] != 0)
+            continue;
+        SceneColumn column{};
+        ReadSceneColumn(data, header, i, column);
+        const std::string_view name = IsRangeValid(column.nameOffset_, column.nameLength_, namesSize)
+            ? std::string_view(names + column.nameOffset_, column.nameLength_) : std::string_view("?");
+        GKC_ENGINE_ERROR("Column of '{0}' in '{1}' is damaged ({2} components)", name, file.string(), column.count_);
+        ++damaged;
+    }
+    return damaged == 0;
 }
 
 void Filesystem::FileReader::ReadScene(const path& path, Core::Managers::ECS_Manager& manager,
     ECS::Registry* registry, Core::Scene& scene) {
-    using namespace ECS;
-
     GKC_ENGINE_INFO("Reading scene from {}", path.string());
-    ifstream file(path, std::ios::binary);
-    GKC_ENSURE_FILE_OPEN(file, Debug::ReadingException);
 
-    size_t sceneSize = 0;
-    unsigned int version = 0;
+    MappedFile mapped;
+    size_t size = 0;
+    const Uint8* data = MapScene(path, mapped, size);
+    if (data == nullptr) {
+        GKC_THROW_EXCEPTION(Debug::ReadingException, "file is not open!");
+    }
+
     string sceneName;
+    if (!LoadScene(data, size, manager, registry, sceneName)) {
+        GKC_ENGINE_ERROR("'{}' is not a valid scene or it's corrupted", path.string());
+        return;
+    }
+    scene.m_sceneInfo.scene_name_ = sceneName;
 
-    file.read(GKC_READ_BINARY(sceneSize), sizeof(sceneSize));
-    Read(file, version);
-    if (version != GKC_VERSION_SCENE) {
-        if (version < GKC_VERSION_SCENE) {
-            GKC_ENGINE_ERROR("This scene cannot be read by this function, use a newer version");
-            return;
-        }
-        if (version > GKC_VERSION_SCENE) {
-            GKC_ENGINE_ERROR("This scene cannot be read by this function, use an older version");
-            return;
-        }
+    // The scene is saved again with the codec it was read with
+    SceneHeader header{};
+    if (ReadSceneHeader(data, size, header))
+        scene.SetSaveCompression(static_cast<Compression_Type>(header.compression_));
+
+    // Archived scenes are read only, only scenes on disk have a journal
+    const Uint32 snapshot = GetSceneSnapshot(data, size);
+    if (mapped.IsOpen()) {
+        size_t deltas = SceneJournal::Replay(path, snapshot, manager, registry);
+        if (deltas > 0)
+            GKC_ENGINE_INFO("Applied {0} incremental saves to '{1}'", deltas, sceneName);
     }
+    registry->ClearChanges();
 
-    ReadString(file, sceneName);
-    scene.m_sceneInfo.scene_name_ = sceneName;
+    // Incremental saves can be appended to the file, archived and v1 scenes are saved whole first
+    scene.m_sceneInfo.snapshot_saved_ = mapped.IsOpen() && snapshot != 0;
 
-    // Read entities until footer string
-    while (true) {
-        std::streampos entityPos = file.tellg();
-        if (!file.good())
-            break;
+    GKC_ENGINE_INFO("'{}' scene was read successfully!", scene.m_sceneInfo.scene_name_);
+}
 
-        size_t stringSize = 0;
-        file.read(GKC_READ_BINARY(stringSize), sizeof(stringSize));
-        if (!file.good()) {
-            break;
-        }
+bool Filesystem::FileReader::ConvertScene(const path& input, const path& output, Compression_Type compression) {
+    MappedFile mapped;
+    size_t size = 0;
+    const Uint8* data = MapScene(input, mapped, size);
+    if (data == nullptr) {
+        GKC_ENGINE_ERROR("Failed to open '{}'", input.string());
+        return false;
+    }
 
-        // Avoid wrong readings
-        if (stringSize > 1024) {
-            file.seekg(entityPos);
-            ReadEntity(file, manager, registry);
-            continue;
-        }
+    ECS::Registry registry;
+    Core::Managers::ECS_Manager manager(&registry);
+    string sceneName;
+    if (!LoadScene(data, size, manager, &registry, sceneName)) {
+        GKC_ENGINE_ERROR("'{}' is not a valid scene or it's corrupted", input.string());
+        return false;
+    }
 
-        string footer(stringSize, '\0');
-        file.read(footer.data(), stringSize);
+    ByteBuffer buffer(manager.GetEntityList().size() * 64 + 256);
+    FileWriter::SerializeScene(buffer, sceneName, manager.GetEntityList(), &registry, compression);
+    // Unmapped first, the output can replace the input
+    mapped.Close();
+    if (!WriteFileAtomic(output, buffer.GetData(), buffer.GetSize()))
+        return false;
 
-        if (!file.good()) {
-            break;
-        }
+    GKC_ENGINE_INFO("'{0}' converted to the scene format v{1}", input.string(), GKC_VERSION_SCENE);
+    return true;
+}
 
-        // End when the footer is found
-        if (footer == "Wrote in Galaktic ^o^") {
-            break;
-        }
+bool Filesystem::FileReader::ConvertSceneToWorld(const path& input, const path& output, float cellSize,
+                                                 Compression_Type compression) {
+    MappedFile mapped;
+    size_t size = 0;
+    const Uint8* data = MapScene(input, mapped, size);
+    if (data == nullptr) {
+        GKC_ENGINE_ERROR("Failed to open '{}'", input.string());
+        return false;
+    }
 
-        file.seekg(entityPos);
-        ReadEntity(file, manager, registry);
+    ECS::Registry registry;
+    Core::Managers::ECS_Manager manager(&registry);
+    string sceneName;
+    if (!LoadScene(data, size, manager, &registry, sceneName)) {
+        GKC_ENGINE_ERROR("'{}' is not a valid scene or it's corrupted", input.string());
+        return false;
     }
 
-    file.close();
-    GKC_ENGINE_INFO("'{}' scene was read successfully!", scene.m_sceneInfo.scene_name_);
-}
\ No newline at end of file
+    ByteBuffer buffer(size + 256);
+    const Uint32 cells = FileWriter::SerializeWorld(buffer, sceneName, manager.GetEntityList(), &registry,
+        cellSize, compression);
+    mapped.Close();
+    if (!WriteFileAtomic(output, buffer.GetData(), buffer.GetSize()))
+        return false;
+
+    GKC_ENGINE_INFO("'{0}' was split in {1} cells of {2} px", input.string(), cells, cellSize);
+    return true;
+}
@@ -0,0 +1,385 @@
+#include <filesys/gkc_scene_journal.h>
+#include "core/gkc_hash.h"
+#include "core/gkc_logger.h"
+#include "core/managers/gkc_ecs_man.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_reader.h"
+#include "filesys/gkc_scene_format.h"
+#include "filesys/gkc_writer.h"
+#include <ecs/gkc_registry.h>
+
+using namespace Galaktic;
+using namespace Galaktic::Filesystem;
+
+namespace {
+    using Core::Managers::ECS_Manager;
+
+    vector<EntityID> SortIDs(const unordered_set<EntityID>& ids) {
+        vector<EntityID> sorted(ids.begin(), ids.end());
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+    void WriteIDs(ByteBuffer& buffer, const vector<EntityID>& ids) {
+        buffer.Write(static_cast<Uint32>(ids.size()));
+        buffer.Append(ids.data(), ids.size() * sizeof(EntityID));
+    }
+
+    // Deltas aren't aligned, IDs are copied out instead of read in place
+    bool ReadIDs(ByteReader& reader, Uint32 count, vector<EntityID>& ids) {
+        ids.resize(count);
+        return reader.Read(ids.data(), static_cast<size_t>(count) * sizeof(EntityID));
+    }
+
+    bool ReadIDs(ByteReader& reader, vector<EntityID>& ids) {
+        Uint32 count = 0;
+        return reader.Read(count) && ReadIDs(reader, count, ids);
+    }
+
+    // Only columns stored field by field have a field list, the journals before them don't
+    bool ReadFields(ByteReader& reader, Uint32 flags, vector<SceneField>& fields) {
+        fields.clear();
+        if ((flags & SCENE_COLUMN_FIELDS) == 0)
+            return true;
+        Uint32 count = 0;
+        if (!reader.Read(count) || count > reader.GetRemaining() / sizeof(SceneField))
+            return false;
+        fields.resize(count);
+        return reader.Read(fields.data(), static_cast<size_t>(count) * sizeof(SceneField));
+    }
+
+    bool ApplyDelta(const Uint8* data, size_t size, ECS_Manager& manager, ECS::Registry* registry) {
+        using namespace ECS;
+        ByteReader reader(data, size);
+        vector<EntityID> ids;
+        vector<EntityID> removed;
+
+        if (!ReadIDs(reader, ids))
+            return false;
+        for (EntityID id : ids)
+            manager.DeleteEntity(id);
+
+        if (!ReadIDs(reader, ids))
+            return false;
+        for (EntityID id : ids) {
+            Entity entity(id, registry);
+            manager.AddEmptyEntity(id, entity);
+        }
+
+        Uint32 columnCount = 0;
+        if (!reader.Read(columnCount))
+            return false;
+
+        auto& pools = registry->GetComponentPools();
+        string name;
+        vector<SceneField> fields;
+        for (Uint32 i = 0; i < columnCount; ++i) {
+            Uint32 flags = 0, elementSize = 0, changedCount = 0, removedCount = 0;
+            Uint64 dataSize = 0;
+            if (!reader.ReadString(name) || !reader.Read(flags) || !reader.Read(elementSize)
+                || !ReadFields(reader, flags, fields) || !reader.Read(changedCount) || !reader.Read(removedCount)
+                || !reader.Read(dataSize) || !ReadIDs(reader, changedCount, ids)
+                || !ReadIDs(reader, removedCount, removed)) {
+                return false;
+            }
+            const Uint8* columnData = reader.Skip(static_cast<size_t>(dataSize));
+            if (columnData == nullptr)
+                return false;
+
+            const ComponentTypeInfo* info = ComponentRegistry::FindByName(name);
+            if (info == nullptr || !info->CanReadColumn(flags, elementSize)) {
+                GKC_ENGINE_WARNING("'{0}' is unknown or changed since it was saved, its changes were skipped", name);
+                continue;
+            }
+
+            auto& pool = pools[info->m_type];
+            if (!info->m_readColumn(columnData, static_cast<size_t>(dataSize), ids.data(), changedCount, pool, fields))
+                return false;
+            for (EntityID id : removed)
+                pool.erase(id);
+        }
+        return true;
+    }
+
+    bool IsJournalHeaderValid(const JournalHeader& header) {
+        return std::memcmp(header.magic_, GKC_SCENE_JOURNAL_MAGIC, sizeof(GKC_SCENE_JOURNAL_MAGIC)) == 0
+            && header.version_ == GKC_VERSION_SCENE_JOURNAL;
+    }
+
+    bool ReadJournalHeader(const Uint8* data, size_t size, JournalHeader& header) {
+        if (size < sizeof(JournalHeader))
+            return false;
+        std::memcpy(&header, data, sizeof(header));
+        return IsJournalHeaderValid(header);
+    }
+
+    JournalHeader MakeJournalHeader(Uint32 snapshot) {
+        JournalHeader header{};
+        std::memcpy(header.magic_, GKC_SCENE_JOURNAL_MAGIC, sizeof(GKC_SCENE_JOURNAL_MAGIC));
+        header.version_ = GKC_VERSION_SCENE_JOURNAL;
+        header.snapshot_ = snapshot;
+        return header;
+    }
+
+    /**
+     * @brief Calls fn with every valid delta of a journal, stops at the first damaged one
+     * @return Offset where the valid deltas end
+     */
+    template<typename Fn>
+    size_t ForEachDelta(const Uint8* data, size_t size, Fn&& fn) {
+        size_t offset = sizeof(JournalHeader);
+        while (offset <= size && size - offset >= sizeof(JournalRecord)) {
+            JournalRecord record{};
+            std::memcpy(&record, data + offset, sizeof(record));
+
+            const size_t deltaOffset = offset + sizeof(record);
+            if (record.size_ > size - deltaOffset
+                || Core::HashFNV1a(data + deltaOffset, static_cast<size_t>(record.size_)) != record.checksum_
+                || !fn(data + deltaOffset, static_cast<size_t>(record.size_))) {
+                break;
+            }
+            offset = deltaOffset + static_cast<size_t>(record.size_);
+        }
+        return offset;
+    }
+
+    // Only the headers are read, the files aren't mapped on every save
+    template<typename Header>
+    bool ReadFileHeader(const path& file, Header& header) {
+        ifstream input(file, std::ios::binary);
+        return input.is_open() && input.read(reinterpret_cast<char*>(&header), sizeof(Header)).good();
+    }
+}
+
+std::mutex SceneJournal::m_mutex;
+std::thread SceneJournal::m_compactor;
+std::atomic<bool> SceneJournal::m_compacting = false;
+
+path SceneJournal::GetJournalPath(const path& scene) {
+    path journal = scene;
+    journal += GKC_SCENE_JOURNAL_EXTENSION;
+    return journal;
+}
+
+void SceneJournal::SerializeDelta(ByteBuffer& buffer, const ECS::Entity_List& entities, ECS::Registry* registry) {
+    using namespace ECS;
+
+    WriteIDs(buffer, SortIDs(registry->GetDestroyedEntities()));
+
+    vector<EntityID> created;
+    for (EntityID id : registry->GetCreatedEntities()) {
+        if (entities.contains(id))
+            created.push_back(id);
+    }
+    std::sort(created.begin(), created.end());
+    WriteIDs(buffer, created);
+
+    const size_t countOffset = buffer.Reserve<Uint32>();
+    Uint32 columnCount = 0;
+    auto& pools = registry->GetComponentPools();
+    for (const auto& [type, changes] : registry->GetComponentChanges()) {
+        if ((changes.changed_.empty() && changes.removed_.empty()) || !ComponentRegistry::IsRegistered(type))
+            continue;
+
+        const ComponentTypeInfo& info = ComponentRegistry::Get(type);
+        auto pool = pools.find(type);
+        vector<EntityID> changed;
+        if (pool != pools.end()) {
+            for (EntityID id : changes.changed_) {
+                if (entities.contains(id) && pool->second.contains(id))
+                    changed.push_back(id);
+            }
+        }
+        std::sort(changed.begin(), changed.end());
+        vector<EntityID> removed = SortIDs(changes.removed_);
+
+        buffer.WriteString(info.m_name);
+        buffer.Write(info.GetColumnFlags());
+        buffer.Write(info.GetElementSize());
+        if (info.IsReflected()) {
+            buffer.Write(static_cast<Uint32>(info.m_fields.size()));
+            for (const ComponentField& field : info.m_fields)
+                buffer.Write(SceneField{ field.id_, field.size_ });
+        }
+        buffer.Write(static_cast<Uint32>(changed.size()));
+        buffer.Write(static_cast<Uint32>(removed.size()));
+        const size_t sizeOffset = buffer.Reserve<Uint64>();
+        buffer.Append(changed.data(), changed.size() * sizeof(EntityID));
+        buffer.Append(removed.data(), removed.size() * sizeof(EntityID));
+
+        const size_t dataStart = buffer.GetSize();
+        if (!info.m_isTag) {
+            for (EntityID id : changed)
+                info.m_serialize(pool->second.at(id), buffer);
+        }
+        buffer.Patch(sizeOffset, static_cast<Uint64>(buffer.GetSize() - dataStart));
+        ++columnCount;
+    }
+    buffer.Patch(countOffset, columnCount);
+}
+
+bool SceneJournal::Append(const path& scene, const ByteBuffer& delta) {
+    std::lock_guard lock(m_mutex);
+    const path journal = GetJournalPath(scene);
+
+    SceneHeader sceneHeader{};
+    const Uint32 snapshot = ReadFileHeader(scene, sceneHeader)
+        ? GetSceneSnapshot(reinterpret_cast<const Uint8*>(&sceneHeader), sizeof(sceneHeader)) : 0;
+    if (snapshot == 0) {
+        GKC_ENGINE_ERROR("'{0}' has no snapshot to add changes to, save the whole scene first", scene.string());
+        return false;
+    }
+
+    JournalHeader header{};
+    const bool started = ReadFileHeader(journal, header) && IsJournalHeaderValid(header)
+        && header.snapshot_ == snapshot;
+
+    ByteBuffer record(sizeof(JournalHeader) + sizeof(JournalRecord) + delta.GetSize());
+    if (!started)
+        record.Write(MakeJournalHeader(snapshot));
+    record.Write(JournalRecord{ delta.GetSize(), Core::HashFNV1a(delta.GetData(), delta.GetSize()) });
+    record.Append(delta.GetData(), delta.GetSize());
+
+    // A journal of an older snapshot is replaced at once, never appended to
+    return started ? AppendFileSynced(journal, record.GetData(), record.GetSize())
+                   : WriteFileAtomic(journal, record.GetData(), record.GetSize());
+}
+
+size_t SceneJournal::Replay(const path& scene, Uint32 snapshot, Core::Managers::ECS_Manager& manager,
+                            ECS::Registry* registry) {
+    std::lock_guard lock(m_mutex);
+    const path journal = GetJournalPath(scene);
+    if (snapshot == 0 || !CheckFile(journal))
+        return 0;
+
+    MappedFile file;
+    JournalHeader header{};
+    if (!file.Open(journal) || !ReadJournalHeader(file.GetData(), file.GetSize(), header)
+        || header.snapshot_ != snapshot) {
+        GKC_ENGINE_WARNING("The journal of '{0}' belongs to another save, it was discarded", scene.string());
+        file.Close();
+        RemoveFile(journal);
+        return 0;
+    }
+
+    size_t applied = 0;
+    const size_t end = ForEachDelta(file.GetData(), file.GetSize(), [&](const Uint8* delta, size_t size) {
+        if (!ApplyDelta(delta, size, manager, registry))
+            return false;
+        ++applied;
+        return true;
+    });
+
+    const size_t size = file.GetSize();
+    file.Close();
+    if (end < size) {
+        // Usually a save interrupted by a crash, new deltas can't be appended after it
+        GKC_ENGINE_WARNING("The journal of '{0}' is damaged after {1} changes, the rest was dropped",
+            scene.string(), applied);
+        std::error_code error;
+        std::filesystem::resize_file(journal, end, error);
+    }
+    return applied;
+}
+
+bool SceneJournal::Compact(const path& scene) {
+    const path journal = GetJournalPath(scene);
+    size_t merged = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        std::error_code error;
+        merged = static_cast<size_t>(std::filesystem::file_size(journal, error));
+        if (error)
+            return false;
+    }
+
+    // Merged without the lock, deltas appended meanwhile are moved to the new journal
+    ByteBuffer buffer;
+    Uint32 snapshot = 0;
+    {
+        ECS::Registry registry;
+        ECS_Manager manager(&registry);
+        string sceneName;
+
+        MappedFile sceneFile, journalFile;
+        JournalHeader header{};
+        const Uint32 base = sceneFile.Open(scene) ? GetSceneSnapshot(sceneFile.GetData(), sceneFile.GetSize()) : 0;
+        if (base == 0 || !journalFile.Open(journal)
+            || !ReadJournalHeader(journalFile.GetData(), journalFile.GetSize(), header) || header.snapshot_ != base
+            || !FileReader::LoadScene(sceneFile.GetData(), sceneFile.GetSize(), manager, &registry, sceneName)) {
+            GKC_ENGINE_WARNING("'{0}' couldn't be compacted", scene.string());
+            return false;
+        }
+
+        merged = ForEachDelta(journalFile.GetData(), std::min(merged, journalFile.GetSize()),
+            [&](const Uint8* delta, size_t size) { return ApplyDelta(delta, size, manager, &registry); });
+
+        // The new snapshot keeps the codec of the old one
+        SceneHeader sceneHeader{};
+        ReadSceneHeader(sceneFile.GetData(), sceneFile.GetSize(), sceneHeader);
+        buffer.ReserveCapacity(sceneFile.GetSize() + merged);
+        snapshot = FileWriter::SerializeScene(buffer, sceneName, manager.GetEntityList(), &registry,
+            static_cast<Compression_Type>(sceneHeader.compression_));
+    }
+
+    std::lock_guard lock(m_mutex);
+    ByteBuffer rest;
+    {
+        ifstream file(journal, std::ios::binary | std::ios::ate);
+        const auto size = static_cast<size_t>(std::max<std::streamoff>(file.tellg(), 0));
+        if (size > merged) {
+            vector<Uint8> tail(size - merged);
+            file.seekg(static_cast<std::streamoff>(merged));
+            file.read(reinterpret_cast<char*>(tail.data()), static_cast<std::streamsize>(tail.size()));
+            rest.Write(MakeJournalHeader(snapshot));
+            rest.Append(tail.data(), tail.size());
+        }
+    }
+
+    // The snapshot goes first, if the journal isn't replaced the old one no longer matches
+    if (!WriteFileAtomic(scene, buffer.GetData(), buffer.GetSize()))
+        return false;
+    if (rest.IsEmpty())
+        RemoveFile(journal);
+    else
+        WriteFileAtomic(journal, rest.GetData(), rest.GetSize());
+
+    GKC_ENGINE_INFO("'{0}' was compacted into {1} bytes", scene.string(), buffer.GetSize());
+    return true;
+}
+
+void SceneJournal::CompactAsync(const path& scene) {
+    if (m_compacting.exchange(true))
+        return;
+
+    if (m_compactor.joinable())
+        m_compactor.join();
+    m_compactor = std::thread([scene]() {
+        Compact(scene);
+        m_compacting = false;
+    });
+}
+
+bool SceneJournal::NeedsCompaction(const path& scene) {
+    std::error_code error;
+    const auto journalSize = std::filesystem::file_size(GetJournalPath(scene), error);
+    if (error)
+        return false;
+    const auto sceneSize = std::filesystem::file_size(scene, error);
+    if (error)
+        return false;
+    return journalSize >= GKC_SCENE_JOURNAL_COMPACT_MIN && journalSize * GKC_SCENE_JOURNAL_COMPACT_RATIO >= sceneSize;
+}
+
+void SceneJournal::WaitForCompaction() {
+    if (m_compactor.joinable())
+        m_compactor.join();
+}
+
+void SceneJournal::Discard(const path& scene) {
+    std::lock_guard lock(m_mutex);
+    const path journal = GetJournalPath(scene);
+    if (CheckFile(journal))
+        RemoveFile(journal);
+}
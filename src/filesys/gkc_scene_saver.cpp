@@ -0,0 +1,117 @@
+#include <filesys/gkc_scene_saver.h>
+#include "core/gkc_logger.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_scene_journal.h"
+#include "filesys/gkc_writer.h"
+
+using namespace Galaktic;
+using namespace Galaktic::Filesystem;
+
+std::thread SceneSaver::m_worker;
+std::deque<SceneSnapshot> SceneSaver::m_queue;
+std::mutex SceneSaver::m_mutex;
+std::condition_variable SceneSaver::m_condition;
+std::condition_variable SceneSaver::m_idle;
+std::atomic<size_t> SceneSaver::m_pending = 0;
+std::atomic<bool> SceneSaver::m_failed = false;
+bool SceneSaver::m_stop = false;
+
+SceneSnapshot SceneSaver::Capture(const path& scene, const string& name, const ECS::Entity_List& entities,
+                                  ECS::Registry* registry, bool full, Compression_Type compression) {
+    SceneSnapshot snapshot;
+    snapshot.scene_ = scene;
+    snapshot.name_ = name;
+    snapshot.full_ = full;
+    snapshot.compression_ = compression;
+    snapshot.registry_ = make_unique<ECS::Registry>();
+    registry->CopyTo(*snapshot.registry_, !full);
+    registry->ClearChanges();
+
+    // Only the IDs are serialized, the entities point to the copy in case that changes
+    snapshot.entities_.reserve(entities.size());
+    for (const auto& [id, entity] : entities)
+        snapshot.entities_.emplace(id, ECS::Entity(id, snapshot.registry_.get()));
+    return snapshot;
+}
+
+bool SceneSaver::Save(const SceneSnapshot& snapshot) {
+    if (snapshot.full_) {
+        ByteBuffer buffer(snapshot.entities_.size() * 64 + 256);
+        FileWriter::SerializeScene(buffer, snapshot.name_, snapshot.entities_, snapshot.registry_.get(),
+            snapshot.compression_);
+        if (!WriteFileAtomic(snapshot.scene_, buffer.GetData(), buffer.GetSize()))
+            return false;
+        SceneJournal::Discard(snapshot.scene_);
+        return true;
+    }
+
+    ByteBuffer delta;
+    SceneJournal::SerializeDelta(delta, snapshot.entities_, snapshot.registry_.get());
+    if (!SceneJournal::Append(snapshot.scene_, delta))
+        return false;
+
+    // Already off the main thread, compacted right away
+    if (SceneJournal::NeedsCompaction(snapshot.scene_))
+        SceneJournal::Compact(snapshot.scene_);
+    return true;
+}
+
+void SceneSaver::SaveAsync(SceneSnapshot snapshot) {
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_worker.joinable()) {
+            m_stop = false;
+            m_worker = std::thread(&SceneSaver::WorkerLoop);
+        }
+        m_queue.push_back(std::move(snapshot));
+        ++m_pending;
+    }
+    m_condition.notify_one();
+}
+
+void SceneSaver::Flush() {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [] { return m_pending.load() == 0; });
+}
+
+void SceneSaver::Stop() {
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_worker.joinable())
+            return;
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    m_worker.join();
+}
+
+void SceneSaver::WorkerLoop() {
+    while (true) {
+        SceneSnapshot snapshot;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [] { return m_stop || !m_queue.empty(); });
+            // Queued saves are written before stopping, unlike assets they can't be discarded
+            if (m_queue.empty())
+                return;
+            snapshot = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        const Uint64 start = SDL_GetTicksNS();
+        if (Save(snapshot)) {
+            GKC_ENGINE_INFO("'{0}' was saved in the background ({1} in {2:.2f} ms)", snapshot.name_,
+                snapshot.full_ ? "full" : "changes", static_cast<double>(SDL_GetTicksNS() - start) / 1000000.0);
+        } else {
+            m_failed = true;
+            GKC_ENGINE_ERROR("'{0}' couldn't be saved in the background, the next save writes the whole scene",
+                snapshot.name_);
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            --m_pending;
+        }
+        m_idle.notify_all();
+    }
+}
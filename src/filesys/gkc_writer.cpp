@@ -1,5 +1,6 @@
 #include <filesys/gkc_writer.h>
 #include "core/gkc_exception.h"
+#include "core/gkc_hash.h"
 #include "ecs/gkc_components.h"
 #include "ecs/gkc_entity.h"
 #include <ecs/gkc_registry.h>
@@ -9,8 +10,56 @@
 #include "core/managers/gkc_ecs_man.h"
 #include "ecs/gkc_component_registry.h"
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_scene_format.h>
 using namespace Galaktic;
 
+namespace {
+    using namespace Galaktic::Filesystem;
+
+    /**
+     * @brief Writes a column as a list of blocks, a block is closed once it holds about
+     *        \c GKC_SCENE_BLOCK_SIZE bytes and only whole components go in a block
+     * @param rowOffsets Filled with the offset of the block of every component
+     */
+    void WriteCompressedColumn(ByteBuffer& buffer, const ECS::ComponentTypeInfo& info,
+                               const unordered_map<EntityID, any>& pool, const vector<EntityID>& ids,
+                               Compression_Type compression, vector<size_t>& rowOffsets) {
+        ByteBuffer components;
+        ByteBuffer raw;
+        size_t first = 0;
+
+        auto writeBlock = [&](size_t end) {
+            const size_t count = end - first;
+            raw.Clear();
+            raw.Append(ids.data() + first, count * sizeof(EntityID));
+            raw.Append(components.GetData(), components.GetSize());
+
+            const size_t headerOffset = buffer.Reserve<SceneBlock>();
+            size_t stored = CompressBlock(compression, raw.GetData(), raw.GetSize(), buffer);
+            if (stored == 0) {
+                buffer.Append(raw.GetData(), raw.GetSize());
+                stored = raw.GetSize();
+            }
+            const Uint32 checksum = Core::HashCRC32C(buffer.GetData() + headerOffset + sizeof(SceneBlock), stored);
+            buffer.Patch(headerOffset, SceneBlock{ static_cast<Uint32>(raw.GetSize()),
+                static_cast<Uint32>(stored), static_cast<Uint32>(count), checksum });
+            rowOffsets.insert(rowOffsets.end(), count, headerOffset);
+
+            components.Clear();
+            first = end;
+        };
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (!info.m_isTag)
+                info.m_serialize(pool.at(ids[i]), components);
+            if ((i + 1 - first) * sizeof(EntityID) + components.GetSize() >= GKC_SCENE_BLOCK_SIZE)
+                writeBlock(i + 1);
+        }
+        if (first < ids.size())
+            writeBlock(ids.size());
+    }
+}
+
 void Filesystem::FileWriter::WriteString(ofstream &file, const string &str) {
     GKC_ENSURE_FILE_OPEN(file, Debug::WritingException);
     auto len = static_cast<Uint32>(str.size());
@@ -18,69 +67,226 @@ void Filesystem::FileWriter::WriteString(ofstream &file, const string &str) {
     file.write(str.data(), len);
 }
 
-void Filesystem::FileWriter::WriteEntity(ofstream &file, const ECS::Entity &entity,
-                                         ECS::Registry* registry) {
+Uint32 Filesystem::FileWriter::SerializeScene(ByteBuffer& buffer, const string& sceneName,
+                                            const ECS::Entity_List& entities, ECS::Registry* registry,
+                                            Compression_Type compression) {
     using namespace ECS;
-    GKC_ENSURE_FILE_OPEN(file, Debug::WritingException);
+    if (!IsCompressionAvailable(compression)) {
+        GKC_ENGINE_WARNING("The engine was built without {0}, the scene is written uncompressed",
+            GetCompressionName(compression));
+        compression = Compression_Type::None;
+    }
 
-    size_t entitySize = 0;
-    EntityID id = entity.GetID();
+    // Columns are sorted by entity ID so the same scene always serializes the same way
+    struct Column {
+        const ComponentTypeInfo* info_;
+        const unordered_map<EntityID, any>* pool_;
+        vector<EntityID> ids_;
+    };
+    vector<Column> columns;
+    for (auto& [type, pool] : registry->GetComponentPools()) {
+        if (pool.empty() || !ComponentRegistry::IsRegistered(type))
+            continue;
 
-    entitySize += registry->GetAllComponentsSize(id);
+        Column& column = columns.emplace_back(Column{ &ComponentRegistry::Get(type), &pool, {} });
+        column.ids_.reserve(pool.size());
+        for (auto& pair : pool) {
+            if (entities.contains(pair.first))
+                column.ids_.push_back(pair.first);
+        }
+        std::sort(column.ids_.begin(), column.ids_.end());
+    }
+    std::sort(columns.begin(), columns.end(), [](const Column& a, const Column& b) {
+        return a.info_->m_name < b.info_->m_name;
+    });
 
-    entitySize += sizeof(unsigned int) + sizeof(unsigned int);  // Entity Version & Entity ID
+    vector<EntityID> entityIDs;
+    entityIDs.reserve(entities.size());
+    for (auto& pair : entities)
+        entityIDs.push_back(pair.first);
+    std::sort(entityIDs.begin(), entityIDs.end());
 
-    file.write(GKC_WRITE_BINARY(entitySize), sizeof(entitySize));
-    Write(file, GKC_VERSION_ENTITY);
-    Write(file, entity.GetID());
+    size_t fieldCount = 0;
+    size_t componentCount = 0;
+    for (const Column& column : columns) {
+        fieldCount += column.info_->m_fields.size();
+        componentCount += column.ids_.size();
+    }
 
-    // Write all the components for the entity
-    registry->ForEachComponentDo(id, [&](const ComponentTypeInfo& info, const any& comp) {
-        if (info.m_isTag)
-            return;
+    const size_t headerOffset = buffer.Reserve<SceneHeader>();
+    const size_t columnsOffset = buffer.Reserve<SceneColumn>(columns.size());
+    size_t fieldsOffset = buffer.Reserve<SceneField>(fieldCount);
 
-        info.m_serialize(comp, file);
-    });
+    SceneHeader header{};
+    std::memcpy(header.magic_, GKC_SCENE_MAGIC, sizeof(GKC_SCENE_MAGIC));
+    header.version_ = GKC_VERSION_SCENE;
+    header.entityCount_ = static_cast<Uint32>(entityIDs.size());
+    header.columnCount_ = static_cast<Uint32>(columns.size());
+    header.columnsOffset_ = columnsOffset;
+    header.compression_ = static_cast<Uint32>(compression);
+    header.fieldCount_ = static_cast<Uint32>(fieldCount);
+    header.indexCount_ = static_cast<Uint32>(componentCount);
 
-    #if GKC_DEBUG
-        GKC_ENGINE_INFO("Writing {0} bytes for entity {1}", entitySize, id);
-    #endif
-}
-
-void Filesystem::FileWriter::WriteScene(const path& path, Core::Scene& scene, ECS::Registry* registry) {
-    using namespace ECS;
-    GKC_ENGINE_INFO("Writing scene {0} in {1}", scene.m_sceneInfo.scene_name_, path.string());
-    ofstream file(path.filename(), std::ios::binary);
-    GKC_ENSURE_FILE_OPEN(file, Debug::WritingException);
+    buffer.Align(GKC_SCENE_ALIGNMENT);
+    header.entitiesOffset_ = buffer.GetSize();
+    buffer.Append(entityIDs.data(), entityIDs.size() * sizeof(EntityID));
 
-    size_t sceneSize = scene.m_sceneInfo.scene_name_.length() + sizeof(GKC_VERSION_SCENE);
+    // The names go before the columns, a truncated scene keeps them
+    header.namesOffset_ = buffer.GetSize();
+    header.nameLength_ = static_cast<Uint32>(sceneName.size());
+    buffer.Append(sceneName.data(), sceneName.size());
+    for (const Column& column : columns)
+        buffer.Append(column.info_->m_name.data(), column.info_->m_name.size());
 
-    for (auto& pair : scene.GetECSManager()->GetEntityList()) {
-        sceneSize += scene.GetRegistry()->GetAllComponentsSize(pair.first);
+    // Entity index, the entries of an entity start after the entries of the entities before it
+    vector<Uint32> firstEntry(entityIDs.size() + 1, 0);
+    for (const Column& column : columns) {
+        for (EntityID id : column.ids_) {
+            const size_t entity = std::lower_bound(entityIDs.begin(), entityIDs.end(), id) - entityIDs.begin();
+            ++firstEntry[entity + 1];
+        }
     }
+    for (size_t i = 1; i < firstEntry.size(); ++i)
+        firstEntry[i] += firstEntry[i - 1];
+    vector<Uint32> nextEntry(firstEntry.begin(), firstEntry.end() - 1);
+    vector<SceneIndexEntry> index(componentCount);
+
+    buffer.Align(GKC_SCENE_ALIGNMENT);
+    header.indexOffset_ = buffer.GetSize();
+    buffer.Append(firstEntry.data(), firstEntry.size() * sizeof(Uint32));
+    const size_t entriesOffset = buffer.Reserve<SceneIndexEntry>(componentCount);
+
+    Uint32 nameOffset = static_cast<Uint32>(sceneName.size());
+    vector<size_t> rowOffsets;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const Column& column = columns[i];
+        const ComponentTypeInfo& info = *column.info_;
+
+        buffer.Align(GKC_SCENE_ALIGNMENT);
+        SceneColumn entry{};
+        entry.offset_ = buffer.GetSize();
+        entry.count_ = static_cast<Uint32>(column.ids_.size());
+        entry.elementSize_ = info.GetElementSize();
+        entry.nameOffset_ = nameOffset;
+        entry.nameLength_ = static_cast<Uint32>(info.m_name.size());
+        entry.flags_ = info.GetColumnFlags();
+        entry.fieldCount_ = static_cast<Uint32>(info.m_fields.size());
+        nameOffset += entry.nameLength_;
+
+        for (const ComponentField& field : info.m_fields) {
+            buffer.Patch(fieldsOffset, SceneField{ field.id_, field.size_ });
+            fieldsOffset += sizeof(SceneField);
+        }
 
-    file.write(GKC_WRITE_BINARY(sceneSize), sizeof(sceneSize));
-    Write(file, GKC_VERSION_SCENE);
-    WriteString(file, scene.m_sceneInfo.scene_name_);
+        rowOffsets.clear();
+        rowOffsets.reserve(column.ids_.size());
+        if (compression != Compression_Type::None) {
+            entry.flags_ |= SCENE_COLUMN_COMPRESSED;
+            WriteCompressedColumn(buffer, info, *column.pool_, column.ids_, compression, rowOffsets);
+            entry.dataSize_ = buffer.GetSize() - entry.offset_;
+        } else {
+            buffer.Append(column.ids_.data(), column.ids_.size() * sizeof(EntityID));
+            const size_t dataStart = buffer.GetSize();
+            for (size_t row = 0; row < column.ids_.size(); ++row) {
+                if (info.m_isTag) {
+                    rowOffsets.push_back(entry.offset_ + row * sizeof(EntityID));
+                    continue;
+                }
+                rowOffsets.push_back(buffer.GetSize());
+                info.m_serialize(column.pool_->at(column.ids_[row]), buffer);
+            }
+            entry.dataSize_ = buffer.GetSize() - dataStart;
+        }
 
-    for (auto& pair : scene.GetECSManager()->GetEntityList()) {
-        #if GKC_DEBUG
-            GKC_ENGINE_INFO("Entity #{}: &{}", pair.first, Core::CastToVoidPtr(pair.second));
-        #endif
-        WriteEntity(file, pair.second, registry);
+        GKC_ASSERT(buffer.GetSize() - entry.offset_ <= std::numeric_limits<Uint32>::max(),
+            "Columns bigger than 4 GB can't be indexed");
+        for (size_t row = 0; row < column.ids_.size(); ++row) {
+            const size_t entity = std::lower_bound(entityIDs.begin(), entityIDs.end(), column.ids_[row])
+                - entityIDs.begin();
+            index[nextEntry[entity]++] = { static_cast<Uint32>(i), static_cast<Uint32>(rowOffsets[row] - entry.offset_) };
+        }
+
+        entry.checksum_ = Core::HashCRC32C(buffer.GetData() + entry.offset_, buffer.GetSize() - entry.offset_);
+        buffer.Patch(columnsOffset + i * sizeof(SceneColumn), entry);
     }
+    if (!index.empty())
+        std::memcpy(buffer.GetData() + entriesOffset, index.data(), index.size() * sizeof(SceneIndexEntry));
+
+    // Any value that changes between saves works, journals of older saves must not match it
+    const Uint64 stamp[2] = { SDL_GetPerformanceCounter(), buffer.GetSize() };
+    header.snapshot_ = static_cast<Uint32>(Core::HashFNV1a(stamp, sizeof(stamp))) | 1u;
 
-    WriteString(file, "Wrote in Galaktic ^o^");
-    file.flush();
-    file.close();
+    buffer.Patch(headerOffset, header);
+    header.checksum_ = GetSceneChecksum(buffer.GetData() + headerOffset, header);
+    buffer.Patch(headerOffset, header);
+    return header.snapshot_;
+}
 
+Uint32 Filesystem::FileWriter::SerializeWorld(ByteBuffer& buffer, const string& sceneName,
+                                            const ECS::Entity_List& entities, ECS::Registry* registry,
+                                            float cellSize, Compression_Type compression) {
+    using namespace ECS;
+    GKC_ASSERT(cellSize > 0.f, "World cells must have a size");
 
-    auto filepath = path.filename().string();
-    auto desiredPath = (path.parent_path() / GKC_SCENE_PATH / path.filename()).string();
-    if (CheckFile(desiredPath)) {
-        RemoveFile(desiredPath);
+    // Cells are sorted by row and column, the persistent cell goes first
+    Entity_List persistent;
+    map<std::pair<Sint32, Sint32>, Entity_List> cells;
+    EntityID maxID = 0;
+    for (const auto& [id, entity] : entities) {
+        maxID = std::max(maxID, id);
+        if (!registry->Has<TransformComponent>(id)) {
+            persistent.emplace(id, Entity(id, registry));
+            continue;
+        }
+        const auto& transform = registry->Read<TransformComponent>(id);
+        const Render::Vec2 center = transform.m_location + transform.m_size * 0.5f;
+        cells[{ GetWorldCell(center.y, cellSize), GetWorldCell(center.x, cellSize) }].emplace(id, Entity(id, registry));
     }
 
-    std::rename(filepath.c_str(), desiredPath.c_str());
-    GKC_ENGINE_INFO("'{}' scene was written successfully!", scene.m_sceneInfo.scene_name_);
+    const Uint32 cellCount = static_cast<Uint32>(cells.size()) + (persistent.empty() ? 0 : 1);
+    const size_t headerOffset = buffer.Reserve<WorldHeader>();
+    const size_t cellsOffset = buffer.Reserve<WorldCell>(cellCount);
+
+    WorldHeader header{};
+    std::memcpy(header.magic_, GKC_WORLD_MAGIC, sizeof(GKC_WORLD_MAGIC));
+    header.version_ = GKC_VERSION_WORLD;
+    header.cellCount_ = cellCount;
+    header.cellSize_ = cellSize;
+    header.cellsOffset_ = cellsOffset;
+    header.maxEntityID_ = maxID;
+    buffer.Patch(headerOffset, header);
+
+    // Every cell is a scene of its own, its offsets start at the cell
+    ByteBuffer scene;
+    Uint32 index = 0;
+    auto writeCell = [&](Sint32 x, Sint32 y, const Entity_List& cellEntities, Uint32 flags) {
+        scene.Clear();
+        SerializeScene(scene, sceneName, cellEntities, registry, compression);
+        buffer.Align(GKC_SCENE_ALIGNMENT);
+        const WorldCell cell{ x, y, buffer.GetSize(), scene.GetSize(), static_cast<Uint32>(cellEntities.size()), flags };
+        buffer.Append(scene.GetData(), scene.GetSize());
+        buffer.Patch(cellsOffset + index++ * sizeof(WorldCell), cell);
+    };
+
+    if (!persistent.empty())
+        writeCell(0, 0, persistent, WORLD_CELL_PERSISTENT);
+    for (const auto& [location, cellEntities] : cells)
+        writeCell(location.second, location.first, cellEntities, WORLD_CELL_NONE);
+    return cellCount;
+}
+
+void Filesystem::FileWriter::WriteScene(const path& path, Core::Scene& scene, ECS::Registry* registry,
+                                        Compression_Type compression) {
+    GKC_ENGINE_INFO("Writing scene {0} in {1}", scene.m_sceneInfo.scene_name_, path.string());
+
+    const auto& entities = scene.GetSavedEntities();
+    ByteBuffer buffer(entities.size() * 64 + 256);
+    SerializeScene(buffer, scene.m_sceneInfo.scene_name_, entities, registry, compression);
+
+    auto desiredPath = path.parent_path() / GKC_SCENE_PATH / path.filename();
+    if (!WriteFileAtomic(desiredPath, buffer.GetData(), buffer.GetSize())) {
+        GKC_THROW_EXCEPTION(Debug::WritingException, "scene couldn't be written!");
+    }
+    GKC_ENGINE_INFO("'{0}' scene was written successfully! ({1} bytes)", scene.m_sceneInfo.scene_name_,
+        buffer.GetSize());
 }
@@ -1,110 +1,225 @@
 #include "render/gkc_animation.h"
 #include <core/gkc_logger.h>
 #include "filesys/gkc_filesys.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_asset_index.h"
+#include "render/gkc_decode_cache.h"
+#include "render/gkc_atlas.h"
 
 using namespace Galaktic::Render;
 
 Galaktic::Render::Animation::Animation(const path& path, SDL_Renderer* renderer) {
+    auto baked = Bake(path, GetMaxSheetSize(renderer));
+    if (baked != nullptr) {
+        Upload(*baked, renderer);
+    }
+}
+
+Galaktic::Render::Animation::Animation(BakedAnimation& baked, SDL_Renderer* renderer) {
+    Upload(baked, renderer);
+}
+
+Galaktic::Render::Animation::~Animation() {
+    for (auto* sheet : m_sheets) {
+        if (sheet) {
+            SDL_DestroyTexture(sheet);
+        }
+    }
+    m_sheets.clear();
+    m_frames.clear();
+}
+
+BakedAnimation::~BakedAnimation() {
+    for (auto* sheet : sheets_) {
+        SDL_DestroySurface(sheet);
+    }
+}
+
+int Animation::GetMaxSheetSize(SDL_Renderer* renderer) {
+    return static_cast<int>(SDL_GetNumberProperty(SDL_GetRendererProperties(renderer),
+        SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, GKC_ATLAS_PAGE_SIZE));
+}
+
+unique_ptr<BakedAnimation> Animation::Bake(const path& path, int maxSheetSize) {
     GKC_ENGINE_INFO("Loading {0}...", path.string());
-    if (path.empty() || !Filesystem::CheckFile(path)) {
+    if (path.empty() || !Filesystem::AssetExists(path)) {
         GKC_ENGINE_ERROR( "given path doesn't exists!");
-        return;
+        return nullptr;
+    }
+
+    vector<Uint8> storage;
+    size_t size = 0;
+    const Uint8* data = Filesystem::ReadAsset(path, storage, size);
+    if (data == nullptr)
+        return nullptr;
+
+    // The sheet layout depends on the max sheet size, so it's part of the key
+    Uint64 key = 0;
+    if (DecodeCache::IsEnabled()) {
+        key = DecodeCache::MakeKey(data, size, "sheets:" + to_string(maxSheetSize));
+        if (auto cached = LoadCachedSheets(key))
+            return cached;
     }
 
-    m_animation = IMG_LoadAnimation(path.string().c_str());
+    IMG_Animation* animation = IMG_LoadAnimation_IO(SDL_IOFromConstMem(data, size), true);
 
-    if (m_animation == nullptr) {
+    if (animation == nullptr) {
         GKC_ENGINE_ERROR("failed to load animaiton!");
-        return;
+        return nullptr;
     }
 
-    m_textures = new SDL_Texture*[m_animation->count];
-    for (int i = 0; i < m_animation->count; ++i) {
-        m_textures[i] = SDL_CreateTextureFromSurface(renderer, m_animation->frames[i]);
-        if (m_textures[i] == nullptr) {
-            GKC_ENGINE_ERROR("Failed to create texture for frame {0}: {1}", i, SDL_GetError());
-        }
+    auto baked = BakeSheets(animation, maxSheetSize);
+    if (baked == nullptr) {
+        GKC_ENGINE_ERROR("Failed to create the sprite sheets of {0}", path.string());
+    } else if (DecodeCache::IsEnabled()) {
+        StoreCachedSheets(key, *baked);
     }
+
+    // The frames live in the sheets now
+    IMG_FreeAnimation(animation);
+    return baked;
 }
 
-Galaktic::Render::Animation::~Animation() {
-    if (m_textures) {
-        for (int i = 0; i < m_animation->count; ++i) {
-            if (m_textures[i]) {
-                SDL_DestroyTexture(m_textures[i]);
-            }
-        }
-        delete[] m_textures;
-        m_textures = nullptr;
-    }
-    
-    if (m_animation) {
-        IMG_FreeAnimation(m_animation);
-        m_animation = nullptr;
+unique_ptr<BakedAnimation> Animation::LoadCachedSheets(Uint64 key) {
+    auto baked = make_unique<BakedAnimation>();
+    vector<Uint8> metadata;
+    if (!DecodeCache::Load(key, baked->sheets_, metadata))
+        return nullptr;
+
+    // Metadata: width, height, frame count and the frames
+    Uint32 header[3] = {};
+    if (metadata.size() < sizeof(header))
+        return nullptr;
+    std::memcpy(header, metadata.data(), sizeof(header));
+
+    const size_t frameBytes = static_cast<size_t>(header[2]) * sizeof(AnimationFrame);
+    if (metadata.size() != sizeof(header) + frameBytes || header[2] == 0)
+        return nullptr;
+
+    baked->width_ = static_cast<int>(header[0]);
+    baked->height_ = static_cast<int>(header[1]);
+    baked->frames_.resize(header[2]);
+    std::memcpy(baked->frames_.data(), metadata.data() + sizeof(header), frameBytes);
+
+    for (auto& frame : baked->frames_) {
+        if (frame.sheet_ >= baked->sheets_.size())
+            return nullptr;
     }
+    return baked;
+}
+
+void Animation::StoreCachedSheets(Uint64 key, const BakedAnimation& baked) {
+    const Uint32 header[3] = { static_cast<Uint32>(baked.width_), static_cast<Uint32>(baked.height_),
+        static_cast<Uint32>(baked.frames_.size()) };
+    const size_t frameBytes = baked.frames_.size() * sizeof(AnimationFrame);
+
+    vector<Uint8> metadata(sizeof(header) + frameBytes);
+    std::memcpy(metadata.data(), header, sizeof(header));
+    std::memcpy(metadata.data() + sizeof(header), baked.frames_.data(), frameBytes);
+    DecodeCache::Store(key, baked.sheets_, metadata);
 }
 
-void Animation::Update(float deltaTime) {
-   if (!IsValid() || !m_isPlaying) return;
-    
-    m_accumulatedTime += deltaTime;
-    
-    // Get delay for current frame (IMG_Animation stores delays in milliseconds)
-    float frameDelay = static_cast<float>(m_animation->delays[m_currentFrame]) / 1000.0f;
-    
-    if (m_accumulatedTime >= frameDelay) {
-        m_accumulatedTime -= frameDelay;
-        m_currentFrame++;
-        
-        if (m_currentFrame >= m_animation->count) {
-            if (m_isLooping) {
-                m_currentFrame = 0;
-            } else {
-                m_currentFrame = m_animation->count - 1;
-                m_isPlaying = false;
-            }
+unique_ptr<BakedAnimation> Animation::BakeSheets(const IMG_Animation* animation, int maxSheetSize) {
+    if (animation->count <= 0 || animation->w <= 0 || animation->h <= 0)
+        return nullptr;
+
+    auto baked = make_unique<BakedAnimation>();
+    baked->width_ = animation->w;
+    baked->height_ = animation->h;
+
+    const int width = animation->w;
+    const int height = animation->h;
+    const int cellWidth = width + GKC_ATLAS_PADDING;
+    const int cellHeight = height + GKC_ATLAS_PADDING;
+    const int maxColumns = std::max(1, maxSheetSize / cellWidth);
+    const int maxRows = std::max(1, maxSheetSize / cellHeight);
+    const int framesPerSheet = maxColumns * maxRows;
+
+    baked->frames_.reserve(animation->count);
+    for (int first = 0; first < animation->count; first += framesPerSheet) {
+        const int frameCount = std::min(framesPerSheet, animation->count - first);
+
+        // Keep the sheet close to a square, smaller sheets waste less space
+        int columns = std::min(maxColumns, static_cast<int>(std::ceil(std::sqrt(frameCount))));
+        int rows = (frameCount + columns - 1) / columns;
+
+        SDL_Surface* sheetSurface = SDL_CreateSurface(columns * cellWidth, rows * cellHeight,
+            SDL_PIXELFORMAT_RGBA32);
+        if (sheetSurface == nullptr) {
+            GKC_ENGINE_ERROR("Failed to create animation sheet: {0}", SDL_GetError());
+            return nullptr;
+        }
+        SDL_FillSurfaceRect(sheetSurface, nullptr, 0);
+
+        const auto sheet = static_cast<Uint32>(baked->sheets_.size());
+        baked->sheets_.push_back(sheetSurface);
+        for (int i = 0; i < frameCount; ++i) {
+            SDL_Surface* frameSurface = animation->frames[first + i];
+            SDL_Rect destination = { (i % columns) * cellWidth, (i / columns) * cellHeight, width, height };
+            SDL_SetSurfaceBlendMode(frameSurface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(frameSurface, nullptr, sheetSurface, &destination);
+
+            AnimationFrame frame;
+            frame.sheet_ = sheet;
+            frame.rect_ = { static_cast<float>(destination.x), static_cast<float>(destination.y),
+                static_cast<float>(width), static_cast<float>(height) };
+            // IMG_Animation stores delays in milliseconds, a zero delay is played
+            // at 10 fps like browsers do
+            int delay = animation->delays[first + i];
+            frame.delay_ = delay > 0 ? static_cast<float>(delay) / 1000.0f : 0.1f;
+            baked->frames_.push_back(frame);
         }
     }
+    return baked;
 }
 
-void Animation::Render(SDL_Renderer* renderer, const SDL_FRect& rect) {
-    if (!IsValid()) return;
-    
-    SDL_RenderTexture(renderer, m_textures[m_currentFrame], nullptr, &rect);
-}
+bool Animation::Upload(BakedAnimation& baked, SDL_Renderer* renderer) {
+    m_width = baked.width_;
+    m_height = baked.height_;
 
-void Animation::Play() {
-    m_isPlaying = true;
+    for (auto* sheetSurface : baked.sheets_) {
+        SDL_Texture* sheetTexture = SDL_CreateTextureFromSurface(renderer, sheetSurface);
+        if (sheetTexture == nullptr) {
+            GKC_ENGINE_ERROR("Failed to upload animation sheet: {0}", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureScaleMode(sheetTexture, SDL_SCALEMODE_NEAREST);
+        m_sheets.push_back(sheetTexture);
+    }
+    m_frames = std::move(baked.frames_);
+    return true;
 }
 
-void Animation::Pause() {
-    m_isPlaying = false;
+void Animation::Render(SDL_Renderer* renderer, const SDL_FRect& rect, Uint32 frame) const {
+    if (!IsValid() || frame >= m_frames.size()) return;
+
+    auto& animationFrame = m_frames[frame];
+    SDL_RenderTexture(renderer, m_sheets[animationFrame.sheet_], &animationFrame.rect_, &rect);
 }
 
-void Animation::Stop() {
-    m_isPlaying = false;
-    Reset();
+const AnimationFrame* Animation::GetFrame(int frame) const {
+    if (frame < 0 || frame >= GetFrameCount())
+        return nullptr;
+    return &m_frames[frame];
 }
 
-void Animation::Reset() {
-    m_currentFrame = 0;
-    m_accumulatedTime = 0;
+SDL_Texture* Animation::GetSheet(Uint32 sheet) const {
+    if (sheet >= m_sheets.size())
+        return nullptr;
+    return m_sheets[sheet];
 }
 
-void Animation::SetFrame(int frame) {
-    if (frame >= 0 && frame < GetFrameCount()) {
-        m_currentFrame = frame;
-        m_accumulatedTime = 0;
+size_t Animation::GetMemorySize() const {
+    size_t bytes = 0;
+    for (auto* sheet : m_sheets) {
+        float width = 0.f, height = 0.f;
+        SDL_GetTextureSize(sheet, &width, &height);
+        bytes += static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
     }
+    return bytes;
 }
 
 bool Galaktic::Render::CheckAnimationExtension(const path& path) {
-    if (path.empty() || !Filesystem::CheckFile(path)) {
-        return false;
-    }
-    auto pathStr = path.extension().string();
-
-    if (pathStr == ".gif" || pathStr == ".apng") { return true; }
-
-    return false;
+    // The extension goes first, it doesn't touch the disk
+    return Filesystem::IsAssetExtension(path, Filesystem::Asset_Type::Animation) && Filesystem::AssetExists(path);
 }
\ No newline at end of file
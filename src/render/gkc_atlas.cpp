@@ -0,0 +1,401 @@
+#include <render/gkc_atlas.h>
+#include <render/gkc_texture.h>
+#include "core/gkc_logger.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_writer.h"
+#include "filesys/gkc_reader.h"
+
+using namespace Galaktic;
+using namespace Galaktic::Render;
+
+namespace {
+    const string ATLAS_LAYOUT_FILE = "atlas.gkatlas";
+    constexpr Uint32 INVALID_ATLAS_PAGE = 0xFFFFFFFF;
+
+    path GetPagePath(const path& cacheFolder, size_t page) {
+        return cacheFolder / ("atlas_page_" + to_string(page) + ".png");
+    }
+
+    SDL_FRect MakeUV(const SDL_FRect& rect) {
+        constexpr auto size = static_cast<float>(GKC_ATLAS_PAGE_SIZE);
+        return { rect.x / size, rect.y / size, rect.w / size, rect.h / size };
+    }
+
+    // FileWriter::WriteString stores the length as an Uint32
+    void ReadLayoutString(ifstream& file, string& str) {
+        Uint32 len = 0;
+        Filesystem::FileReader::Read(file, len);
+        if (!file.good() || len > 4096) {
+            file.setstate(std::ios::failbit);
+            return;
+        }
+        str.resize(len);
+        file.read(str.data(), len);
+    }
+}
+
+// Skyline Packer
+
+SkylinePacker::SkylinePacker(int width, int height) : m_width(width), m_height(height) {
+    Reset();
+}
+
+void SkylinePacker::Reset() {
+    m_skyline.clear();
+    m_skyline.push_back({0, 0, m_width});
+}
+
+bool SkylinePacker::Pack(int width, int height, SDL_Rect& out) {
+    int bestTop = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    size_t bestIndex = m_skyline.size();
+
+    for (size_t i = 0; i < m_skyline.size(); ++i) {
+        int y = FitAt(i, width, height);
+        if (y < 0)
+            continue;
+
+        if (y + height < bestTop || (y + height == bestTop && m_skyline[i].width_ < bestWidth)) {
+            bestTop = y + height;
+            bestWidth = m_skyline[i].width_;
+            bestIndex = i;
+            out = { m_skyline[i].x_, y, width, height };
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+        return false;
+
+    AddLevel(bestIndex, out);
+    return true;
+}
+
+int SkylinePacker::FitAt(size_t index, int width, int height) const {
+    if (m_skyline[index].x_ + width > m_width)
+        return -1;
+
+    int y = m_skyline[index].y_;
+    int widthLeft = width;
+    for (size_t i = index; widthLeft > 0; ++i) {
+        if (i >= m_skyline.size())
+            return -1;
+        y = std::max(y, m_skyline[i].y_);
+        if (y + height > m_height)
+            return -1;
+        widthLeft -= m_skyline[i].width_;
+    }
+    return y;
+}
+
+void SkylinePacker::AddLevel(size_t index, const SDL_Rect& rect) {
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(index),
+        { rect.x, rect.y + rect.h, rect.w });
+
+    // Shrink or remove the nodes that are now under the new one
+    for (size_t i = index + 1; i < m_skyline.size();) {
+        int previousEnd = m_skyline[i - 1].x_ + m_skyline[i - 1].width_;
+        auto& node = m_skyline[i];
+        if (node.x_ >= previousEnd)
+            break;
+
+        int shrink = previousEnd - node.x_;
+        node.x_ += shrink;
+        node.width_ -= shrink;
+        if (node.width_ > 0)
+            break;
+        m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    // Merge neighbours with the same height
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+        if (m_skyline[i].y_ == m_skyline[i + 1].y_) {
+            m_skyline[i].width_ += m_skyline[i + 1].width_;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Texture Atlas
+
+TextureAtlas::~TextureAtlas() {
+    Clear();
+}
+
+bool TextureAtlas::Build(const vector<path>& files, SDL_Renderer* renderer, const path& cacheFolder) {
+    Clear();
+    if (files.empty())
+        return false;
+
+    if (!cacheFolder.empty() && LoadCache(files, renderer, cacheFolder)) {
+        GKC_ENGINE_INFO("Loaded {0} atlas page/s from cache ({1} textures)", m_pages.size(), m_regions.size());
+        return true;
+    }
+
+    auto baked = Bake(files, cacheFolder);
+    return Upload(*baked, renderer);
+}
+
+void TextureAtlas::Clear() {
+    for (auto* page : m_pages) {
+        if (page != nullptr)
+            SDL_DestroyTexture(page);
+    }
+    m_pages.clear();
+    m_regions.clear();
+}
+
+const AtlasRegion* TextureAtlas::GetRegion(const string& name) const {
+    auto it = m_regions.find(name);
+    if (it != m_regions.end() && GetPage(it->second.page_) != nullptr) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+SDL_Texture* TextureAtlas::GetPage(Uint32 page) const {
+    if (page >= m_pages.size())
+        return nullptr;
+    return m_pages[page];
+}
+
+unique_ptr<BakedAtlas> TextureAtlas::Bake(const vector<path>& files, const path& cacheFolder) {
+    vector<AtlasImage> images;
+    images.reserve(files.size());
+    for (auto& file : files)
+        images.push_back({file, LoadSurface(file)});
+    return Pack(images, cacheFolder);
+}
+
+unique_ptr<BakedAtlas> TextureAtlas::Pack(vector<AtlasImage>& decoded, const path& cacheFolder) {
+    vector<AtlasImage> images;
+    vector<CacheEntry> entries;
+    images.reserve(decoded.size());
+    entries.reserve(decoded.size());
+
+    for (auto& image : decoded) {
+        SDL_Surface* surface = std::exchange(image.surface_, nullptr);
+        if (surface == nullptr)
+            continue;
+
+        if (surface->w + GKC_ATLAS_PADDING > GKC_ATLAS_PAGE_SIZE
+            || surface->h + GKC_ATLAS_PADDING > GKC_ATLAS_PAGE_SIZE) {
+            GKC_ENGINE_WARNING("'{0}' is too big for the atlas, it will be loaded as a standalone texture",
+                image.path_.string());
+            auto entry = MakeCacheEntry(image.path_);
+            entry.region_.page_ = INVALID_ATLAS_PAGE;
+            entries.push_back(entry);
+            SDL_DestroySurface(surface);
+            continue;
+        }
+        images.push_back({image.path_, surface});
+    }
+
+    // Taller images first, it keeps the skyline flat
+    std::sort(images.begin(), images.end(), [](const AtlasImage& a, const AtlasImage& b) {
+        if (a.surface_->h != b.surface_->h)
+            return a.surface_->h > b.surface_->h;
+        return a.surface_->w > b.surface_->w;
+    });
+
+    auto baked = make_unique<BakedAtlas>();
+    vector<SkylinePacker> packers;
+    vector<SDL_Surface*>& pageSurfaces = baked->pages_;
+
+    for (auto& image : images) {
+        const int width = image.surface_->w;
+        const int height = image.surface_->h;
+        SDL_Rect packed{};
+
+        Uint32 page = 0;
+        for (; page < packers.size(); ++page) {
+            if (packers[page].Pack(width + GKC_ATLAS_PADDING, height + GKC_ATLAS_PADDING, packed))
+                break;
+        }
+
+        if (page == packers.size()) {
+            SDL_Surface* pageSurface = SDL_CreateSurface(GKC_ATLAS_PAGE_SIZE, GKC_ATLAS_PAGE_SIZE,
+                SDL_PIXELFORMAT_RGBA32);
+            if (pageSurface == nullptr) {
+                GKC_ENGINE_ERROR("Failed to create atlas page: {0}", SDL_GetError());
+                SDL_DestroySurface(image.surface_);
+                image.surface_ = nullptr;
+                continue;
+            }
+            SDL_FillSurfaceRect(pageSurface, nullptr, 0);
+            pageSurfaces.push_back(pageSurface);
+            packers.emplace_back(GKC_ATLAS_PAGE_SIZE, GKC_ATLAS_PAGE_SIZE);
+            packers.back().Pack(width + GKC_ATLAS_PADDING, height + GKC_ATLAS_PADDING, packed);
+        }
+
+        SDL_Rect destination = { packed.x, packed.y, width, height };
+        SDL_SetSurfaceBlendMode(image.surface_, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(image.surface_, nullptr, pageSurfaces[page], &destination);
+        SDL_DestroySurface(image.surface_);
+        image.surface_ = nullptr;
+
+        AtlasRegion region;
+        region.page_ = page;
+        region.rect_ = { static_cast<float>(packed.x), static_cast<float>(packed.y),
+            static_cast<float>(width), static_cast<float>(height) };
+        region.uv_ = MakeUV(region.rect_);
+
+        baked->regions_.insert_or_assign(Filesystem::GetFilename(image.path_), region);
+        auto entry = MakeCacheEntry(image.path_);
+        entry.region_ = region;
+        entries.push_back(entry);
+    }
+
+    if (!cacheFolder.empty() && !pageSurfaces.empty()) {
+        SaveCache(entries, pageSurfaces, cacheFolder);
+    }
+
+    GKC_ENGINE_INFO("Packed {0} textures into {1} atlas page/s", baked->regions_.size(), pageSurfaces.size());
+    return baked;
+}
+
+bool TextureAtlas::Upload(BakedAtlas& baked, SDL_Renderer* renderer) {
+    Clear();
+    for (auto* pageSurface : baked.pages_) {
+        SDL_Texture* page = SDL_CreateTextureFromSurface(renderer, pageSurface);
+        if (page == nullptr) {
+            GKC_ENGINE_ERROR("Failed to upload atlas page: {0}", SDL_GetError());
+        } else {
+            SDL_SetTextureScaleMode(page, SDL_SCALEMODE_NEAREST);
+        }
+        m_pages.push_back(page);
+    }
+    m_regions = std::move(baked.regions_);
+    return !m_pages.empty();
+}
+
+BakedAtlas::~BakedAtlas() {
+    for (auto* page : pages_) {
+        SDL_DestroySurface(page);
+    }
+}
+
+bool TextureAtlas::LoadCache(const vector<path>& files, SDL_Renderer* renderer, const path& cacheFolder) {
+    Clear();
+    path layoutPath = cacheFolder / ATLAS_LAYOUT_FILE;
+    if (!Filesystem::CheckFile(layoutPath))
+        return false;
+
+    ifstream file(layoutPath, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    Uint32 version = 0, pageSize = 0, pageCount = 0, entryCount = 0;
+    Filesystem::FileReader::Read(file, version);
+    Filesystem::FileReader::Read(file, pageSize);
+    Filesystem::FileReader::Read(file, pageCount);
+    Filesystem::FileReader::Read(file, entryCount);
+
+    if (!file.good() || version != GKC_VERSION_ATLAS || pageSize != GKC_ATLAS_PAGE_SIZE
+        || entryCount != files.size()) {
+        return false;
+    }
+
+    unordered_map<string, CacheEntry> current;
+    current.reserve(files.size());
+    for (auto& source : files) {
+        auto entry = MakeCacheEntry(source);
+        current.emplace(entry.name_, entry);
+    }
+
+    unordered_map<string, AtlasRegion> regions;
+    for (Uint32 i = 0; i < entryCount; ++i) {
+        CacheEntry entry;
+        ReadLayoutString(file, entry.name_);
+        Filesystem::FileReader::Read(file, entry.size_);
+        Filesystem::FileReader::Read(file, entry.time_);
+        Filesystem::FileReader::Read(file, entry.region_.page_);
+        Filesystem::FileReader::Read(file, entry.region_.rect_);
+        if (!file.good())
+            return false;
+
+        // Any modified, added or removed file invalidates the whole layout
+        auto it = current.find(entry.name_);
+        if (it == current.end() || it->second.size_ != entry.size_ || it->second.time_ != entry.time_)
+            return false;
+
+        if (entry.region_.page_ == INVALID_ATLAS_PAGE)
+            continue;
+        if (entry.region_.page_ >= pageCount)
+            return false;
+
+        entry.region_.uv_ = MakeUV(entry.region_.rect_);
+        regions.emplace(entry.name_, entry.region_);
+    }
+
+    for (Uint32 i = 0; i < pageCount; ++i) {
+        SDL_Texture* page = IMG_LoadTexture(renderer, GetPagePath(cacheFolder, i).string().c_str());
+        if (page == nullptr) {
+            GKC_ENGINE_WARNING("Atlas page {0} is missing from the cache, repacking...", i);
+            Clear();
+            return false;
+        }
+        SDL_SetTextureScaleMode(page, SDL_SCALEMODE_NEAREST);
+        m_pages.push_back(page);
+    }
+
+    m_regions = std::move(regions);
+    return true;
+}
+
+void TextureAtlas::SaveCache(const vector<CacheEntry>& entries, const vector<SDL_Surface*>& pages,
+    const path& cacheFolder) {
+    using Filesystem::FileWriter;
+
+    if (!Filesystem::CheckDirectory(cacheFolder) && !Filesystem::CreateFolder(cacheFolder)) {
+        GKC_ENGINE_WARNING("Atlas cache folder couldn't be created, the atlas won't be cached");
+        return;
+    }
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if (!IMG_SavePNG(pages[i], GetPagePath(cacheFolder, i).string().c_str())) {
+            GKC_ENGINE_WARNING("Failed to cache atlas page {0}: {1}", i, SDL_GetError());
+            return;
+        }
+    }
+
+    ofstream file(cacheFolder / ATLAS_LAYOUT_FILE, std::ios::binary);
+    if (!file.is_open()) {
+        GKC_ENGINE_WARNING("Failed to write the atlas layout cache");
+        return;
+    }
+
+    FileWriter::Write(file, GKC_VERSION_ATLAS);
+    FileWriter::Write(file, static_cast<Uint32>(GKC_ATLAS_PAGE_SIZE));
+    FileWriter::Write(file, static_cast<Uint32>(pages.size()));
+    FileWriter::Write(file, static_cast<Uint32>(entries.size()));
+    for (auto& entry : entries) {
+        FileWriter::WriteString(file, entry.name_);
+        FileWriter::Write(file, entry.size_);
+        FileWriter::Write(file, entry.time_);
+        FileWriter::Write(file, entry.region_.page_);
+        FileWriter::Write(file, entry.region_.rect_);
+    }
+}
+
+TextureAtlas::CacheEntry TextureAtlas::MakeCacheEntry(const path& file) {
+    std::error_code error;
+    CacheEntry entry{};
+    entry.name_ = Filesystem::GetFilename(file);
+
+    // Archived files can only change when the archive is packed again, its time is used
+    size_t archivedSize = 0;
+    if (Filesystem::FindArchivedFile(file, archivedSize) != nullptr) {
+        const Filesystem::Archive* archive = Filesystem::FindFileArchive(file);
+        entry.size_ = archivedSize;
+        entry.time_ = static_cast<Sint64>(std::filesystem::last_write_time(archive->GetPath(), error)
+            .time_since_epoch().count());
+        return entry;
+    }
+
+    entry.size_ = static_cast<Uint64>(std::filesystem::file_size(file, error));
+    entry.time_ = static_cast<Sint64>(std::filesystem::last_write_time(file, error).time_since_epoch().count());
+    return entry;
+}
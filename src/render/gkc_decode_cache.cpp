@@ -0,0 +1,344 @@
+#include <render/gkc_decode_cache.h>
+#include "core/gkc_hash.h"
+#include "core/gkc_logger.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_writer.h"
+
+#if GKC_HAS_LZ4
+    #include <lz4.h>
+#endif
+
+using namespace Galaktic;
+using namespace Galaktic::Render;
+
+namespace {
+    constexpr char DECODE_CACHE_MAGIC[4] = { 'G', 'K', 'D', 'C' };
+    constexpr Uint32 DECODE_FLAG_LZ4 = 1 << 0;
+    constexpr Uint32 MAX_CACHED_SIDE = 16384;
+
+    struct EntryHeader {
+        char magic_[4];
+        Uint32 version_;
+        Uint64 key_;
+        Uint32 imageCount_;
+        Uint32 metadataSize_;
+    };
+
+    struct ImageHeader {
+        Uint32 width_;
+        Uint32 height_;
+        Uint32 flags_;
+        Uint32 reserved_;
+        Uint64 rawSize_;
+        Uint64 storedSize_;
+    };
+
+    /**
+     * @brief Cursor over the mapped entry, every read is bounds checked
+     */
+    struct EntryCursor {
+        const Uint8* data_;
+        size_t size_;
+        size_t offset_ = 0;
+
+        bool Read(void* out, size_t bytes) {
+            if (bytes > size_ - offset_)
+                return false;
+            std::memcpy(out, data_ + offset_, bytes);
+            offset_ += bytes;
+            return true;
+        }
+
+        const Uint8* Skip(size_t bytes) {
+            if (bytes > size_ - offset_)
+                return nullptr;
+            const Uint8* current = data_ + offset_;
+            offset_ += bytes;
+            return current;
+        }
+    };
+
+    bool DecodePixels(const ImageHeader& header, const Uint8* stored, SDL_Surface* image) {
+        auto* pixels = static_cast<Uint8*>(image->pixels);
+        const size_t rowSize = static_cast<size_t>(header.width_) * 4;
+
+        // Stored rows are tightly packed, the surface can have a bigger pitch
+        vector<Uint8> decompressed;
+        const Uint8* source = stored;
+        if (header.flags_ & DECODE_FLAG_LZ4) {
+            #if GKC_HAS_LZ4
+                decompressed.resize(header.rawSize_);
+                int result = LZ4_decompress_safe(reinterpret_cast<const char*>(stored),
+                    reinterpret_cast<char*>(decompressed.data()), static_cast<int>(header.storedSize_),
+                    static_cast<int>(header.rawSize_));
+                if (result != static_cast<int>(header.rawSize_))
+                    return false;
+                source = decompressed.data();
+            #else
+                // Written by a build with LZ4, decode the source again
+                return false;
+            #endif
+        }
+
+        for (Uint32 y = 0; y < header.height_; ++y) {
+            std::memcpy(pixels + static_cast<size_t>(y) * image->pitch, source + y * rowSize, rowSize);
+        }
+        return true;
+    }
+}
+
+path DecodeCache::m_folder;
+
+void DecodeCache::SetFolder(const path& folder) {
+    m_folder = folder;
+    if (!m_folder.empty() && !Filesystem::CheckDirectory(m_folder) && !Filesystem::CreateFolder(m_folder)) {
+        GKC_ENGINE_WARNING("Decode cache folder couldn't be created, decoded images won't be cached");
+        m_folder.clear();
+    }
+    Prune();
+}
+
+Uint64 DecodeCache::MakeKey(const void* data, size_t size, std::string_view settings) {
+    Uint64 hash = Core::HashFNV1a(data, size);
+    hash = Core::HashFNV1a(settings.data(), settings.size(), hash);
+    return Core::HashFNV1a(&GKC_VERSION_DECODE_CACHE, sizeof(GKC_VERSION_DECODE_CACHE), hash);
+}
+
+path DecodeCache::GetEntryPath(Uint64 key) {
+    return m_folder / fmt::format("{:016x}.gkdecoded", key);
+}
+
+bool DecodeCache::Load(Uint64 key, vector<SDL_Surface*>& images, vector<Uint8>& metadata) {
+    if (!IsEnabled())
+        return false;
+
+    const path entryPath = GetEntryPath(key);
+    Filesystem::MappedFile file;
+    if (!file.Open(entryPath))
+        return false;
+
+    EntryCursor cursor{ file.GetData(), file.GetSize() };
+    EntryHeader header{};
+    if (!cursor.Read(&header, sizeof(header))
+        || std::memcmp(header.magic_, DECODE_CACHE_MAGIC, sizeof(DECODE_CACHE_MAGIC)) != 0
+        || header.version_ != GKC_VERSION_DECODE_CACHE || header.key_ != key) {
+        return false;
+    }
+
+    const Uint8* metadataBytes = cursor.Skip(header.metadataSize_);
+    if (metadataBytes == nullptr)
+        return false;
+    metadata.assign(metadataBytes, metadataBytes + header.metadataSize_);
+
+    vector<SDL_Surface*> loaded;
+    auto discard = [&loaded]() {
+        for (auto* image : loaded)
+            SDL_DestroySurface(image);
+        return false;
+    };
+
+    for (Uint32 i = 0; i < header.imageCount_; ++i) {
+        ImageHeader imageHeader{};
+        if (!cursor.Read(&imageHeader, sizeof(imageHeader)) || imageHeader.width_ == 0
+            || imageHeader.height_ == 0 || imageHeader.width_ > MAX_CACHED_SIDE
+            || imageHeader.height_ > MAX_CACHED_SIDE
+            || imageHeader.rawSize_ != static_cast<Uint64>(imageHeader.width_) * imageHeader.height_ * 4) {
+            return discard();
+        }
+
+        const Uint8* stored = cursor.Skip(imageHeader.storedSize_);
+        if (stored == nullptr)
+            return discard();
+
+        SDL_Surface* image = SDL_CreateSurface(static_cast<int>(imageHeader.width_),
+            static_cast<int>(imageHeader.height_), SDL_PIXELFORMAT_RGBA32);
+        if (image == nullptr)
+            return discard();
+        loaded.push_back(image);
+
+        if (!DecodePixels(imageHeader, stored, image))
+            return discard();
+    }
+
+    images.insert(images.end(), loaded.begin(), loaded.end());
+
+    // The modification time tells Prune() which entries were used last
+    std::error_code error;
+    std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+void DecodeCache::Store(Uint64 key, const vector<SDL_Surface*>& images, const vector<Uint8>& metadata) {
+    using Filesystem::FileWriter;
+    if (!IsEnabled())
+        return;
+
+    // Written under a temporary name first, a crash or another thread never leaves a half written entry
+    path entryPath = GetEntryPath(key);
+    path tempPath = entryPath;
+    tempPath += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+        ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            GKC_ENGINE_WARNING("Failed to write decode cache entry: {0}", tempPath.string());
+            return;
+        }
+
+        EntryHeader header{};
+        std::memcpy(header.magic_, DECODE_CACHE_MAGIC, sizeof(DECODE_CACHE_MAGIC));
+        header.version_ = GKC_VERSION_DECODE_CACHE;
+        header.key_ = key;
+        header.imageCount_ = static_cast<Uint32>(images.size());
+        header.metadataSize_ = static_cast<Uint32>(metadata.size());
+        FileWriter::Write(file, header);
+        file.write(reinterpret_cast<const char*>(metadata.data()), static_cast<std::streamsize>(metadata.size()));
+
+        vector<Uint8> pixels;
+        #if GKC_HAS_LZ4
+            vector<Uint8> compressed;
+        #endif
+        for (auto* source : images) {
+            SDL_Surface* image = source->format == SDL_PIXELFORMAT_RGBA32
+                ? source : SDL_ConvertSurface(source, SDL_PIXELFORMAT_RGBA32);
+            if (image == nullptr) {
+                file.close();
+                Filesystem::RemoveFile(tempPath);
+                return;
+            }
+
+            ImageHeader imageHeader{};
+            imageHeader.width_ = static_cast<Uint32>(image->w);
+            imageHeader.height_ = static_cast<Uint32>(image->h);
+            imageHeader.rawSize_ = static_cast<Uint64>(image->w) * image->h * 4;
+
+            const size_t rowSize = static_cast<size_t>(image->w) * 4;
+            pixels.resize(imageHeader.rawSize_);
+            for (int y = 0; y < image->h; ++y) {
+                std::memcpy(pixels.data() + y * rowSize,
+                    static_cast<const Uint8*>(image->pixels) + static_cast<size_t>(y) * image->pitch, rowSize);
+            }
+            if (image != source)
+                SDL_DestroySurface(image);
+
+            const Uint8* stored = pixels.data();
+            imageHeader.storedSize_ = imageHeader.rawSize_;
+            #if GKC_HAS_LZ4
+                compressed.resize(LZ4_compressBound(static_cast<int>(pixels.size())));
+                int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(pixels.data()),
+                    reinterpret_cast<char*>(compressed.data()), static_cast<int>(pixels.size()),
+                    static_cast<int>(compressed.size()));
+                // Noisy images can grow, those are stored raw
+                if (compressedSize > 0 && static_cast<Uint64>(compressedSize) < imageHeader.rawSize_) {
+                    stored = compressed.data();
+                    imageHeader.storedSize_ = static_cast<Uint64>(compressedSize);
+                    imageHeader.flags_ |= DECODE_FLAG_LZ4;
+                }
+            #endif
+
+            FileWriter::Write(file, imageHeader);
+            file.write(reinterpret_cast<const char*>(stored), static_cast<std::streamsize>(imageHeader.storedSize_));
+        }
+
+        if (!file.good()) {
+            file.close();
+            Filesystem::RemoveFile(tempPath);
+            GKC_ENGINE_WARNING("Failed to write decode cache entry: {0}", entryPath.string());
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, entryPath, error);
+    if (error) {
+        Filesystem::RemoveFile(tempPath);
+        GKC_ENGINE_WARNING("Failed to write decode cache entry: {0}", error.message());
+    }
+}
+
+SDL_Surface* DecodeCache::LoadImage(Uint64 key) {
+    vector<SDL_Surface*> images;
+    vector<Uint8> metadata;
+    if (!Load(key, images, metadata))
+        return nullptr;
+
+    if (images.size() != 1 || !metadata.empty()) {
+        for (auto* image : images)
+            SDL_DestroySurface(image);
+        return nullptr;
+    }
+    return images.front();
+}
+
+void DecodeCache::StoreImage(Uint64 key, SDL_Surface* image) {
+    if (image != nullptr)
+        Store(key, { image }, {});
+}
+
+void DecodeCache::Prune(Uint64 maxSize) {
+    using std::filesystem::file_time_type;
+    if (!IsEnabled())
+        return;
+
+    struct CachedEntry {
+        path path_;
+        Uint64 size_;
+        file_time_type time_;
+    };
+    vector<CachedEntry> entries;
+    Uint64 totalSize = 0;
+
+    // Temporary files of a Store() running on another process are younger than this
+    const auto staleTemp = file_time_type::clock::now() - std::chrono::hours(1);
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_folder, error)) {
+        if (!entry.is_regular_file(error))
+            continue;
+        const auto time = entry.last_write_time(error);
+        if (error)
+            continue;
+        if (entry.path().extension() == ".tmp") {
+            if (time < staleTemp)
+                Filesystem::RemoveFile(entry.path());
+            continue;
+        }
+        if (entry.path().extension() != ".gkdecoded")
+            continue;
+
+        const auto size = static_cast<Uint64>(entry.file_size(error));
+        if (error)
+            continue;
+        entries.push_back({ entry.path(), size, time });
+        totalSize += size;
+    }
+    if (totalSize <= maxSize)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const CachedEntry& a, const CachedEntry& b) {
+        return a.time_ < b.time_;
+    });
+    size_t removed = 0;
+    const Uint64 previousSize = totalSize;
+    for (const auto& entry : entries) {
+        if (totalSize <= maxSize)
+            break;
+        Filesystem::RemoveFile(entry.path_);
+        totalSize -= entry.size_;
+        ++removed;
+    }
+    GKC_ENGINE_INFO("Decode cache pruned, removed {0} entries ({1} MB to {2} MB)", removed,
+        previousSize >> 20, totalSize >> 20);
+}
+
+void DecodeCache::Clear() {
+    if (!IsEnabled())
+        return;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_folder, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".gkdecoded")
+            Filesystem::RemoveFile(entry.path());
+    }
+    GKC_ENGINE_INFO("Decode cache cleared");
+}
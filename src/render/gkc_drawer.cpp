@@ -17,16 +17,106 @@ namespace {
     }
 }
 
+bool DrawSnapshot::operator==(const DrawSnapshot& other) const {
+    const auto sameRect = [](const SDL_FRect& a, const SDL_FRect& b) {
+        return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+    };
+    return sameRect(rect_, other.rect_) && texture_ == other.texture_ && hasSource_ == other.hasSource_
+        && (!hasSource_ || sameRect(source_, other.source_))
+        && color_.r == other.color_.r && color_.g == other.color_.g
+        && color_.b == other.color_.b && color_.a == other.color_.a;
+}
+
+bool Drawer::m_retainedMode = false;
+bool Drawer::m_fullRedraw = true;
+SDL_Texture* Drawer::m_canvas = nullptr;
+Vec2 Drawer::m_lastCamera = {0.f, 0.f};
+vector<std::pair<EntityID, DrawSnapshot>> Drawer::m_snapshots;
+unordered_map<EntityID, DrawSnapshot> Drawer::m_previousSnapshots;
+
+namespace {
+    void RenderSnapshot(SDL_Renderer* renderer, const DrawSnapshot& snapshot) {
+        if (snapshot.texture_ != nullptr) {
+            SDL_RenderTexture(renderer, snapshot.texture_, snapshot.hasSource_ ? &snapshot.source_ : nullptr,
+                &snapshot.rect_);
+            return;
+        }
+        SDL_SetRenderDrawColor(renderer, GKC_SET_COLOR(snapshot.color_));
+        SDL_RenderFillRect(renderer, &snapshot.rect_);
+    }
+
+    SDL_Rect ToPixelRect(const SDL_FRect& rect) {
+        int x = static_cast<int>(std::floor(rect.x));
+        int y = static_cast<int>(std::floor(rect.y));
+        return { x, y,
+            static_cast<int>(std::ceil(rect.x + rect.w)) - x,
+            static_cast<int>(std::ceil(rect.y + rect.h)) - y };
+    }
+
+    /**
+     * Adds a rect to the dirty list merging it with the rects it overlaps
+     * @return false if there are too many dirty rects
+     */
+    bool AddDirtyRect(vector<SDL_Rect>& dirty, SDL_Rect rect, const SDL_Rect& canvas) {
+        if (!SDL_GetRectIntersection(&rect, &canvas, &rect))
+            return true;
+
+        for (size_t i = 0; i < dirty.size();) {
+            if (SDL_HasRectIntersection(&dirty[i], &rect)) {
+                SDL_GetRectUnion(&dirty[i], &rect, &rect);
+                dirty[i] = dirty.back();
+                dirty.pop_back();
+                i = 0;
+                continue;
+            }
+            ++i;
+        }
+        dirty.push_back(rect);
+        return dirty.size() <= Galaktic::Render::GKC_MAX_DIRTY_RECTS;
+    }
+}
+
 void Drawer::DrawEntities(const ECS::Entity_List& list, SDL_Renderer *renderer,
     Core::Systems::CameraSystem& cameraSystem)
 {
-    using namespace Core::Managers;
-    auto& camera = cameraSystem.GetActiveCamera().Get<ECS::CameraComponent>();
+    auto& camera = cameraSystem.GetActiveCamera().Read<ECS::CameraComponent>();
 
     ClearCheckedEntities();
+    TakeSnapshots(list, camera.m_location);
+
+    if (m_retainedMode && PrepareCanvas(renderer)) {
+        DrawRetained(renderer, camera.m_location);
+        return;
+    }
+
+    for (auto& [id, snapshot] : m_snapshots) {
+        RenderSnapshot(renderer, snapshot);
+    }
+}
+
+void Drawer::SetRetainedMode(bool enabled) {
+    m_retainedMode = enabled;
+    m_fullRedraw = true;
+    if (!enabled) {
+        ReleaseCanvas();
+    }
+}
+
+void Drawer::ReleaseCanvas() {
+    if (m_canvas != nullptr) {
+        SDL_DestroyTexture(m_canvas);
+        m_canvas = nullptr;
+    }
+    m_previousSnapshots.clear();
+    m_fullRedraw = true;
+}
+
+void Drawer::TakeSnapshots(const ECS::Entity_List& list, const Vec2& camera) {
+    using namespace Core::Managers;
+    m_snapshots.clear();
 
     for (auto entity : list) {
-        auto& name = entity.second.Get<ECS::NameComponent>().m_name;
+        auto& name = entity.second.Read<ECS::NameComponent>().m_name;
 
         if (!checkedEntities.contains(entity.first)) {
             if (!entity.second.IsValid()) {
@@ -38,50 +128,163 @@ void Drawer::DrawEntities(const ECS::Entity_List& list, SDL_Renderer *renderer,
         }
         if (entity.second.Has<ECS::LightTag>() || entity.second.Has<ECS::CameraComponent>()) continue;
 
-        auto& transform = entity.second.Get<ECS::TransformComponent>();
-        SDL_FRect rect;
+        auto& transform = entity.second.Read<ECS::TransformComponent>();
+        DrawSnapshot snapshot;
+        SDL_FRect& rect = snapshot.rect_;
         rect.w = transform.m_size.x;
         rect.h = transform.m_size.y;
 
-        rect.x = transform.m_location.x - camera.m_location.x;
-        rect.y = transform.m_location.y - camera.m_location.y;
+        rect.x = transform.m_location.x - camera.x;
+        rect.y = transform.m_location.y - camera.y;
 
         // Render texture if it has texture
         if (entity.second.Has<ECS::TextureComponent>()) {
-            auto& textureComp = entity.second.Get<ECS::TextureComponent>();
+            auto& textureComp = entity.second.Read<ECS::TextureComponent>();
             auto texture = TextureManager::GetTextureByID(textureComp.m_id);
-            SDL_Texture* sdlTexture = nullptr;
-            
-            if(texture == nullptr) {
-                sdlTexture = TextureManager::GetMissingTexture();
+
+            if(texture == nullptr || texture->GetSDLTexture() == nullptr) {
+                snapshot.texture_ = TextureManager::GetMissingTexture();
             } else {
-                sdlTexture = texture->GetSDLTexture();
-                if(sdlTexture == nullptr) {
-                    sdlTexture = TextureManager::GetMissingTexture();
+                snapshot.texture_ = texture->GetSDLTexture();
+                if (const SDL_FRect* source = texture->GetSourceRect()) {
+                    snapshot.source_ = *source;
+                    snapshot.hasSource_ = true;
                 }
             }
-
-            auto& textureName = TextureManager::GetIDTextureList().find(textureComp.m_id)->second;
-            SDL_RenderTexture(renderer, sdlTexture, NULL ,&rect);
         } 
         
         else if (entity.second.Has<ECS::AnimationComponent>()) {
-            auto& animationComp = entity.second.Get<ECS::AnimationComponent>();
-            auto animation = AnimationManager::GetAnimation(animationComp.m_id);
-            if(animation == nullptr) {
+            auto& animationComp = entity.second.Read<ECS::AnimationComponent>();
+            auto animation = AnimationManager::FindAnimation(animationComp.m_id);
+            const AnimationFrame* frame = animation != nullptr
+                ? animation->GetFrame(static_cast<int>(animationComp.m_frame)) : nullptr;
+            if(frame == nullptr) {
+                // Still being loaded
+                if (AnimationManager::HasAnimation(animationComp.m_id)) {
+                    snapshot.texture_ = TextureManager::GetMissingTexture();
+                    m_snapshots.emplace_back(entity.first, snapshot);
+                    continue;
+                }
                 // Programming Warcrime
                 goto color_rendering;
             }
-            
-            animation->Render(renderer, rect);
+
+            snapshot.texture_ = animation->GetSheet(frame->sheet_);
+            snapshot.source_ = frame->rect_;
+            snapshot.hasSource_ = true;
         }
 
         // Color Rendering
         else {
             color_rendering:
-            auto& color = entity.second.Get<ECS::ColorComponent>().m_color;
-            SDL_SetRenderDrawColor(renderer, GKC_SET_COLOR(color));
-            SDL_RenderFillRect(renderer, &rect);
+            snapshot.color_ = entity.second.Read<ECS::ColorComponent>().m_color;
+        }
+
+        m_snapshots.emplace_back(entity.first, snapshot);
+    }
+}
+
+bool Drawer::PrepareCanvas(SDL_Renderer* renderer) {
+    int width = 0, height = 0;
+    SDL_GetCurrentRenderOutputSize(renderer, &width, &height);
+
+    if (m_canvas != nullptr) {
+        float canvasWidth = 0.f, canvasHeight = 0.f;
+        SDL_GetTextureSize(m_canvas, &canvasWidth, &canvasHeight);
+        if (static_cast<int>(canvasWidth) == width && static_cast<int>(canvasHeight) == height)
+            return true;
+        ReleaseCanvas();
+    }
+
+    m_canvas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (m_canvas == nullptr) {
+        GKC_ENGINE_ERROR("Failed to create retained canvas, drawing everything: {0}", SDL_GetError());
+        return false;
+    }
+    // Blending onto the transparent canvas already multiplies the colors by their alpha,
+    // blending the canvas again would apply the alpha of translucent pixels twice
+    SDL_SetTextureBlendMode(m_canvas, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    m_fullRedraw = true;
+    return true;
+}
+
+void Drawer::DrawRetained(SDL_Renderer* renderer, const Vec2& camera) {
+    float width = 0.f, height = 0.f;
+    SDL_GetTextureSize(m_canvas, &width, &height);
+    const SDL_Rect canvasRect = { 0, 0, static_cast<int>(width), static_cast<int>(height) };
+
+    // Moving the camera moves every entity on screen
+    if (camera.x != m_lastCamera.x || camera.y != m_lastCamera.y) {
+        m_fullRedraw = true;
+        m_lastCamera = camera;
+    }
+
+    vector<SDL_Rect> dirty;
+    if (!m_fullRedraw) {
+        unordered_set<EntityID> alive;
+        alive.reserve(m_snapshots.size());
+
+        for (auto& [id, snapshot] : m_snapshots) {
+            alive.insert(id);
+            auto previous = m_previousSnapshots.find(id);
+            if (previous != m_previousSnapshots.end() && previous->second == snapshot)
+                continue;
+
+            if (previous != m_previousSnapshots.end()
+                && !AddDirtyRect(dirty, ToPixelRect(previous->second.rect_), canvasRect)) {
+                m_fullRedraw = true;
+                break;
+            }
+            if (!AddDirtyRect(dirty, ToPixelRect(snapshot.rect_), canvasRect)) {
+                m_fullRedraw = true;
+                break;
+            }
         }
+
+        // Deleted entities leave a hole
+        for (auto& [id, snapshot] : m_previousSnapshots) {
+            if (m_fullRedraw)
+                break;
+            if (!alive.contains(id) && !AddDirtyRect(dirty, ToPixelRect(snapshot.rect_), canvasRect)) {
+                m_fullRedraw = true;
+            }
+        }
+    }
+
+    if (m_fullRedraw) {
+        dirty.assign(1, canvasRect);
     }
-}
\ No newline at end of file
+
+    if (!dirty.empty()) {
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, m_canvas);
+
+        for (auto& region : dirty) {
+            SDL_SetRenderClipRect(renderer, &region);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_FRect clearRect;
+            SDL_RectToFRect(&region, &clearRect);
+            SDL_RenderFillRect(renderer, &clearRect);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+            for (auto& [id, snapshot] : m_snapshots) {
+                SDL_Rect bounds = ToPixelRect(snapshot.rect_);
+                if (SDL_HasRectIntersection(&bounds, &region)) {
+                    RenderSnapshot(renderer, snapshot);
+                }
+            }
+        }
+
+        SDL_SetRenderClipRect(renderer, nullptr);
+        SDL_SetRenderTarget(renderer, previousTarget);
+
+        m_previousSnapshots.clear();
+        for (auto& [id, snapshot] : m_snapshots) {
+            m_previousSnapshots.emplace(id, snapshot);
+        }
+        m_fullRedraw = false;
+    }
+
+    SDL_RenderTexture(renderer, m_canvas, nullptr, nullptr);
+}
@@ -2,39 +2,103 @@
 #include "core/gkc_exception.h"
 #include "core/gkc_logger.h"
 #include "filesys/gkc_filesys.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_asset_index.h"
+#include "render/gkc_decode_cache.h"
 
 using namespace Galaktic::Render;
 
 Texture::Texture(const path &path, SDL_Renderer* renderer) {
     GKC_ENGINE_INFO("Loading {0}...", path.string());
-    if (path.empty() || !Filesystem::CheckFile(path)) {
+    if (path.empty() || !Filesystem::AssetExists(path)) {
         GKC_ENGINE_ERROR( "given path doesn't exists!");
         return;
     }
 
-    m_texture = IMG_LoadTexture(renderer, path.string().c_str());
+    SDL_Surface* surface = LoadSurface(path);
+    m_texture = surface != nullptr ? SDL_CreateTextureFromSurface(renderer, surface) : nullptr;
+    SDL_DestroySurface(surface);
     
     if (m_texture == nullptr) {
         GKC_ENGINE_ERROR("failed to load texture!");
     }
 }
 
+Texture::Texture(SDL_Surface* surface, SDL_Renderer* renderer) {
+    if (surface == nullptr) {
+        GKC_ENGINE_ERROR("given surface is NULL!");
+        return;
+    }
+
+    m_texture = SDL_CreateTextureFromSurface(renderer, surface);
+
+    if (m_texture == nullptr) {
+        GKC_ENGINE_ERROR("failed to upload texture: {0}", SDL_GetError());
+    }
+}
+
+Texture::Texture(SDL_Texture* page, const AtlasRegion& region)
+    : m_texture(page), m_region(region), m_isAtlased(true) {}
+
 Texture::~Texture() {
     // CRITICAL FIX: Destroy the SDL_Texture when Texture is destroyed
-    if (m_texture != nullptr) {
+    // Atlas pages are owned by the atlas
+    if (m_texture != nullptr && !m_isAtlased) {
         SDL_DestroyTexture(m_texture);
         m_texture = nullptr;
     }
 }
 
+size_t Texture::GetMemorySize() const {
+    if (m_texture == nullptr || m_isAtlased)
+        return 0;
+
+    float width = 0.f, height = 0.f;
+    SDL_GetTextureSize(m_texture, &width, &height);
+    return static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+}
+
 bool Galaktic::Render::CheckTextureExtension(const path &path) {
-    if (path.empty() || !Filesystem::CheckFile(path)) {
-        return false;
+    // The extension goes first, it doesn't touch the disk
+    return Filesystem::IsAssetExtension(path, Filesystem::Asset_Type::Texture) && Filesystem::AssetExists(path);
+}
+
+SDL_Surface* Galaktic::Render::LoadSurface(const path& path) {
+    if (path.empty() || !Filesystem::AssetExists(path)) {
+        GKC_ENGINE_ERROR("given path doesn't exists!");
+        return nullptr;
+    }
+
+    vector<Uint8> storage;
+    size_t size = 0;
+    const Uint8* data = Filesystem::ReadAsset(path, storage, size);
+    if (data == nullptr)
+        return nullptr;
+
+    Uint64 key = 0;
+    if (DecodeCache::IsEnabled()) {
+        key = DecodeCache::MakeKey(data, size, "rgba32");
+        if (SDL_Surface* cached = DecodeCache::LoadImage(key))
+            return cached;
     }
-    auto pathStr = path.extension().string();
 
-    if (pathStr == ".png" || pathStr == ".jpg" || pathStr == ".jpeg" || pathStr == ".webp"
-        || pathStr == ".bmp" || pathStr == ".gif") { return true; }
+    SDL_Surface* loaded = IMG_Load_IO(SDL_IOFromConstMem(data, size), true);
+    if (loaded == nullptr) {
+        GKC_ENGINE_ERROR("failed to load image {0}: {1}", path.string(), SDL_GetError());
+        return nullptr;
+    }
 
-    return false;
-}
\ No newline at end of file
+    SDL_Surface* converted = loaded;
+    if (loaded->format != SDL_PIXELFORMAT_RGBA32) {
+        converted = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (converted == nullptr) {
+            GKC_ENGINE_ERROR("failed to convert image {0}: {1}", path.string(), SDL_GetError());
+            return nullptr;
+        }
+    }
+
+    if (DecodeCache::IsEnabled())
+        DecodeCache::StoreImage(key, converted);
+    return converted;
+}
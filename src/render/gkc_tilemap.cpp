@@ -0,0 +1,310 @@
+#include <render/gkc_tilemap.h>
+#include "core/gkc_exception.h"
+#include "core/gkc_logger.h"
+#include "core/managers/gkc_texture_man.h"
+#include "filesys/gkc_filesys.h"
+#include "filesys/gkc_archive.h"
+#include "filesys/gkc_asset_index.h"
+#include "filesys/gkc_reader.h"
+#include "filesys/gkc_writer.h"
+#include "render/gkc_texture.h"
+
+using namespace Galaktic;
+using namespace Galaktic::Render;
+
+namespace {
+    constexpr char TILEMAP_MAGIC[4] = { 'G', 'K', 'T', 'M' };
+    constexpr Uint32 MAX_TILEMAP_SIDE = 16384;
+
+    // FileWriter::WriteString stores the length as an Uint32
+    void ReadTilemapString(std::istream& file, string& str) {
+        Uint32 len = 0;
+        Filesystem::FileReader::Read(file, len);
+        if (!file.good() || len > 1024) {
+            GKC_THROW_EXCEPTION(Debug::ReadingException, "invalid string in tilemap file!");
+        }
+        str.resize(len);
+        file.read(str.data(), len);
+    }
+}
+
+Tilemap::Tilemap(Uint32 width, Uint32 height, Uint32 tileSize, TextureID tileset)
+    : m_width(width), m_height(height), m_tileSize(tileSize), m_tileset(tileset) {
+    GKC_ASSERT(width > 0 && height > 0 && tileSize > 0, "Tilemap dimensions must be greater than 0");
+    m_chunksX = (m_width + GKC_TILEMAP_CHUNK_SIZE - 1) / GKC_TILEMAP_CHUNK_SIZE;
+    m_chunksY = (m_height + GKC_TILEMAP_CHUNK_SIZE - 1) / GKC_TILEMAP_CHUNK_SIZE;
+    m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+}
+
+Tilemap::~Tilemap() {
+    ReleaseChunks();
+}
+
+unique_ptr<Tilemap> Tilemap::Load(const path& path) {
+    using Filesystem::FileReader;
+
+    GKC_ENGINE_INFO("Loading tilemap {0}...", path.string());
+    Filesystem::AssetStream file(path);
+    GKC_ENSURE_FILE_OPEN(file, Debug::ReadingException);
+
+    char magic[4] = {};
+    Uint32 version = 0, width = 0, height = 0, tileSize = 0, layerCount = 0;
+    string tilesetName;
+
+    file.read(magic, sizeof(magic));
+    FileReader::Read(file, version);
+    if (!file.good() || std::memcmp(magic, TILEMAP_MAGIC, sizeof(magic)) != 0) {
+        GKC_THROW_EXCEPTION(Debug::ReadingException, "file is not a tilemap!");
+    }
+    if (version != GKC_VERSION_TILEMAP) {
+        GKC_THROW_EXCEPTION(Debug::ReadingException, "tilemap version is not supported!");
+    }
+
+    FileReader::Read(file, width);
+    FileReader::Read(file, height);
+    FileReader::Read(file, tileSize);
+    ReadTilemapString(file, tilesetName);
+    FileReader::Read(file, layerCount);
+    if (!file.good() || width == 0 || height == 0 || tileSize == 0
+        || width > MAX_TILEMAP_SIDE || height > MAX_TILEMAP_SIDE) {
+        GKC_THROW_EXCEPTION(Debug::ReadingException, "tilemap header is corrupted!");
+    }
+
+    TextureID tileset = 0;
+    if (auto info = Core::Managers::TextureManager::GetTextureInfo(tilesetName)) {
+        tileset = info->id_;
+    } else {
+        GKC_ENGINE_WARNING("Tileset '{0}' doesn't exist, the tilemap won't be drawn", tilesetName);
+    }
+
+    auto tilemap = make_unique<Tilemap>(width, height, tileSize, tileset);
+    for (Uint32 i = 0; i < layerCount; ++i) {
+        auto& layer = tilemap->m_layers[tilemap->AddLayer("")];
+        ReadTilemapString(file, layer.name_);
+        FileReader::Read(file, layer.visible_);
+        file.read(reinterpret_cast<char*>(layer.tiles_.data()),
+            static_cast<std::streamsize>(layer.tiles_.size() * sizeof(Uint16)));
+        if (!file.good()) {
+            GKC_THROW_EXCEPTION(Debug::ReadingException, "tilemap layer is truncated!");
+        }
+    }
+
+    GKC_ENGINE_INFO("Tilemap loaded ({0}x{1} tiles, {2} layer/s)", width, height, layerCount);
+    return tilemap;
+}
+
+void Tilemap::Save(const path& path) const {
+    using Filesystem::FileWriter;
+
+    ofstream file(path, std::ios::binary);
+    GKC_ENSURE_FILE_OPEN(file, Debug::WritingException);
+
+    string tilesetName;
+    if (auto* name = Core::Managers::TextureManager::GetTextureName(m_tileset)) {
+        tilesetName = *name;
+    }
+
+    file.write(TILEMAP_MAGIC, sizeof(TILEMAP_MAGIC));
+    FileWriter::Write(file, GKC_VERSION_TILEMAP);
+    FileWriter::Write(file, m_width);
+    FileWriter::Write(file, m_height);
+    FileWriter::Write(file, m_tileSize);
+    FileWriter::WriteString(file, tilesetName);
+    FileWriter::Write(file, static_cast<Uint32>(m_layers.size()));
+    for (auto& layer : m_layers) {
+        FileWriter::WriteString(file, layer.name_);
+        FileWriter::Write(file, layer.visible_);
+        file.write(reinterpret_cast<const char*>(layer.tiles_.data()),
+            static_cast<std::streamsize>(layer.tiles_.size() * sizeof(Uint16)));
+    }
+
+    GKC_ENGINE_INFO("Tilemap saved to {0}", path.string());
+}
+
+size_t Tilemap::AddLayer(const string& name) {
+    TileLayer layer;
+    layer.name_ = name;
+    layer.tiles_.assign(static_cast<size_t>(m_width) * m_height, GKC_EMPTY_TILE);
+    m_layers.push_back(std::move(layer));
+    return m_layers.size() - 1;
+}
+
+void Tilemap::SetTile(size_t layer, Uint32 x, Uint32 y, Uint16 tile) {
+    if (layer >= m_layers.size() || !IsInside(x, y)) {
+        GKC_ENGINE_WARNING("Tile ({0}, {1}) is outside the tilemap", x, y);
+        return;
+    }
+
+    auto& current = m_layers[layer].tiles_[static_cast<size_t>(y) * m_width + x];
+    if (current == tile)
+        return;
+
+    current = tile;
+    m_chunks[(y / GKC_TILEMAP_CHUNK_SIZE) * m_chunksX + x / GKC_TILEMAP_CHUNK_SIZE].dirty_ = true;
+}
+
+Uint16 Tilemap::GetTile(size_t layer, Uint32 x, Uint32 y) const {
+    if (layer >= m_layers.size() || !IsInside(x, y))
+        return GKC_EMPTY_TILE;
+    return m_layers[layer].tiles_[static_cast<size_t>(y) * m_width + x];
+}
+
+void Tilemap::SetLayerVisible(size_t layer, bool visible) {
+    if (layer >= m_layers.size() || m_layers[layer].visible_ == visible)
+        return;
+    m_layers[layer].visible_ = visible;
+    MarkAllDirty();
+}
+
+void Tilemap::Render(SDL_Renderer* renderer, const Vec2& camera, Uint32 viewWidth, Uint32 viewHeight) {
+    if (m_layers.empty())
+        return;
+
+    const float chunkPixels = static_cast<float>(GKC_TILEMAP_CHUNK_SIZE * m_tileSize);
+    const auto firstVisible = [&](float position) -> Sint64 {
+        return static_cast<Sint64>(std::floor(position / chunkPixels));
+    };
+
+    // Chunk range covering the view, clamped to the map
+    Sint64 startX = std::max<Sint64>(0, firstVisible(camera.x));
+    Sint64 startY = std::max<Sint64>(0, firstVisible(camera.y));
+    Sint64 endX = std::min<Sint64>(m_chunksX - 1, firstVisible(camera.x + static_cast<float>(viewWidth)));
+    Sint64 endY = std::min<Sint64>(m_chunksY - 1, firstVisible(camera.y + static_cast<float>(viewHeight)));
+
+    ReleaseChunksOutside(
+        static_cast<Uint32>(std::max<Sint64>(0, startX - GKC_TILEMAP_CHUNK_MARGIN)),
+        static_cast<Uint32>(std::max<Sint64>(0, startY - GKC_TILEMAP_CHUNK_MARGIN)),
+        static_cast<Uint32>(std::max<Sint64>(0, endX + GKC_TILEMAP_CHUNK_MARGIN)),
+        static_cast<Uint32>(std::max<Sint64>(0, endY + GKC_TILEMAP_CHUNK_MARGIN)));
+
+    for (Sint64 chunkY = startY; chunkY <= endY; ++chunkY) {
+        for (Sint64 chunkX = startX; chunkX <= endX; ++chunkX) {
+            auto& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunksX + static_cast<size_t>(chunkX)];
+            if (chunk.dirty_) {
+                BakeChunk(renderer, static_cast<Uint32>(chunkX), static_cast<Uint32>(chunkY));
+            }
+            if (chunk.texture_ == nullptr)
+                continue;
+
+            SDL_FRect rect = {
+                static_cast<float>(chunkX) * chunkPixels - camera.x,
+                static_cast<float>(chunkY) * chunkPixels - camera.y,
+                chunkPixels, chunkPixels
+            };
+            SDL_RenderTexture(renderer, chunk.texture_, nullptr, &rect);
+        }
+    }
+}
+
+void Tilemap::MarkAllDirty() {
+    for (auto& chunk : m_chunks) {
+        chunk.dirty_ = true;
+    }
+}
+
+void Tilemap::ReleaseChunks() {
+    for (auto& chunk : m_chunks) {
+        if (chunk.texture_ != nullptr) {
+            SDL_DestroyTexture(chunk.texture_);
+            chunk.texture_ = nullptr;
+        }
+        chunk.dirty_ = true;
+    }
+}
+
+void Tilemap::BakeChunk(SDL_Renderer* renderer, Uint32 chunkX, Uint32 chunkY) {
+    auto tileset = Core::Managers::TextureManager::GetTextureByID(m_tileset);
+    if (tileset == nullptr || tileset->GetSDLTexture() == nullptr) {
+        // Stays dirty, it's baked once the tileset is loaded
+        return;
+    }
+
+    auto& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunksX + chunkX];
+    const int chunkPixels = static_cast<int>(GKC_TILEMAP_CHUNK_SIZE * m_tileSize);
+    if (chunk.texture_ == nullptr) {
+        chunk.texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+            chunkPixels, chunkPixels);
+        if (chunk.texture_ == nullptr) {
+            GKC_ENGINE_ERROR("Failed to create tilemap chunk: {0}", SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(chunk.texture_, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(chunk.texture_, SDL_SCALEMODE_NEAREST);
+    }
+
+    // Tileset area, atlased tilesets only use their region of the page
+    SDL_FRect tilesetRect = { 0.f, 0.f, 0.f, 0.f };
+    if (const SDL_FRect* source = tileset->GetSourceRect()) {
+        tilesetRect = *source;
+    } else {
+        SDL_GetTextureSize(tileset->GetSDLTexture(), &tilesetRect.w, &tilesetRect.h);
+    }
+    const Uint32 columns = static_cast<Uint32>(tilesetRect.w) / m_tileSize;
+    const Uint32 rows = static_cast<Uint32>(tilesetRect.h) / m_tileSize;
+    const auto tileSize = static_cast<float>(m_tileSize);
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderTarget(renderer, chunk.texture_);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    const Uint32 firstX = chunkX * GKC_TILEMAP_CHUNK_SIZE;
+    const Uint32 firstY = chunkY * GKC_TILEMAP_CHUNK_SIZE;
+    const Uint32 lastX = std::min(firstX + GKC_TILEMAP_CHUNK_SIZE, m_width);
+    const Uint32 lastY = std::min(firstY + GKC_TILEMAP_CHUNK_SIZE, m_height);
+
+    for (auto& layer : m_layers) {
+        if (!layer.visible_)
+            continue;
+
+        for (Uint32 y = firstY; y < lastY; ++y) {
+            const Uint16* row = &layer.tiles_[static_cast<size_t>(y) * m_width];
+            for (Uint32 x = firstX; x < lastX; ++x) {
+                if (row[x] == GKC_EMPTY_TILE)
+                    continue;
+
+                const Uint32 index = row[x] - 1u;
+                if (columns == 0 || index >= columns * rows)
+                    continue;
+
+                SDL_FRect source = {
+                    tilesetRect.x + static_cast<float>(index % columns) * tileSize,
+                    tilesetRect.y + static_cast<float>(index / columns) * tileSize,
+                    tileSize, tileSize
+                };
+                SDL_FRect destination = {
+                    static_cast<float>(x - firstX) * tileSize,
+                    static_cast<float>(y - firstY) * tileSize,
+                    tileSize, tileSize
+                };
+                SDL_RenderTexture(renderer, tileset->GetSDLTexture(), &source, &destination);
+            }
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    chunk.dirty_ = false;
+}
+
+void Tilemap::ReleaseChunksOutside(Uint32 firstX, Uint32 firstY, Uint32 lastX, Uint32 lastY) {
+    for (Uint32 chunkY = 0; chunkY < m_chunksY; ++chunkY) {
+        for (Uint32 chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+            if (chunkX >= firstX && chunkX <= lastX && chunkY >= firstY && chunkY <= lastY)
+                continue;
+
+            auto& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunksX + chunkX];
+            if (chunk.texture_ != nullptr) {
+                SDL_DestroyTexture(chunk.texture_);
+                chunk.texture_ = nullptr;
+                chunk.dirty_ = true;
+            }
+        }
+    }
+}
+
+bool Galaktic::Render::CheckTilemapExtension(const path& path) {
+    return Filesystem::IsAssetExtension(path, Filesystem::Asset_Type::Tilemap) && Filesystem::AssetExists(path);
+}
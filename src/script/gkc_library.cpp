@@ -8,6 +8,7 @@
 #include <render/gkc_animation.h>
 #include <script/gkc_script.h>
 #include <render/gkc_texture.h>
+#include <render/gkc_drawer.h>
 #include <core/systems/gkc_key.h>
 #include <core/systems/gkc_mouse_system.h>
 #include <filesys/gkc_filesys.h>
@@ -113,6 +114,10 @@ void LuaGalaktic::BindTextureFunctions() {
             .addStaticFunction("DeleteTexture", &TextureManager::DeleteTexture)
             .addStaticFunction("PrintList", &TextureManager::PrintList)
         .endClass()
+        .beginClass<Galaktic::Render::Drawer>("Drawer")
+            .addStaticFunction("SetRetainedMode", &Galaktic::Render::Drawer::SetRetainedMode)
+            .addStaticFunction("IsRetainedMode", &Galaktic::Render::Drawer::IsRetainedMode)
+        .endClass()
     .endNamespace();
 }
 
@@ -121,8 +126,13 @@ void LuaGalaktic::BindAudioFunctions() {
     luabridge::getGlobalNamespace(m_luaState).beginNamespace("Galaktic").beginNamespace("Audio")
         .beginClass<AudioManager>("AudioManager")
             .addStaticFunction("AddAudioFile", &AudioManager::AddAudioFile)
+            .addStaticFunction("AddMusicFile", &AudioManager::AddMusicFile)
             .addStaticFunction("RemoveAudioFile", &AudioManager::RemoveAudioFile)
-            .addStaticFunction("PlayAudioFile", &AudioManager::PlayAudioFile)
+            // LuaBridge doesn't fill default arguments, scripts keep calling it with 2 of them
+            .addStaticFunction("PlayAudioFile", +[](const string& name, int loops) {
+                AudioManager::PlayAudioFile(name, loops);
+            })
+            .addStaticFunction("PlayAudioFileWithPriority", &AudioManager::PlayAudioFile)
             .addStaticFunction("PlayMusicFile", &AudioManager::PlayMusicFile)
             .addStaticFunction("StopSound", &AudioManager::StopSound)
             .addStaticFunction("StopAllTracksFromSound", &AudioManager::StopAllTracksFromSound)
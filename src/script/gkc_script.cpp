@@ -1,6 +1,8 @@
 #include <script/gkc_script.h>
 #include <core/gkc_exception.h>
 #include <filesys/gkc_filesys.h>
+#include <filesys/gkc_archive.h>
+#include <filesys/gkc_asset_index.h>
 #include <core/gkc_logger.h>
 
 using namespace Galaktic;
@@ -10,7 +12,14 @@ Script::GKC_Script::GKC_Script(const path& scriptPath, lua_State* luaState)
 
     m_luaState = luaState;
     try {
-        if (luaL_loadfile(m_luaState, scriptPath.string().c_str()) != LUA_OK) {
+        size_t size = 0;
+        const Uint8* archived = Filesystem::FindArchivedFile(scriptPath, size);
+        int loaded = archived != nullptr
+            ? luaL_loadbuffer(m_luaState, reinterpret_cast<const char*>(archived), size,
+                ("@" + scriptPath.string()).c_str())
+            : luaL_loadfile(m_luaState, scriptPath.string().c_str());
+
+        if (loaded != LUA_OK) {
             string error = lua_tostring(m_luaState, -1);
             lua_pop(m_luaState, 1);
             GKC_THROW_EXCEPTION(Debug::ScriptException, "Failed to compile script file: " + scriptPath.string() + " - " + error);
@@ -65,12 +74,6 @@ void Script::GKC_Script::RunScript() {
 }
 
 bool Script::CheckScriptExtension(const path& path) {
-    if (path.empty() || !Filesystem::CheckFile(path)) {
-        return false;
-    }
-    auto pathStr = path.extension().string();
-
-    if (pathStr == ".lua") { return true; }
-
-    return false;
+    // The extension goes first, it doesn't touch the disk
+    return Filesystem::IsAssetExtension(path, Filesystem::Asset_Type::Script) && Filesystem::AssetExists(path);
 }
\ No newline at end of file
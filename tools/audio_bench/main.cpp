@@ -0,0 +1,77 @@
+#include <core/gkc_logger.h>
+#include <core/managers/gkc_audio_man.h>
+#include <filesys/gkc_filesys.h>
+
+using namespace Galaktic;
+using Core::Managers::AudioManager;
+
+// audio_bench <audio file> [voices] [seconds] [output.wav]
+// Mixes the file on many voices without an audio device and reports the cost of mixing,
+// the output is deterministic so it can be written to a WAV and compared between builds
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cout << "Usage: audio_bench <audio file> [voices] [seconds] [output.wav]" << endl;
+        return 1;
+    }
+
+    Debug::Logger::Init();
+
+    string file = argv[1];
+    const auto voices = static_cast<Uint32>(argc > 2 ? std::max(1, std::atoi(argv[2])) : Audio::GKC_AUDIO_VOICES);
+    const double seconds = argc > 3 ? std::max(0.1, std::atof(argv[3])) : 10.0;
+    path output = argc > 4 ? path(argv[4]) : path();
+
+    // No device is opened, the dummy driver keeps SDL from touching the sound card
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_AUDIO) || !MIX_Init()) {
+        GKC_ENGINE_ERROR("Failed to initialize audio: {}", SDL_GetError());
+        return 1;
+    }
+
+    int result = 1;
+    {
+        AudioManager manager("", Audio::Audio_Output::Offline, voices);
+        AudioManager::AddAudioFile(file);
+        AudioID id = AudioManager::GetAudioList().FindID(Filesystem::GetFilename(file));
+        if (id == 0) {
+            GKC_ENGINE_ERROR("'{}' couldn't be loaded", file);
+        } else {
+            // Voices are spread across the stereo field so the pan path is measured too
+            const float gain = 1.f / std::sqrt(static_cast<float>(voices));
+            for (Uint32 i = 0; i < voices; ++i) {
+                float pan = voices > 1 ? -1.f + 2.f * static_cast<float>(i) / static_cast<float>(voices - 1) : 0.f;
+                AudioManager::PlayVoice(id, -1, 0, gain, pan);
+            }
+
+            const SDL_AudioSpec& spec = AudioManager::GetAudioSpec();
+            const size_t frameSize = static_cast<size_t>(spec.channels) * SDL_AUDIO_BYTESIZE(spec.format);
+            const auto frames = static_cast<size_t>(seconds * spec.freq);
+            constexpr size_t BLOCK_FRAMES = 1024;
+
+            vector<Uint8> pcm(frames * frameSize);
+            Uint64 ticks = 0;
+            bool generated = true;
+            for (size_t frame = 0; frame < frames && generated; frame += BLOCK_FRAMES) {
+                size_t count = std::min(BLOCK_FRAMES, frames - frame);
+                Uint64 start = SDL_GetPerformanceCounter();
+                generated = AudioManager::Generate(pcm.data() + frame * frameSize, count * frameSize);
+                ticks += SDL_GetPerformanceCounter() - start;
+            }
+
+            if (generated) {
+                double cpu = static_cast<double>(ticks) / static_cast<double>(SDL_GetPerformanceFrequency());
+                GKC_ENGINE_INFO("{} voices, {:.1f} s of audio at {} Hz mixed in {:.2f} ms", voices, seconds,
+                    spec.freq, cpu * 1000.0);
+                GKC_ENGINE_INFO("{:.3f} ms of CPU per second of audio, {:.1f}x real time",
+                    cpu * 1000.0 / seconds, cpu > 0.0 ? seconds / cpu : 0.0);
+                result = 0;
+                if (!output.empty() && !Audio::WriteWAV(output, spec, pcm))
+                    result = 1;
+            }
+        }
+    }
+
+    MIX_Quit();
+    SDL_Quit();
+    return result;
+}
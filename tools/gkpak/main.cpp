@@ -0,0 +1,29 @@
+#include <core/gkc_logger.h>
+#include <filesys/gkc_archive.h>
+#include <filesys/gkc_filesys.h>
+
+using namespace Galaktic;
+
+// gkpak <project folder> <output.gkpak> [folders...]
+// Packs the project's assets, scenes and scripts (or the given folders) into an archive
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cout << "Usage: gkpak <project folder> <output" << Filesystem::GKC_ARCHIVE_EXTENSION
+            << "> [folders...]" << endl;
+        return 1;
+    }
+
+    Debug::Logger::Init();
+
+    path root = argv[1];
+    path output = argv[2];
+    vector<path> folders(argv + 3, argv + argc);
+    if (folders.empty())
+        folders = Filesystem::GKC_ARCHIVE_FOLDERS;
+
+    if (!Filesystem::CheckDirectory(root)) {
+        GKC_ENGINE_ERROR("'{0}' is not a valid project folder", root.string());
+        return 1;
+    }
+    return Filesystem::Archive::Pack(root, folders, output) ? 0 : 1;
+}